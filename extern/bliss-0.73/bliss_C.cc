@@ -37,7 +37,7 @@ extern "C" {
 #endif
 
 struct bliss_digraphs_graph_struct {
-  bliss_digraphs::Graph* g;
+  bliss_digraphs::AbstractGraph* g;
 };
 
 extern "C"
@@ -50,6 +50,72 @@ BlissGraph *bliss_digraphs_new(const unsigned int n)
   return graph;
 }
 
+extern "C"
+BlissGraph *bliss_digraphs_new_digraph(const unsigned int n)
+{
+  BlissGraph *graph = new bliss_digraphs_graph_struct;
+  assert(graph);
+  graph->g = new bliss_digraphs::Digraph(n);
+  assert(graph->g);
+  return graph;
+}
+
+extern "C"
+BlissGraph *bliss_digraphs_new_from_csr(const unsigned int N,
+                                        const unsigned int *colors,
+                                        const unsigned int *offsets,
+                                        const unsigned int *targets)
+{
+  BlissGraph *graph = new bliss_digraphs_graph_struct;
+  assert(graph);
+  graph->g = bliss_digraphs::Graph::from_csr(N, colors, offsets, targets);
+  assert(graph->g);
+  return graph;
+}
+
+extern "C"
+BlissGraph *bliss_digraphs_new_digraph_from_csr(const unsigned int N,
+                                                const unsigned int *colors,
+                                                const unsigned int *offsets,
+                                                const unsigned int *targets,
+                                                const unsigned int *edge_colors)
+{
+  BlissGraph *graph = new bliss_digraphs_graph_struct;
+  assert(graph);
+  graph->g = bliss_digraphs::Digraph::from_csr(
+      N, colors, offsets, targets, edge_colors);
+  assert(graph->g);
+  return graph;
+}
+
+extern "C"
+void bliss_digraphs_assign_csr(BlissGraph *graph,
+                               const unsigned int N,
+                               const unsigned int *colors,
+                               const unsigned int *offsets,
+                               const unsigned int *targets)
+{
+  assert(graph);
+  bliss_digraphs::Graph *g = dynamic_cast<bliss_digraphs::Graph *>(graph->g);
+  assert(g);
+  g->assign_csr(N, colors, offsets, targets);
+}
+
+extern "C"
+void bliss_digraphs_assign_digraph_csr(BlissGraph *graph,
+                                       const unsigned int N,
+                                       const unsigned int *colors,
+                                       const unsigned int *offsets,
+                                       const unsigned int *targets,
+                                       const unsigned int *edge_colors)
+{
+  assert(graph);
+  bliss_digraphs::Digraph *g =
+      dynamic_cast<bliss_digraphs::Digraph *>(graph->g);
+  assert(g);
+  g->assign_csr(N, colors, offsets, targets, edge_colors);
+}
+
 extern "C"
 BlissGraph *bliss_digraphs_read_dimacs(FILE *fp)
 {
@@ -128,6 +194,19 @@ void bliss_digraphs_add_edge(BlissGraph *graph, unsigned int v1, unsigned int v2
   graph->g->add_edge(v1, v2);
 }
 
+extern "C"
+void bliss_digraphs_add_colored_edge(BlissGraph *graph,
+                                     unsigned int v1,
+                                     unsigned int v2,
+                                     unsigned int c)
+{
+  assert(graph);
+  assert(graph->g);
+  bliss_digraphs::Digraph* dg = dynamic_cast<bliss_digraphs::Digraph*>(graph->g);
+  assert(dg);
+  dg->add_edge(v1, v2, c);
+}
+
 extern "C"
 int bliss_digraphs_cmp(BlissGraph *graph1, BlissGraph *graph2)
 {
@@ -135,7 +214,14 @@ int bliss_digraphs_cmp(BlissGraph *graph1, BlissGraph *graph2)
   assert(graph1->g);
   assert(graph2);
   assert(graph2->g);
-  return (*graph1->g).cmp(*graph2->g);
+  bliss_digraphs::Graph* g1 = dynamic_cast<bliss_digraphs::Graph*>(graph1->g);
+  bliss_digraphs::Graph* g2 = dynamic_cast<bliss_digraphs::Graph*>(graph2->g);
+  if(g1 and g2)
+    return g1->cmp(*g2);
+  bliss_digraphs::Digraph* dg1 = dynamic_cast<bliss_digraphs::Digraph*>(graph1->g);
+  bliss_digraphs::Digraph* dg2 = dynamic_cast<bliss_digraphs::Digraph*>(graph2->g);
+  assert(dg1 and dg2);
+  return dg1->cmp(*dg2);
 }
 
 extern "C"
@@ -81,6 +81,72 @@ typedef struct bliss_digraphs_stats_struct
 BlissGraph *bliss_digraphs_new(const unsigned int N);
 
 
+/**
+ * Create a new directed graph instance with \a N vertices and no edges.
+ * The edges of a directed graph can be colored, see
+ * bliss_digraphs_add_colored_edge().
+ */
+BlissGraph *bliss_digraphs_new_digraph(const unsigned int N);
+
+
+/**
+ * Create a new graph instance with \a N vertices, where the vertex v has
+ * color \a colors[v] (or 0 if \a colors is 0) and is adjacent to the
+ * vertices \a targets[\a offsets[v]], ..., \a targets[\a offsets[v+1]-1].
+ * Every edge must be listed at both of its ends.
+ * The arrays are copied into a single contiguous block, which is much faster
+ * than adding the edges one at a time with bliss_digraphs_add_edge().
+ */
+BlissGraph *bliss_digraphs_new_from_csr(const unsigned int N,
+                                        const unsigned int *colors,
+                                        const unsigned int *offsets,
+                                        const unsigned int *targets);
+
+
+/**
+ * Create a new directed graph instance with \a N vertices, where the vertex v
+ * has color \a colors[v] (or 0 if \a colors is 0), and there are edges from
+ * v to the vertices \a targets[\a offsets[v]], ...,
+ * \a targets[\a offsets[v+1]-1]. If \a edge_colors is not 0, then the color
+ * of the edge to \a targets[i] is \a edge_colors[i], as in
+ * bliss_digraphs_add_colored_edge().
+ */
+BlissGraph *bliss_digraphs_new_digraph_from_csr(const unsigned int N,
+                                                const unsigned int *colors,
+                                                const unsigned int *offsets,
+                                                const unsigned int *targets,
+                                                const unsigned int *edge_colors);
+
+
+/**
+ * Replace the vertices and edges of the graph \a graph, which must have been
+ * created by bliss_digraphs_new() or bliss_digraphs_new_from_csr(), by those
+ * given by the remaining arguments, as in bliss_digraphs_new_from_csr().
+ * The memory already used by \a graph is reused where possible, so that a
+ * single instance can be refilled for many graphs, instead of creating and
+ * releasing one for each.
+ */
+void bliss_digraphs_assign_csr(BlissGraph *graph,
+                               const unsigned int N,
+                               const unsigned int *colors,
+                               const unsigned int *offsets,
+                               const unsigned int *targets);
+
+
+/**
+ * Replace the vertices and edges of the directed graph \a graph, which must
+ * have been created by bliss_digraphs_new_digraph() or
+ * bliss_digraphs_new_digraph_from_csr(), by those given by the remaining
+ * arguments, as in bliss_digraphs_new_digraph_from_csr().
+ */
+void bliss_digraphs_assign_digraph_csr(BlissGraph *graph,
+                                       const unsigned int N,
+                                       const unsigned int *colors,
+                                       const unsigned int *offsets,
+                                       const unsigned int *targets,
+                                       const unsigned int *edge_colors);
+
+
 /**
  * Read an undirected graph from a file in the DIMACS format into a new bliss
  * instance.
@@ -142,6 +208,19 @@ unsigned int bliss_digraphs_add_vertex(BlissGraph *graph, unsigned int c);
 void bliss_digraphs_add_edge(BlissGraph *graph, unsigned int v1, unsigned int v2);
 
 
+/**
+ * Add a new edge with color \a c from \a v1 to \a v2 in the directed graph
+ * \a graph, which must have been created by bliss_digraphs_new_digraph().
+ * The colors of the edges are respected by the automorphisms and canonical
+ * labelings of the graph, and are handled directly by the search, rather
+ * than by encoding them in additional vertices.
+ */
+void bliss_digraphs_add_colored_edge(BlissGraph *graph,
+                                     unsigned int v1,
+                                     unsigned int v2,
+                                     unsigned int c);
+
+
 /**
  * Compare two graphs according to a total order.
  * Return -1, 0, or 1 if the first graph was smaller than, equal to,
@@ -1548,71 +1548,167 @@ namespace bliss_digraphs {
 
   /*-------------------------------------------------------------------------
    *
-   * Routines for directed graphs
+   * Storage for the edges of a graph
    *
    *-------------------------------------------------------------------------*/
 
-  Digraph::Vertex::Vertex() {
-    color = 0;
+  void EdgeStore::add_vertices(const unsigned int n) {
+    first.resize(first.size() + n, targets.size());
+    length.resize(length.size() + n, 0);
+    capacity.resize(capacity.size() + n, 0);
   }
 
-  Digraph::Vertex::~Vertex() {
-    ;
+  void EdgeStore::clear() {
+    const unsigned int N = first.size();
+    targets.clear();
+    colors.clear();
+    first.assign(N, 0);
+    length.assign(N, 0);
+    capacity.assign(N, 0);
+    nof_edges_ = 0;
+    colored    = false;
+    clean      = true;
+  }
+
+  /*
+   * Make room for one more edge at the end of the list of the vertex v.
+   * The list is extended in place if it is at the end of the array, and
+   * otherwise it is moved to the end of the array with twice its length.
+   */
+  void EdgeStore::reserve_one(const unsigned int v) {
+    if (length[v] < capacity[v])
+      return;
+    const unsigned int new_capacity = capacity[v] == 0 ? 4 : 2 * capacity[v];
+    if (first[v] + capacity[v] == targets.size()) {
+      targets.resize(first[v] + new_capacity);
+      if (colored)
+        colors.resize(first[v] + new_capacity);
+    } else {
+      const unsigned int new_first = targets.size();
+      targets.resize(new_first + new_capacity);
+      std::copy(targets.begin() + first[v],
+                targets.begin() + first[v] + length[v],
+                targets.begin() + new_first);
+      if (colored) {
+        colors.resize(new_first + new_capacity);
+        std::copy(colors.begin() + first[v],
+                  colors.begin() + first[v] + length[v],
+                  colors.begin() + new_first);
+      }
+      first[v] = new_first;
+    }
+    capacity[v] = new_capacity;
+  }
+
+  void EdgeStore::push_back(const unsigned int v,
+                            const unsigned int w,
+                            const unsigned int color) {
+    reserve_one(v);
+    clean                         = false;
+    targets[first[v] + length[v]] = w;
+    if (colored)
+      colors[first[v] + length[v]] = color;
+    length[v]++;
+    nof_edges_++;
   }
 
-  void Digraph::Vertex::add_edge_to(const unsigned int other_vertex) {
-    edges_out.push_back(other_vertex);
+  void EdgeStore::enable_colors() {
+    if (!colored) {
+      colors.assign(targets.size(), 0);
+      colored = true;
+    }
+  }
+
+  void EdgeStore::assign(const unsigned int        N,
+                         const unsigned int* const offsets,
+                         const unsigned int* const new_targets,
+                         const unsigned int* const new_colors) {
+    nof_edges_ = offsets[N] - offsets[0];
+    targets.assign(new_targets + offsets[0], new_targets + offsets[N]);
+    colored = (new_colors != 0);
+    if (colored)
+      colors.assign(new_colors + offsets[0], new_colors + offsets[N]);
+    else
+      colors.clear();
+    first.resize(N);
+    length.resize(N);
+    capacity.resize(N);
+    for (unsigned int v = 0; v < N; v++) {
+      first[v]    = offsets[v] - offsets[0];
+      length[v]   = offsets[v + 1] - offsets[v];
+      capacity[v] = length[v];
+    }
+    clean = false;
   }
 
-  void Digraph::Vertex::add_edge_from(const unsigned int other_vertex) {
-    edges_in.push_back(other_vertex);
+  void EdgeStore::assign_transpose(const EdgeStore& other) {
+    const unsigned int N = other.first.size();
+    nof_edges_           = other.nof_edges_;
+    colored              = other.colored;
+    first.assign(N, 0);
+    length.assign(N, 0);
+    for (unsigned int v = 0; v < N; v++)
+      for (const unsigned int* ei = other.begin(v); ei != other.end(v); ei++)
+        length[*ei]++;
+    unsigned int sum = 0;
+    for (unsigned int v = 0; v < N; v++) {
+      first[v] = sum;
+      sum += length[v];
+    }
+    capacity = length;
+    targets.resize(sum);
+    colors.resize(colored ? sum : 0);
+    /* Use length as the insertion point of each list */
+    length.assign(N, 0);
+    for (unsigned int v = 0; v < N; v++) {
+      const unsigned int* ei = other.begin(v);
+      for (unsigned int j = 0; j < other.size(v); j++) {
+        const unsigned int w   = ei[j];
+        const unsigned int pos = first[w] + length[w]++;
+        targets[pos]           = v;
+        if (colored)
+          colors[pos] = other.colors_begin(v)[j];
+      }
+    }
+    clean = other.clean;
   }
 
-  void Digraph::Vertex::remove_duplicate_edges(std::vector<bool>& tmp) {
+  void EdgeStore::remove_duplicates(std::vector<bool>& tmp) {
+    if (clean)
+      return;
 #if defined(BLISS_CONSISTENCY_CHECKS)
     /* Pre-conditions  */
     for (unsigned int i = 0; i < tmp.size(); i++)
       assert(tmp[i] == false);
 #endif
-    for (std::vector<unsigned int>::iterator iter = edges_out.begin();
-         iter != edges_out.end();) {
-      const unsigned int dest_vertex = *iter;
-      if (tmp[dest_vertex] == true) {
-        /* A duplicate edge found! */
-        iter = edges_out.erase(iter);
-      } else {
-        /* Not seen earlier, mark as seen */
-        tmp[dest_vertex] = true;
-        iter++;
-      }
-    }
-
-    /* Clear tmp */
-    for (std::vector<unsigned int>::iterator iter = edges_out.begin();
-         iter != edges_out.end();
-         iter++) {
-      tmp[*iter] = false;
-    }
-
-    for (std::vector<unsigned int>::iterator iter = edges_in.begin();
-         iter != edges_in.end();) {
-      const unsigned int dest_vertex = *iter;
-      if (tmp[dest_vertex] == true) {
-        /* A duplicate edge found! */
-        iter = edges_in.erase(iter);
-      } else {
-        /* Not seen earlier, mark as seen */
-        tmp[dest_vertex] = true;
-        iter++;
+    std::vector<unsigned int> new_targets;
+    std::vector<unsigned int> new_colors;
+    new_targets.reserve(nof_edges_);
+    if (colored)
+      new_colors.reserve(nof_edges_);
+    for (unsigned int v = 0; v < first.size(); v++) {
+      const unsigned int new_first = new_targets.size();
+      for (unsigned int j = first[v]; j < first[v] + length[v]; j++) {
+        const unsigned int dest_vertex = targets[j];
+        if (tmp[dest_vertex] == false) {
+          /* Not seen earlier, mark as seen */
+          tmp[dest_vertex] = true;
+          new_targets.push_back(dest_vertex);
+          if (colored)
+            new_colors.push_back(colors[j]);
+        }
       }
-    }
-
-    /* Clear tmp */
-    for (std::vector<unsigned int>::iterator iter = edges_in.begin();
-         iter != edges_in.end();
-         iter++) {
-      tmp[*iter] = false;
-    }
+      /* Clear tmp */
+      for (unsigned int j = new_first; j < new_targets.size(); j++)
+        tmp[new_targets[j]] = false;
+      first[v]    = new_first;
+      length[v]   = new_targets.size() - new_first;
+      capacity[v] = length[v];
+    }
+    targets.swap(new_targets);
+    colors.swap(new_colors);
+    nof_edges_ = targets.size();
+    clean      = true;
 #if defined(BLISS_CONSISTENCY_CHECKS)
     /* Post-conditions  */
     for (unsigned int i = 0; i < tmp.size(); i++)
@@ -1620,15 +1716,37 @@ namespace bliss_digraphs {
 #endif
   }
 
-  /**
-   * Sort the edges entering and leaving the vertex according to
-   * the vertex number of the other edge end.
-   * Time complexity: O(e log(e)), where e is the number of edges
-   * entering/leaving the vertex.
-   */
-  void Digraph::Vertex::sort_edges() {
-    std::sort(edges_in.begin(), edges_in.end());
-    std::sort(edges_out.begin(), edges_out.end());
+  void EdgeStore::sort() {
+    std::vector<std::pair<unsigned int, unsigned int> > tmp;
+    for (unsigned int v = 0; v < first.size(); v++) {
+      std::vector<unsigned int>::iterator begin = targets.begin() + first[v];
+      if (!colored) {
+        std::sort(begin, begin + length[v]);
+        continue;
+      }
+      tmp.clear();
+      for (unsigned int j = first[v]; j < first[v] + length[v]; j++)
+        tmp.push_back(std::make_pair(targets[j], colors[j]));
+      std::sort(tmp.begin(), tmp.end());
+      for (unsigned int j = 0; j < length[v]; j++) {
+        targets[first[v] + j] = tmp[j].first;
+        colors[first[v] + j]  = tmp[j].second;
+      }
+    }
+  }
+
+  /*-------------------------------------------------------------------------
+   *
+   * Routines for directed graphs
+   *
+   *-------------------------------------------------------------------------*/
+
+  Digraph::Vertex::Vertex() {
+    color = 0;
+  }
+
+  Digraph::Vertex::~Vertex() {
+    ;
   }
 
   /*-------------------------------------------------------------------------
@@ -1639,17 +1757,45 @@ namespace bliss_digraphs {
 
   Digraph::Digraph(const unsigned int nof_vertices) {
     vertices.resize(nof_vertices);
-    sh = shs_flm;
+    edges_out.add_vertices(nof_vertices);
+    edges_in.add_vertices(nof_vertices);
+    sh              = shs_flm;
+    has_edge_colors = false;
   }
 
   Digraph::~Digraph() {
     ;
   }
 
+  Digraph* Digraph::from_csr(const unsigned int        N,
+                             const unsigned int* const colors,
+                             const unsigned int* const offsets,
+                             const unsigned int* const targets,
+                             const unsigned int* const edge_colors) {
+    Digraph* const g = new Digraph(0);
+    g->assign_csr(N, colors, offsets, targets, edge_colors);
+    return g;
+  }
+
+  void Digraph::assign_csr(const unsigned int        N,
+                           const unsigned int* const colors,
+                           const unsigned int* const offsets,
+                           const unsigned int* const targets,
+                           const unsigned int* const edge_colors) {
+    vertices.resize(N);
+    for (unsigned int i = 0; i < N; i++)
+      vertices[i].color = colors ? colors[i] : 0;
+    edges_out.assign(N, offsets, targets, edge_colors);
+    edges_in.assign_transpose(edges_out);
+    has_edge_colors = (edge_colors != 0);
+  }
+
   unsigned int Digraph::add_vertex(const unsigned int color) {
     const unsigned int new_vertex_num = vertices.size();
     vertices.resize(new_vertex_num + 1);
     vertices.back().color = color;
+    edges_out.add_vertices(1);
+    edges_in.add_vertices(1);
     return new_vertex_num;
   }
 
@@ -1657,8 +1803,20 @@ namespace bliss_digraphs {
                          const unsigned int vertex2) {
     assert(vertex1 < get_nof_vertices());
     assert(vertex2 < get_nof_vertices());
-    vertices[vertex1].add_edge_to(vertex2);
-    vertices[vertex2].add_edge_from(vertex1);
+    edges_out.push_back(vertex1, vertex2);
+    edges_in.push_back(vertex2, vertex1);
+  }
+
+  void Digraph::add_edge(const unsigned int vertex1,
+                         const unsigned int vertex2,
+                         const unsigned int color) {
+    assert(vertex1 < get_nof_vertices());
+    assert(vertex2 < get_nof_vertices());
+    edges_out.enable_colors();
+    edges_in.enable_colors();
+    edges_out.push_back(vertex1, vertex2, color);
+    edges_in.push_back(vertex2, vertex1, color);
+    has_edge_colors = true;
   }
 
   void Digraph::change_color(const unsigned int vertex,
@@ -1668,8 +1826,8 @@ namespace bliss_digraphs {
   }
 
   void Digraph::sort_edges() {
-    for (unsigned int i = 0; i < get_nof_vertices(); i++)
-      vertices[i].sort_edges();
+    edges_out.sort();
+    edges_in.sort();
   }
 
   int Digraph::cmp(Digraph& other) {
@@ -1689,24 +1847,22 @@ namespace bliss_digraphs {
     remove_duplicate_edges();
     other.remove_duplicate_edges();
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      if (vertices[i].nof_edges_in() < other.vertices[i].nof_edges_in())
+      if (edges_in.size(i) < other.edges_in.size(i))
         return -1;
-      if (vertices[i].nof_edges_in() > other.vertices[i].nof_edges_in())
+      if (edges_in.size(i) > other.edges_in.size(i))
         return 1;
-      if (vertices[i].nof_edges_out() < other.vertices[i].nof_edges_out())
+      if (edges_out.size(i) < other.edges_out.size(i))
         return -1;
-      if (vertices[i].nof_edges_out() > other.vertices[i].nof_edges_out())
+      if (edges_out.size(i) > other.edges_out.size(i))
         return 1;
     }
     /* Compare edges */
+    sort_edges();
+    other.sort_edges();
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v1 = vertices[i];
-      Vertex& v2 = other.vertices[i];
-      v1.sort_edges();
-      v2.sort_edges();
-      std::vector<unsigned int>::const_iterator ei1 = v1.edges_in.begin();
-      std::vector<unsigned int>::const_iterator ei2 = v2.edges_in.begin();
-      while (ei1 != v1.edges_in.end()) {
+      const unsigned int* ei1 = edges_in.begin(i);
+      const unsigned int* ei2 = other.edges_in.begin(i);
+      while (ei1 != edges_in.end(i)) {
         if (*ei1 < *ei2)
           return -1;
         if (*ei1 > *ei2)
@@ -1714,9 +1870,9 @@ namespace bliss_digraphs {
         ei1++;
         ei2++;
       }
-      ei1 = v1.edges_out.begin();
-      ei2 = v2.edges_out.begin();
-      while (ei1 != v1.edges_out.end()) {
+      ei1 = edges_out.begin(i);
+      ei2 = other.edges_out.begin(i);
+      while (ei1 != edges_out.end(i)) {
         if (*ei1 < *ei2)
           return -1;
         if (*ei1 > *ei2)
@@ -1725,35 +1881,54 @@ namespace bliss_digraphs {
         ei2++;
       }
     }
+    /* Compare edge colors */
+    if (has_edge_colors or other.has_edge_colors) {
+      for (unsigned int i = 0; i < get_nof_vertices(); i++) {
+        for (unsigned int j = 0; j < edges_out.size(i); j++) {
+          const unsigned int c1 =
+              has_edge_colors ? edges_out.colors_begin(i)[j] : 0;
+          const unsigned int c2 =
+              other.has_edge_colors ? other.edges_out.colors_begin(i)[j] : 0;
+          if (c1 < c2)
+            return -1;
+          if (c1 > c2)
+            return 1;
+        }
+      }
+    }
     return 0;
   }
 
   Digraph* Digraph::permute(const std::vector<unsigned int>& perm) const {
-    Digraph* const g = new Digraph(get_nof_vertices());
-    for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      const Vertex& v = vertices[i];
-      g->change_color(perm[i], v.color);
-      for (std::vector<unsigned int>::const_iterator ei = v.edges_out.begin();
-           ei != v.edges_out.end();
-           ei++) {
-        g->add_edge(perm[i], perm[*ei]);
-      }
-    }
-    g->sort_edges();
-    return g;
+    return permute(perm.data());
   }
 
   Digraph* Digraph::permute(const unsigned int* const perm) const {
-    Digraph* const g = new Digraph(get_nof_vertices());
-    for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      const Vertex& v = vertices[i];
-      g->change_color(perm[i], v.color);
-      for (std::vector<unsigned int>::const_iterator ei = v.edges_out.begin();
-           ei != v.edges_out.end();
-           ei++) {
-        g->add_edge(perm[i], perm[*ei]);
-      }
+    const unsigned int        N = get_nof_vertices();
+    std::vector<unsigned int> colors(N);
+    std::vector<unsigned int> offsets(N + 1, 0);
+    std::vector<unsigned int> targets(edges_out.nof_edges());
+    std::vector<unsigned int> edge_colors(has_edge_colors ? targets.size() : 0);
+    for (unsigned int i = 0; i < N; i++) {
+      colors[perm[i]]      = vertices[i].color;
+      offsets[perm[i] + 1] = edges_out.size(i);
     }
+    for (unsigned int i = 0; i < N; i++)
+      offsets[i + 1] += offsets[i];
+    for (unsigned int i = 0; i < N; i++) {
+      const unsigned int* ei  = edges_out.begin(i);
+      unsigned int        pos = offsets[perm[i]];
+      for (unsigned int j = 0; j < edges_out.size(i); j++, pos++) {
+        targets[pos] = perm[ei[j]];
+        if (has_edge_colors)
+          edge_colors[pos] = edges_out.colors_begin(i)[j];
+      }
+    }
+    Digraph* const g = from_csr(N,
+                                colors.data(),
+                                offsets.data(),
+                                targets.data(),
+                                has_edge_colors ? edge_colors.data() : 0);
     g->sort_edges();
     return g;
   }
@@ -1777,16 +1952,19 @@ namespace bliss_digraphs {
 
     fprintf(fp, "digraph g {\n");
 
-    unsigned int vnum = 0;
-    for (std::vector<Vertex>::const_iterator vi = vertices.begin();
-         vi != vertices.end();
-         vi++, vnum++) {
-      const Vertex& v = *vi;
-      fprintf(fp, "v%u [label=\"%u:%u\"];\n", vnum, vnum, v.color);
-      for (std::vector<unsigned int>::const_iterator ei = v.edges_out.begin();
-           ei != v.edges_out.end();
-           ei++) {
-        fprintf(fp, "v%u -> v%u\n", vnum, *ei);
+    for (unsigned int vnum = 0; vnum < get_nof_vertices(); vnum++) {
+      fprintf(fp, "v%u [label=\"%u:%u\"];\n", vnum, vnum, vertices[vnum].color);
+      const unsigned int* ei = edges_out.begin(vnum);
+      for (unsigned int j = 0; j < edges_out.size(vnum); j++) {
+        if (has_edge_colors) {
+          fprintf(fp,
+                  "v%u -> v%u [label=\"%u\"]\n",
+                  vnum,
+                  ei[j],
+                  edges_out.colors_begin(vnum)[j]);
+        } else {
+          fprintf(fp, "v%u -> v%u\n", vnum, ei[j]);
+        }
       }
     }
 
@@ -1795,16 +1973,8 @@ namespace bliss_digraphs {
 
   void Digraph::remove_duplicate_edges() {
     std::vector<bool> tmp(get_nof_vertices(), false);
-
-    for (std::vector<Vertex>::iterator vi = vertices.begin();
-         vi != vertices.end();
-         vi++) {
-#if defined(BLISS_EXPENSIVE_CONSISTENCY_CHECKS)
-      for (unsigned int i = 0; i < tmp.size(); i++)
-        assert(tmp[i] == false);
-#endif
-      (*vi).remove_duplicate_edges(tmp);
-    }
+    edges_out.remove_duplicates(tmp);
+    edges_in.remove_duplicates(tmp);
   }
 
   /*-------------------------------------------------------------------------
@@ -1828,12 +1998,12 @@ namespace bliss_digraphs {
 
     /* Hash the edges */
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v = vertices[i];
-      for (std::vector<unsigned int>::const_iterator ei = v.edges_out.begin();
-           ei != v.edges_out.end();
-           ei++) {
+      const unsigned int* ei = edges_out.begin(i);
+      for (unsigned int j = 0; j < edges_out.size(i); j++) {
         h.update(i);
-        h.update(*ei);
+        h.update(ei[j]);
+        if (has_edge_colors)
+          h.update(edges_out.colors_begin(i)[j]);
       }
     }
 
@@ -1994,17 +2164,14 @@ namespace bliss_digraphs {
     sort_edges();
 
     /* First count the total number of edges */
-    unsigned int nof_edges = 0;
-    for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      nof_edges += vertices[i].edges_out.size();
-    }
+    const unsigned int nof_edges = edges_out.nof_edges();
 
     /* Output the "header" line */
     fprintf(fp, "p edge %u %u\n", get_nof_vertices(), nof_edges);
 
     /* Print the color of each vertex */
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v = vertices[i];
+      const Vertex& v = vertices[i];
       fprintf(fp, "n %u %u\n", i + 1, v.color);
       /*
       if(v.color != 0)
@@ -2016,9 +2183,7 @@ namespace bliss_digraphs {
 
     /* Print the edges */
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v = vertices[i];
-      for (std::vector<unsigned int>::const_iterator ei = v.edges_out.begin();
-           ei != v.edges_out.end();
+      for (const unsigned int* ei = edges_out.begin(i); ei != edges_out.end(i);
            ei++) {
         fprintf(fp, "e %u %u\n", i + 1, (*ei) + 1);
       }
@@ -2038,20 +2203,19 @@ namespace bliss_digraphs {
 
   unsigned int Digraph::indegree_invariant(const Digraph* const g,
                                            const unsigned int   vnum) {
-    return g->vertices[vnum].nof_edges_in();
+    return g->edges_in.size(vnum);
   }
 
   unsigned int Digraph::outdegree_invariant(const Digraph* const g,
                                             const unsigned int   vnum) {
-    return g->vertices[vnum].nof_edges_out();
+    return g->edges_out.size(vnum);
   }
 
   unsigned int Digraph::selfloop_invariant(const Digraph* const g,
                                            const unsigned int   vnum) {
     /* Quite inefficient but luckily not in the critical path */
-    const Vertex& v = g->vertices[vnum];
-    for (std::vector<unsigned int>::const_iterator ei = v.edges_out.begin();
-         ei != v.edges_out.end();
+    for (const unsigned int* ei = g->edges_out.begin(vnum);
+         ei != g->edges_out.end(vnum);
          ei++) {
       if (*ei == vnum)
         return 1;
@@ -2097,6 +2261,9 @@ namespace bliss_digraphs {
    *-------------------------------------------------------------------------*/
 
   bool Digraph::split_neighbourhood_of_cell(Partition::Cell* const cell) {
+    if (has_edge_colors)
+      return split_colored_neighbourhood_of_cell(cell);
+
     const bool was_equal_to_first = refine_equal_to_first;
 
     if (compute_eqref_hash) {
@@ -2106,10 +2273,10 @@ namespace bliss_digraphs {
 
     uint_pointer_to_const_substitute ep = p.elements + cell->first;
     for (unsigned int i = cell->length; i > 0; i--) {
-      const Vertex& v = vertices[*ep++];
+      const unsigned int vnum = *ep++;
 
-      std::vector<unsigned int>::const_iterator ei = v.edges_out.begin();
-      for (unsigned int j = v.nof_edges_out(); j != 0; j--) {
+      const unsigned int* ei = edges_out.begin(vnum);
+      for (unsigned int j = edges_out.size(vnum); j != 0; j--) {
         const unsigned int     dest_vertex    = *ei++;
         Partition::Cell* const neighbour_cell = p.get_cell(dest_vertex);
         if (neighbour_cell->is_unit())
@@ -2166,10 +2333,10 @@ namespace bliss_digraphs {
 
     ep = p.elements + cell->first;
     for (unsigned int i = cell->length; i > 0; i--) {
-      const Vertex& v = vertices[*ep++];
+      const unsigned int vnum = *ep++;
 
-      std::vector<unsigned int>::const_iterator ei = v.edges_in.begin();
-      for (unsigned int j = v.nof_edges_in(); j > 0; j--) {
+      const unsigned int* ei = edges_in.begin(vnum);
+      for (unsigned int j = edges_in.size(vnum); j > 0; j--) {
         const unsigned int     dest_vertex    = *ei++;
         Partition::Cell* const neighbour_cell = p.get_cell(dest_vertex);
         if (neighbour_cell->is_unit())
@@ -2258,6 +2425,9 @@ namespace bliss_digraphs {
 
   bool
   Digraph::split_neighbourhood_of_unit_cell(Partition::Cell* const unit_cell) {
+    if (has_edge_colors)
+      return split_colored_neighbourhood_of_unit_cell(unit_cell);
+
     const bool was_equal_to_first = refine_equal_to_first;
 
     if (compute_eqref_hash) {
@@ -2266,14 +2436,14 @@ namespace bliss_digraphs {
       eqref_hash.update(1);
     }
 
-    const Vertex& v = vertices[p.elements[unit_cell->first]];
+    const unsigned int vnum = p.elements[unit_cell->first];
 
     /*
      * Phase 1
      * Refine neighbours according to the edges that leave the vertex v
      */
-    std::vector<unsigned int>::const_iterator ei = v.edges_out.begin();
-    for (unsigned int j = v.nof_edges_out(); j > 0; j--) {
+    const unsigned int* ei = edges_out.begin(vnum);
+    for (unsigned int j = edges_out.size(vnum); j > 0; j--) {
       const unsigned int     dest_vertex    = *ei++;
       Partition::Cell* const neighbour_cell = p.get_cell(dest_vertex);
 
@@ -2390,8 +2560,8 @@ namespace bliss_digraphs {
      * Phase 2
      * Refine neighbours according to the edges that enter the vertex v
      */
-    ei = v.edges_in.begin();
-    for (unsigned int j = v.nof_edges_in(); j > 0; j--) {
+    ei = edges_in.begin(vnum);
+    for (unsigned int j = edges_in.size(vnum); j > 0; j--) {
       const unsigned int     dest_vertex    = *ei++;
       Partition::Cell* const neighbour_cell = p.get_cell(dest_vertex);
 
@@ -2528,6 +2698,320 @@ namespace bliss_digraphs {
     return true;
   }
 
+  /*-------------------------------------------------------------------------
+   *
+   * Refinement for digraphs with colored edges
+   *
+   *-------------------------------------------------------------------------*/
+
+  bool Digraph::split_colored_neighbourhood_of_cell(
+      Partition::Cell* const cell) {
+    const bool was_equal_to_first = refine_equal_to_first;
+
+    if (compute_eqref_hash) {
+      eqref_hash.update(cell->first);
+      eqref_hash.update(cell->length);
+    }
+
+    if (split_colored_neighbourhood_of_cell(cell, true, was_equal_to_first))
+      return true;
+
+    if (cell->is_in_splitting_queue()) {
+      return false;
+    }
+
+    if (split_colored_neighbourhood_of_cell(cell, false, was_equal_to_first))
+      return true;
+
+    if (refine_compare_certificate and (refine_equal_to_first == false)
+        and (refine_cmp_to_best < 0))
+      return true;
+
+    return false;
+  }
+
+  /*
+   * Split the neighbours of the vertices in cell, along the edges leaving
+   * cell if out is true, and along the edges entering cell if not. This is
+   * done for each color of edge separately, in increasing order of color, so
+   * that the resulting partition is equitable with respect to the edges of
+   * every color.
+   */
+  bool Digraph::split_colored_neighbourhood_of_cell(
+      Partition::Cell* const cell,
+      const bool             out,
+      const bool             was_equal_to_first) {
+    colored_neighbours.clear();
+    uint_pointer_to_const_substitute ep = p.elements + cell->first;
+    for (unsigned int i = cell->length; i > 0; i--) {
+      const unsigned int  vnum   = *ep++;
+      const EdgeStore&    store  = (out ? edges_out : edges_in);
+      const unsigned int* edges  = store.begin(vnum);
+      const unsigned int* colors = store.colors_begin(vnum);
+      for (unsigned int j = 0; j < store.size(vnum); j++) {
+        colored_neighbours.push_back(std::make_pair(colors[j], edges[j]));
+      }
+    }
+    std::sort(colored_neighbours.begin(), colored_neighbours.end());
+
+    unsigned int k = 0;
+    while (k < colored_neighbours.size()) {
+      const unsigned int color = colored_neighbours[k].first;
+
+      if (compute_eqref_hash) {
+        eqref_hash.update(color);
+      }
+
+      for (; k < colored_neighbours.size()
+             and colored_neighbours[k].first == color;
+           k++) {
+        const unsigned int     dest_vertex    = colored_neighbours[k].second;
+        Partition::Cell* const neighbour_cell = p.get_cell(dest_vertex);
+        if (neighbour_cell->is_unit())
+          continue;
+        const unsigned int ival = ++p.invariant_values[dest_vertex];
+        if (ival > neighbour_cell->max_ival) {
+          neighbour_cell->max_ival       = ival;
+          neighbour_cell->max_ival_count = 1;
+          if (ival == 1)
+            neighbour_heap.insert(neighbour_cell->first);
+        } else if (ival == neighbour_cell->max_ival) {
+          neighbour_cell->max_ival_count++;
+        }
+      }
+
+      while (!neighbour_heap.is_empty()) {
+        const unsigned int     start          = neighbour_heap.remove();
+        Partition::Cell* const neighbour_cell = p.get_cell(p.elements[start]);
+
+        if (compute_eqref_hash) {
+          eqref_hash.update(neighbour_cell->first);
+          eqref_hash.update(neighbour_cell->length);
+          eqref_hash.update(neighbour_cell->max_ival);
+          eqref_hash.update(neighbour_cell->max_ival_count);
+        }
+
+        Partition::Cell* const last_new_cell
+            = p.zplit_cell(neighbour_cell, true);
+
+        /* Update certificate and hash if needed */
+        const Partition::Cell* c = neighbour_cell;
+        while (1) {
+          if (in_search) {
+            /* Build certificate */
+            cert_add_redundant(CERT_SPLIT, c->first, c->length);
+            /* No need to continue? */
+            if (refine_compare_certificate and (refine_equal_to_first == false)
+                and (refine_cmp_to_best < 0))
+              goto worse_exit;
+          }
+          if (compute_eqref_hash) {
+            eqref_hash.update(c->first);
+            eqref_hash.update(c->length);
+          }
+          if (c == last_new_cell)
+            break;
+          c = c->next;
+        }
+      }
+    }
+    return false;
+
+  worse_exit:
+    /* Clear neighbour heap */
+    UintSeqHash rest;
+    while (!neighbour_heap.is_empty()) {
+      const unsigned int     start          = neighbour_heap.remove();
+      Partition::Cell* const neighbour_cell = p.get_cell(p.elements[start]);
+      if (opt_use_failure_recording and was_equal_to_first) {
+        rest.update(neighbour_cell->first);
+        rest.update(neighbour_cell->length);
+        rest.update(neighbour_cell->max_ival);
+        rest.update(neighbour_cell->max_ival_count);
+      }
+      neighbour_cell->max_ival       = 0;
+      neighbour_cell->max_ival_count = 0;
+      p.clear_ivs(neighbour_cell);
+    }
+    if (opt_use_failure_recording and was_equal_to_first) {
+      for (unsigned int i = p.splitting_queue.size(); i > 0; i--) {
+        Partition::Cell* const cell2 = p.splitting_queue.pop_front();
+        rest.update(cell2->first);
+        rest.update(cell2->length);
+        p.splitting_queue.push_back(cell2);
+      }
+      rest.update(failure_recording_fp_deviation);
+      failure_recording_fp_deviation = rest.get_value();
+    }
+    return true;
+  }
+
+  bool Digraph::split_colored_neighbourhood_of_unit_cell(
+      Partition::Cell* const unit_cell) {
+    const bool was_equal_to_first = refine_equal_to_first;
+
+    if (compute_eqref_hash) {
+      eqref_hash.update(0x87654321);
+      eqref_hash.update(unit_cell->first);
+      eqref_hash.update(1);
+    }
+
+    /* Phase 1: the edges that leave the vertex v */
+    if (split_colored_neighbours(
+            unit_cell, edges_out, true, was_equal_to_first))
+      return true;
+
+    /* Phase 2: the edges that enter the vertex v */
+    if (split_colored_neighbours(
+            unit_cell, edges_in, false, was_equal_to_first))
+      return true;
+
+    if (refine_compare_certificate and (refine_equal_to_first == false)
+        and (refine_cmp_to_best < 0))
+      return true;
+
+    return false;
+  }
+
+  /*
+   * Split every cell containing a neighbour of the vertex in unit_cell, where
+   * the neighbours are the entries of the list of the vertex in edge_store,
+   * according to the colors of the edges. The certificate records, for every
+   * neighbour, its position and the color of its edge.
+   */
+  bool Digraph::split_colored_neighbours(Partition::Cell* const unit_cell,
+                                         const EdgeStore&       edge_store,
+                                         const bool             out,
+                                         const bool was_equal_to_first) {
+    const unsigned int  vnum      = p.elements[unit_cell->first];
+    const unsigned int* edges     = edge_store.begin(vnum);
+    const unsigned int* colors    = edge_store.colors_begin(vnum);
+    const unsigned int  nof_edges = edge_store.size(vnum);
+
+    for (unsigned int j = 0; j < nof_edges; j++) {
+      const unsigned int     dest_vertex    = edges[j];
+      Partition::Cell* const neighbour_cell = p.get_cell(dest_vertex);
+      /* The color is shifted by 1 so that 0 means "not a neighbour" */
+      neighbour_colors[dest_vertex] = colors[j] + 1;
+
+      if (neighbour_cell->is_unit()) {
+        if (in_search) {
+          /* Remember neighbour in order to generate certificate */
+          neighbour_heap.insert(neighbour_cell->first);
+        }
+        continue;
+      }
+      if (neighbour_cell->max_ival == 0) {
+        neighbour_heap.insert(neighbour_cell->first);
+      }
+      const unsigned int ival         = colors[j] + 1;
+      p.invariant_values[dest_vertex] = ival;
+      if (ival > neighbour_cell->max_ival) {
+        neighbour_cell->max_ival       = ival;
+        neighbour_cell->max_ival_count = 1;
+      } else if (ival == neighbour_cell->max_ival) {
+        neighbour_cell->max_ival_count++;
+      }
+    }
+
+    while (!neighbour_heap.is_empty()) {
+      const unsigned int     start          = neighbour_heap.remove();
+      Partition::Cell* const neighbour_cell = p.get_cell(p.elements[start]);
+
+      if (compute_eqref_hash) {
+        eqref_hash.update(neighbour_cell->first);
+        eqref_hash.update(neighbour_cell->length);
+        eqref_hash.update(neighbour_cell->max_ival);
+        eqref_hash.update(neighbour_cell->max_ival_count);
+      }
+
+      Partition::Cell* last_new_cell = neighbour_cell;
+      if (!neighbour_cell->is_unit()) {
+        last_new_cell = p.zplit_cell(neighbour_cell, true);
+      }
+
+      /* Update certificate and hash if needed */
+      const Partition::Cell* c = neighbour_cell;
+      while (1) {
+        const unsigned int color = neighbour_colors[p.elements[c->first]];
+        if (compute_eqref_hash) {
+          eqref_hash.update(c->first);
+          eqref_hash.update(c->length);
+          eqref_hash.update(color);
+        }
+        if (in_search and color != 0) {
+          for (unsigned int i = c->first, j = c->length; j > 0; j--, i++) {
+            /* Build certificate */
+            if (out) {
+              cert_add(CERT_EDGE + color - 1, unit_cell->first, i);
+            } else {
+              cert_add(CERT_EDGE + color - 1, i, unit_cell->first);
+            }
+            /* No need to continue? */
+            if (refine_compare_certificate and (refine_equal_to_first == false)
+                and (refine_cmp_to_best < 0))
+              goto worse_exit;
+          }
+        }
+        if (c == last_new_cell)
+          break;
+        c = c->next;
+      }
+    }
+
+    for (unsigned int j = 0; j < nof_edges; j++) {
+      neighbour_colors[edges[j]] = 0;
+    }
+    return false;
+
+  worse_exit:
+    /* Clear neighbour heap */
+    UintSeqHash rest;
+    while (!neighbour_heap.is_empty()) {
+      const unsigned int     start          = neighbour_heap.remove();
+      Partition::Cell* const neighbour_cell = p.get_cell(p.elements[start]);
+      if (opt_use_failure_recording and was_equal_to_first) {
+        rest.update(neighbour_cell->first);
+        rest.update(neighbour_cell->length);
+        rest.update(neighbour_cell->max_ival);
+        rest.update(neighbour_cell->max_ival_count);
+      }
+      if (!neighbour_cell->is_unit()) {
+        neighbour_cell->max_ival       = 0;
+        neighbour_cell->max_ival_count = 0;
+        p.clear_ivs(neighbour_cell);
+      }
+    }
+    if (opt_use_failure_recording and was_equal_to_first) {
+      rest.update(failure_recording_fp_deviation);
+      failure_recording_fp_deviation = rest.get_value();
+    }
+    for (unsigned int j = 0; j < nof_edges; j++) {
+      neighbour_colors[edges[j]] = 0;
+    }
+    return true;
+  }
+
+  void Digraph::nucr_note_edge_color(Partition::Cell* const cell,
+                                     const unsigned int     color) {
+    if (!has_edge_colors)
+      return;
+    unsigned int& cell_color = neighbour_colors[cell->first];
+    if (cell->max_ival_count == 0) {
+      cell_color = color + 1;
+    } else if (cell_color != color + 1) {
+      cell_color = UINT_MAX;
+    }
+  }
+
+  bool Digraph::nucr_edge_colors_uniform(Partition::Cell* const cell) {
+    if (!has_edge_colors)
+      return true;
+    const bool uniform                 = (neighbour_colors[cell->first] != UINT_MAX);
+    neighbour_colors[cell->first] = 0;
+    return uniform;
+  }
+
   /*-------------------------------------------------------------------------
    *
    * Check whether the current partition p is equitable.
@@ -2551,22 +3035,20 @@ namespace bliss_digraphs {
         continue;
 
       uint_pointer_substitute ep           = p.elements + cell->first;
-      const Vertex&           first_vertex = vertices[*ep++];
+      const unsigned int      first_vertex = *ep++;
 
       /* Count outgoing edges of the first vertex for cells */
-      for (std::vector<unsigned int>::const_iterator ei
-           = first_vertex.edges_out.begin();
-           ei != first_vertex.edges_out.end();
+      for (const unsigned int* ei = edges_out.begin(first_vertex);
+           ei != edges_out.end(first_vertex);
            ei++) {
         first_count[p.get_cell(*ei)->first]++;
       }
 
       /* Count and compare outgoing edges of the other vertices */
       for (unsigned int i = cell->length; i > 1; i--) {
-        const Vertex& vertex = vertices[*ep++];
-        for (std::vector<unsigned int>::const_iterator ei
-             = vertex.edges_out.begin();
-             ei != vertex.edges_out.end();
+        const unsigned int vertex = *ep++;
+        for (const unsigned int* ei = edges_out.begin(vertex);
+             ei != edges_out.end(vertex);
              ei++) {
           other_count[p.get_cell(*ei)->first]++;
         }
@@ -2592,22 +3074,20 @@ namespace bliss_digraphs {
         continue;
 
       uint_pointer_substitute ep           = p.elements + cell->first;
-      const Vertex&           first_vertex = vertices[*ep++];
+      const unsigned int      first_vertex = *ep++;
 
       /* Count incoming edges of the first vertex for cells */
-      for (std::vector<unsigned int>::const_iterator ei
-           = first_vertex.edges_in.begin();
-           ei != first_vertex.edges_in.end();
+      for (const unsigned int* ei = edges_in.begin(first_vertex);
+           ei != edges_in.end(first_vertex);
            ei++) {
         first_count[p.get_cell(*ei)->first]++;
       }
 
       /* Count and compare incoming edges of the other vertices */
       for (unsigned int i = cell->length; i > 1; i--) {
-        const Vertex& vertex = vertices[*ep++];
-        for (std::vector<unsigned int>::const_iterator ei
-             = vertex.edges_in.begin();
-             ei != vertex.edges_in.end();
+        const unsigned int vertex = *ep++;
+        for (const unsigned int* ei = edges_in.begin(vertex);
+             ei != edges_in.end(vertex);
              ei++) {
           other_count[p.get_cell(*ei)->first]++;
         }
@@ -2634,6 +3114,8 @@ namespace bliss_digraphs {
    *-------------------------------------------------------------------------*/
 
   void Digraph::make_initial_equitable_partition() {
+    neighbour_colors.assign(has_edge_colors ? get_nof_vertices() : 0, 0);
+
     refine_according_to_invariant(&vertex_color_invariant);
     p.splitting_queue_clear();
     // p.print_signature(stderr); fprintf(stderr, "\n");
@@ -2754,10 +3236,10 @@ namespace bliss_digraphs {
       if (opt_use_comprec and p.cr_get_level(cell->first) != cr_level)
         continue;
       int           value = 0;
-      const Vertex& v     = vertices[p.elements[cell->first]];
-      std::vector<unsigned int>::const_iterator ei;
-      ei = v.edges_in.begin();
-      for (unsigned int j = v.nof_edges_in(); j > 0; j--) {
+      const unsigned int vnum = p.elements[cell->first];
+      const unsigned int* ei;
+      ei = edges_in.begin(vnum);
+      for (unsigned int j = edges_in.size(vnum); j > 0; j--) {
         Partition::Cell* const neighbour_cell = p.get_cell(*ei++);
         if (neighbour_cell->is_unit())
           continue;
@@ -2772,8 +3254,8 @@ namespace bliss_digraphs {
         neighbour_cell->max_ival = 0;
       }
 
-      ei = v.edges_out.begin();
-      for (unsigned int j = v.nof_edges_out(); j > 0; j--) {
+      ei = edges_out.begin(vnum);
+      for (unsigned int j = edges_out.size(vnum); j > 0; j--) {
         Partition::Cell* const neighbour_cell = p.get_cell(*ei++);
         if (neighbour_cell->is_unit())
           continue;
@@ -2814,11 +3296,11 @@ namespace bliss_digraphs {
         continue;
 
       int           value = 0;
-      const Vertex& v     = vertices[p.elements[cell->first]];
-      std::vector<unsigned int>::const_iterator ei;
+      const unsigned int vnum = p.elements[cell->first];
+      const unsigned int* ei;
 
-      ei = v.edges_in.begin();
-      for (unsigned int j = v.nof_edges_in(); j > 0; j--) {
+      ei = edges_in.begin(vnum);
+      for (unsigned int j = edges_in.size(vnum); j > 0; j--) {
         Partition::Cell* const neighbour_cell = p.get_cell(*ei++);
         if (neighbour_cell->is_unit())
           continue;
@@ -2833,8 +3315,8 @@ namespace bliss_digraphs {
         neighbour_cell->max_ival = 0;
       }
 
-      ei = v.edges_out.begin();
-      for (unsigned int j = v.nof_edges_out(); j > 0; j--) {
+      ei = edges_out.begin(vnum);
+      for (unsigned int j = edges_out.size(vnum); j > 0; j--) {
         Partition::Cell* const neighbour_cell = p.get_cell(*ei++);
         if (neighbour_cell->is_unit())
           continue;
@@ -2878,11 +3360,11 @@ namespace bliss_digraphs {
         continue;
 
       int           value = 0;
-      const Vertex& v     = vertices[p.elements[cell->first]];
-      std::vector<unsigned int>::const_iterator ei;
+      const unsigned int vnum = p.elements[cell->first];
+      const unsigned int* ei;
 
-      ei = v.edges_in.begin();
-      for (unsigned int j = v.nof_edges_in(); j > 0; j--) {
+      ei = edges_in.begin(vnum);
+      for (unsigned int j = edges_in.size(vnum); j > 0; j--) {
         Partition::Cell* const neighbour_cell = p.get_cell(*ei++);
         if (neighbour_cell->is_unit())
           continue;
@@ -2897,8 +3379,8 @@ namespace bliss_digraphs {
         neighbour_cell->max_ival = 0;
       }
 
-      ei = v.edges_out.begin();
-      for (unsigned int j = v.nof_edges_out(); j > 0; j--) {
+      ei = edges_out.begin(vnum);
+      for (unsigned int j = edges_out.size(vnum); j > 0; j--) {
         Partition::Cell* const neighbour_cell = p.get_cell(*ei++);
         if (neighbour_cell->is_unit())
           continue;
@@ -2936,46 +3418,48 @@ namespace bliss_digraphs {
     certificate_best_path.clear();
   }
 
+  /*
+   * Replace the contents of edges by the pairs (w, c), where w is the image
+   * under perm (or w itself if perm is 0) of a vertex in the list of v in
+   * store, and c is the color of the edge (or 0 if the edges are not colored).
+   */
+  static void
+  colored_edges_of_vertex(
+      std::set<std::pair<unsigned int, unsigned int> >& edges,
+      const EdgeStore&                                  store,
+      const unsigned int                                v,
+      const unsigned int*                               perm) {
+    edges.clear();
+    const unsigned int* ei = store.begin(v);
+    for (unsigned int j = 0; j < store.size(v); j++) {
+      edges.insert(
+          std::make_pair(perm ? perm[ei[j]] : ei[j],
+                         store.has_colors() ? store.colors_begin(v)[j] : 0));
+    }
+  }
+
   /*
    * Check whether perm is an automorphism.
    * Slow, mainly for debugging and validation purposes.
    */
   bool Digraph::is_automorphism(uint_pointer_substitute const perm) {
-    std::set<unsigned int, std::less<unsigned int> > edges1;
-    std::set<unsigned int, std::less<unsigned int> > edges2;
+    std::set<std::pair<unsigned int, unsigned int> > edges1;
+    std::set<std::pair<unsigned int, unsigned int> > edges2;
 
 #if defined(BLISS_CONSISTENCY_CHECKS)
     if (!is_permutation(get_nof_vertices(), perm))
       _INTERNAL_ERROR();
 #endif
 
+    const unsigned int* const perm_ptr = &*perm;
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v1 = vertices[i];
-      Vertex& v2 = vertices[perm[i]];
-
-      edges1.clear();
-      for (std::vector<unsigned int>::iterator ei = v1.edges_in.begin();
-           ei != v1.edges_in.end();
-           ei++)
-        edges1.insert(perm[*ei]);
-      edges2.clear();
-      for (std::vector<unsigned int>::iterator ei = v2.edges_in.begin();
-           ei != v2.edges_in.end();
-           ei++)
-        edges2.insert(*ei);
+      colored_edges_of_vertex(edges1, edges_in, i, perm_ptr);
+      colored_edges_of_vertex(edges2, edges_in, perm[i], 0);
       if (!(edges1 == edges2))
         return false;
 
-      edges1.clear();
-      for (std::vector<unsigned int>::iterator ei = v1.edges_out.begin();
-           ei != v1.edges_out.end();
-           ei++)
-        edges1.insert(perm[*ei]);
-      edges2.clear();
-      for (std::vector<unsigned int>::iterator ei = v2.edges_out.begin();
-           ei != v2.edges_out.end();
-           ei++)
-        edges2.insert(*ei);
+      colored_edges_of_vertex(edges1, edges_out, i, perm_ptr);
+      colored_edges_of_vertex(edges2, edges_out, perm[i], 0);
       if (!(edges1 == edges2))
         return false;
     }
@@ -2987,36 +3471,17 @@ namespace bliss_digraphs {
     if (!(perm.size() == get_nof_vertices() and is_permutation(perm)))
       return false;
 
-    std::set<unsigned int, std::less<unsigned int> > edges1;
-    std::set<unsigned int, std::less<unsigned int> > edges2;
+    std::set<std::pair<unsigned int, unsigned int> > edges1;
+    std::set<std::pair<unsigned int, unsigned int> > edges2;
 
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      const Vertex& v1 = vertices[i];
-      const Vertex& v2 = vertices[perm[i]];
-
-      edges1.clear();
-      for (std::vector<unsigned int>::const_iterator ei = v1.edges_in.begin();
-           ei != v1.edges_in.end();
-           ei++)
-        edges1.insert(perm[*ei]);
-      edges2.clear();
-      for (std::vector<unsigned int>::const_iterator ei = v2.edges_in.begin();
-           ei != v2.edges_in.end();
-           ei++)
-        edges2.insert(*ei);
+      colored_edges_of_vertex(edges1, edges_in, i, perm.data());
+      colored_edges_of_vertex(edges2, edges_in, perm[i], 0);
       if (!(edges1 == edges2))
         return false;
 
-      edges1.clear();
-      for (std::vector<unsigned int>::const_iterator ei = v1.edges_out.begin();
-           ei != v1.edges_out.end();
-           ei++)
-        edges1.insert(perm[*ei]);
-      edges2.clear();
-      for (std::vector<unsigned int>::const_iterator ei = v2.edges_out.begin();
-           ei != v2.edges_out.end();
-           ei++)
-        edges2.insert(*ei);
+      colored_edges_of_vertex(edges1, edges_out, i, perm.data());
+      colored_edges_of_vertex(edges2, edges_out, perm[i], 0);
       if (!(edges1 == edges2))
         return false;
     }
@@ -3047,12 +3512,10 @@ namespace bliss_digraphs {
     for (unsigned int i = 0; i < component.size(); i++) {
       Partition::Cell* const cell = component[i];
 
-      const Vertex& v = vertices[p.elements[cell->first]];
-      std::vector<unsigned int>::const_iterator ei;
-
-      ei = v.edges_out.begin();
-      for (unsigned int j = v.nof_edges_out(); j > 0; j--) {
-        const unsigned int     neighbour      = *ei++;
+      const unsigned int  vnum   = p.elements[cell->first];
+      const unsigned int* colors = edges_out.colors_begin(vnum);
+      for (unsigned int j = 0; j < edges_out.size(vnum); j++) {
+        const unsigned int     neighbour      = edges_out.begin(vnum)[j];
         Partition::Cell* const neighbour_cell = p.get_cell(neighbour);
 
         /* Skip unit neighbours */
@@ -3065,6 +3528,7 @@ namespace bliss_digraphs {
         if (p.cr_get_level(neighbour_cell->first) != level)
           continue;
 
+        nucr_note_edge_color(neighbour_cell, colors ? colors[j] : 0);
         if (neighbour_cell->max_ival_count == 0)
           neighbour_heap.insert(neighbour_cell->first);
         neighbour_cell->max_ival_count++;
@@ -3074,7 +3538,8 @@ namespace bliss_digraphs {
         Partition::Cell* const neighbour_cell = p.get_cell(p.elements[start]);
 
         /* Skip saturated neighbour cells */
-        if (neighbour_cell->max_ival_count == neighbour_cell->length) {
+        if (nucr_edge_colors_uniform(neighbour_cell)
+            and neighbour_cell->max_ival_count == neighbour_cell->length) {
           neighbour_cell->max_ival_count = 0;
           continue;
         }
@@ -3083,9 +3548,9 @@ namespace bliss_digraphs {
         component.push_back(neighbour_cell);
       }
 
-      ei = v.edges_in.begin();
-      for (unsigned int j = v.nof_edges_in(); j > 0; j--) {
-        const unsigned int neighbour = *ei++;
+      colors = edges_in.colors_begin(vnum);
+      for (unsigned int j = 0; j < edges_in.size(vnum); j++) {
+        const unsigned int neighbour = edges_in.begin(vnum)[j];
 
         Partition::Cell* const neighbour_cell = p.get_cell(neighbour);
 
@@ -3099,6 +3564,7 @@ namespace bliss_digraphs {
         if (p.cr_get_level(neighbour_cell->first) != level)
           continue;
 
+        nucr_note_edge_color(neighbour_cell, colors ? colors[j] : 0);
         if (neighbour_cell->max_ival_count == 0)
           neighbour_heap.insert(neighbour_cell->first);
         neighbour_cell->max_ival_count++;
@@ -3108,7 +3574,8 @@ namespace bliss_digraphs {
         Partition::Cell* const neighbour_cell = p.get_cell(p.elements[start]);
 
         /* Skip saturated neighbour cells */
-        if (neighbour_cell->max_ival_count == neighbour_cell->length) {
+        if (nucr_edge_colors_uniform(neighbour_cell)
+            and neighbour_cell->max_ival_count == neighbour_cell->length) {
           neighbour_cell->max_ival_count = 0;
           continue;
         }
@@ -3171,13 +3638,11 @@ namespace bliss_digraphs {
 
       unsigned int nuconn = 1;
 
-      const Vertex& v = vertices[p.elements[cell->first]];
-      std::vector<unsigned int>::const_iterator ei;
-
+      const unsigned int  vnum   = p.elements[cell->first];
+      const unsigned int* colors = edges_out.colors_begin(vnum);
       /*| Phase 1: outgoing edges */
-      ei = v.edges_out.begin();
-      for (unsigned int j = v.nof_edges_out(); j > 0; j--) {
-        const unsigned int neighbour = *ei++;
+      for (unsigned int j = 0; j < edges_out.size(vnum); j++) {
+        const unsigned int neighbour = edges_out.begin(vnum)[j];
 
         Partition::Cell* const neighbour_cell = p.get_cell(neighbour);
 
@@ -3187,6 +3652,7 @@ namespace bliss_digraphs {
         /* Is the neighbour at the same component recursion level? */
         // if(p.cr_get_level(neighbour_cell->first) != level)
         //   continue;
+        nucr_note_edge_color(neighbour_cell, colors ? colors[j] : 0);
         if (neighbour_cell->max_ival_count == 0)
           neighbours.push(neighbour_cell);
         neighbour_cell->max_ival_count++;
@@ -3194,7 +3660,8 @@ namespace bliss_digraphs {
       while (!neighbours.is_empty()) {
         Partition::Cell* const neighbour_cell = neighbours.pop();
         /* Skip saturated neighbour cells */
-        if (neighbour_cell->max_ival_count == neighbour_cell->length) {
+        if (nucr_edge_colors_uniform(neighbour_cell)
+            and neighbour_cell->max_ival_count == neighbour_cell->length) {
           neighbour_cell->max_ival_count = 0;
           continue;
         }
@@ -3207,9 +3674,9 @@ namespace bliss_digraphs {
       }
 
       /*| Phase 2: incoming edges */
-      ei = v.edges_in.begin();
-      for (unsigned int j = v.nof_edges_in(); j > 0; j--) {
-        const unsigned int     neighbour      = *ei++;
+      colors = edges_in.colors_begin(vnum);
+      for (unsigned int j = 0; j < edges_in.size(vnum); j++) {
+        const unsigned int     neighbour      = edges_in.begin(vnum)[j];
         Partition::Cell* const neighbour_cell = p.get_cell(neighbour);
         /*| Skip unit neighbours */
         if (neighbour_cell->is_unit())
@@ -3217,6 +3684,7 @@ namespace bliss_digraphs {
         /* Is the neighbour at the same component recursion level? */
         // if(p.cr_get_level(neighbour_cell->first) != level)
         //   continue;
+        nucr_note_edge_color(neighbour_cell, colors ? colors[j] : 0);
         if (neighbour_cell->max_ival_count == 0)
           neighbours.push(neighbour_cell);
         neighbour_cell->max_ival_count++;
@@ -3224,7 +3692,8 @@ namespace bliss_digraphs {
       while (!neighbours.is_empty()) {
         Partition::Cell* const neighbour_cell = neighbours.pop();
         /* Skip saturated neighbour cells */
-        if (neighbour_cell->max_ival_count == neighbour_cell->length) {
+        if (nucr_edge_colors_uniform(neighbour_cell)
+            and neighbour_cell->max_ival_count == neighbour_cell->length) {
           neighbour_cell->max_ival_count = 0;
           continue;
         }
@@ -3333,52 +3802,6 @@ namespace bliss_digraphs {
     ;
   }
 
-  void Graph::Vertex::add_edge(const unsigned int other_vertex) {
-    edges.push_back(other_vertex);
-  }
-
-  void Graph::Vertex::remove_duplicate_edges(std::vector<bool>& tmp) {
-#if defined(BLISS_CONSISTENCY_CHECKS)
-    /* Pre-conditions  */
-    for (unsigned int i = 0; i < tmp.size(); i++)
-      assert(tmp[i] == false);
-#endif
-    for (std::vector<unsigned int>::iterator iter = edges.begin();
-         iter != edges.end();) {
-      const unsigned int dest_vertex = *iter;
-      if (tmp[dest_vertex] == true) {
-        /* A duplicate edge found! */
-        iter = edges.erase(iter);
-      } else {
-        /* Not seen earlier, mark as seen */
-        tmp[dest_vertex] = true;
-        iter++;
-      }
-    }
-
-    /* Clear tmp */
-    for (std::vector<unsigned int>::iterator iter = edges.begin();
-         iter != edges.end();
-         iter++) {
-      tmp[*iter] = false;
-    }
-#if defined(BLISS_CONSISTENCY_CHECKS)
-    /* Post-conditions  */
-    for (unsigned int i = 0; i < tmp.size(); i++)
-      assert(tmp[i] == false);
-#endif
-  }
-
-  /**
-   * Sort the edges leaving the vertex according to
-   * the vertex number of the other edge end.
-   * Time complexity: O(e log(e)), where e is the number of edges
-   * leaving the vertex.
-   */
-  void Graph::Vertex::sort_edges() {
-    std::sort(edges.begin(), edges.end());
-  }
-
   /*-------------------------------------------------------------------------
    *
    * Constructor and destructor for undirected graphs
@@ -3387,6 +3810,7 @@ namespace bliss_digraphs {
 
   Graph::Graph(const unsigned int nof_vertices) {
     vertices.resize(nof_vertices);
+    edges.add_vertices(nof_vertices);
     sh = shs_flm;
   }
 
@@ -3395,17 +3819,37 @@ namespace bliss_digraphs {
     ;
   }
 
+  Graph* Graph::from_csr(const unsigned int        N,
+                         const unsigned int* const colors,
+                         const unsigned int* const offsets,
+                         const unsigned int* const targets) {
+    Graph* const g = new Graph(0);
+    g->assign_csr(N, colors, offsets, targets);
+    return g;
+  }
+
+  void Graph::assign_csr(const unsigned int        N,
+                         const unsigned int* const colors,
+                         const unsigned int* const offsets,
+                         const unsigned int* const targets) {
+    vertices.resize(N);
+    for (unsigned int i = 0; i < N; i++)
+      vertices[i].color = colors ? colors[i] : 0;
+    edges.assign(N, offsets, targets, 0);
+  }
+
   unsigned int Graph::add_vertex(const unsigned int color) {
     const unsigned int vertex_num = vertices.size();
     vertices.resize(vertex_num + 1);
     vertices.back().color = color;
+    edges.add_vertices(1);
     return vertex_num;
   }
 
   void Graph::add_edge(const unsigned int vertex1, const unsigned int vertex2) {
     // fprintf(stderr, "(%u,%u) ", vertex1, vertex2);
-    vertices[vertex1].add_edge(vertex2);
-    vertices[vertex2].add_edge(vertex1);
+    edges.push_back(vertex1, vertex2);
+    edges.push_back(vertex2, vertex1);
   }
 
   void Graph::change_color(const unsigned int vertex,
@@ -3570,10 +4014,7 @@ namespace bliss_digraphs {
     /* First count the total number of edges */
     unsigned int nof_edges = 0;
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v = vertices[i];
-      for (std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-           ei != v.edges.end();
-           ei++) {
+      for (const unsigned int* ei = edges.begin(i); ei != edges.end(i); ei++) {
         const unsigned int dest_i = *ei;
         if (dest_i < i)
           continue;
@@ -3586,7 +4027,7 @@ namespace bliss_digraphs {
 
     /* Print the color of each vertex */
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v = vertices[i];
+      const Vertex& v = vertices[i];
       fprintf(fp, "n %u %u\n", i + 1, v.color);
       /*
       if(v.color != 0)
@@ -3598,10 +4039,7 @@ namespace bliss_digraphs {
 
     /* Print the edges */
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v = vertices[i];
-      for (std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-           ei != v.edges.end();
-           ei++) {
+      for (const unsigned int* ei = edges.begin(i); ei != edges.end(i); ei++) {
         const unsigned int dest_i = *ei;
         if (dest_i < i)
           continue;
@@ -3611,8 +4049,7 @@ namespace bliss_digraphs {
   }
 
   void Graph::sort_edges() {
-    for (unsigned int i = 0; i < get_nof_vertices(); i++)
-      vertices[i].sort_edges();
+    edges.sort();
   }
 
   int Graph::cmp(Graph& other) {
@@ -3632,20 +4069,18 @@ namespace bliss_digraphs {
     remove_duplicate_edges();
     other.remove_duplicate_edges();
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      if (vertices[i].nof_edges() < other.vertices[i].nof_edges())
+      if (edges.size(i) < other.edges.size(i))
         return -1;
-      if (vertices[i].nof_edges() > other.vertices[i].nof_edges())
+      if (edges.size(i) > other.edges.size(i))
         return 1;
     }
     /* Compare edges */
+    sort_edges();
+    other.sort_edges();
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v1 = vertices[i];
-      Vertex& v2 = other.vertices[i];
-      v1.sort_edges();
-      v2.sort_edges();
-      std::vector<unsigned int>::const_iterator ei1 = v1.edges.begin();
-      std::vector<unsigned int>::const_iterator ei2 = v2.edges.begin();
-      while (ei1 != v1.edges.end()) {
+      const unsigned int* ei1 = edges.begin(i);
+      const unsigned int* ei2 = other.edges.begin(i);
+      while (ei1 != edges.end(i)) {
         if (*ei1 < *ei2)
           return -1;
         if (*ei1 > *ei2)
@@ -3658,23 +4093,7 @@ namespace bliss_digraphs {
   }
 
   Graph* Graph::permute(const std::vector<unsigned int>& perm) const {
-#if defined(BLISS_CONSISTENCY_CHECKS)
-#endif
-
-    Graph* const g = new Graph(get_nof_vertices());
-    for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      const Vertex& v          = vertices[i];
-      Vertex&       permuted_v = g->vertices[perm[i]];
-      permuted_v.color         = v.color;
-      for (std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-           ei != v.edges.end();
-           ei++) {
-        const unsigned int dest_v = *ei;
-        permuted_v.add_edge(perm[dest_v]);
-      }
-      permuted_v.sort_edges();
-    }
-    return g;
+    return permute(perm.data());
   }
 
   Graph* Graph::permute(const unsigned int* perm) const {
@@ -3683,19 +4102,24 @@ namespace bliss_digraphs {
       _INTERNAL_ERROR();
 #endif
 
-    Graph* const g = new Graph(get_nof_vertices());
-    for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      const Vertex& v          = vertices[i];
-      Vertex&       permuted_v = g->vertices[perm[i]];
-      permuted_v.color         = v.color;
-      for (std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-           ei != v.edges.end();
-           ei++) {
-        const unsigned int dest_v = *ei;
-        permuted_v.add_edge(perm[dest_v]);
-      }
-      permuted_v.sort_edges();
+    const unsigned int        N = get_nof_vertices();
+    std::vector<unsigned int> colors(N);
+    std::vector<unsigned int> offsets(N + 1, 0);
+    std::vector<unsigned int> targets(edges.nof_edges());
+    for (unsigned int i = 0; i < N; i++) {
+      colors[perm[i]]      = vertices[i].color;
+      offsets[perm[i] + 1] = edges.size(i);
+    }
+    for (unsigned int i = 0; i < N; i++)
+      offsets[i + 1] += offsets[i];
+    for (unsigned int i = 0; i < N; i++) {
+      unsigned int pos = offsets[perm[i]];
+      for (const unsigned int* ei = edges.begin(i); ei != edges.end(i); ei++)
+        targets[pos++] = perm[*ei];
     }
+    Graph* const g
+        = from_csr(N, colors.data(), offsets.data(), targets.data());
+    g->sort_edges();
     return g;
   }
 
@@ -3718,14 +4142,10 @@ namespace bliss_digraphs {
 
     fprintf(fp, "graph g {\n");
 
-    unsigned int vnum = 0;
-    for (std::vector<Vertex>::iterator vi = vertices.begin();
-         vi != vertices.end();
-         vi++, vnum++) {
-      Vertex& v = *vi;
+    for (unsigned int vnum = 0; vnum < get_nof_vertices(); vnum++) {
+      const Vertex& v = vertices[vnum];
       fprintf(fp, "v%u [label=\"%u:%u\"];\n", vnum, vnum, v.color);
-      for (std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-           ei != v.edges.end();
+      for (const unsigned int* ei = edges.begin(vnum); ei != edges.end(vnum);
            ei++) {
         const unsigned int vnum2 = *ei;
         if (vnum2 > vnum)
@@ -3757,10 +4177,7 @@ namespace bliss_digraphs {
 
     /* Hash the edges */
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v = vertices[i];
-      for (std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-           ei != v.edges.end();
-           ei++) {
+      for (const unsigned int* ei = edges.begin(i); ei != edges.end(i); ei++) {
         const unsigned int dest_i = *ei;
         if (dest_i < i)
           continue;
@@ -3774,16 +4191,7 @@ namespace bliss_digraphs {
 
   void Graph::remove_duplicate_edges() {
     std::vector<bool> tmp(vertices.size(), false);
-
-    for (std::vector<Vertex>::iterator vi = vertices.begin();
-         vi != vertices.end();
-         vi++) {
-#if defined(BLISS_EXPENSIVE_CONSISTENCY_CHECKS)
-      for (unsigned int i = 0; i < tmp.size(); i++)
-        assert(tmp[i] == false);
-#endif
-      (*vi).remove_duplicate_edges(tmp);
-    }
+    edges.remove_duplicates(tmp);
   }
 
   /*-------------------------------------------------------------------------
@@ -3807,7 +4215,7 @@ namespace bliss_digraphs {
    */
   unsigned int Graph::degree_invariant(const Graph* const g,
                                        const unsigned int v) {
-    return g->vertices[v].nof_edges();
+    return g->edges.size(v);
   }
 
   /*
@@ -3816,9 +4224,7 @@ namespace bliss_digraphs {
    */
   unsigned int Graph::selfloop_invariant(const Graph* const g,
                                          const unsigned int v) {
-    const Vertex& vertex = g->vertices[v];
-    for (std::vector<unsigned int>::const_iterator ei = vertex.edges.begin();
-         ei != vertex.edges.end();
+    for (const unsigned int* ei = g->edges.begin(v); ei != g->edges.end(v);
          ei++) {
       if (*ei == v)
         return 1;
@@ -3874,10 +4280,10 @@ namespace bliss_digraphs {
 
     uint_pointer_to_const_substitute ep = p.elements + cell->first;
     for (unsigned int i = cell->length; i > 0; i--) {
-      const Vertex& v = vertices[*ep++];
+      const unsigned int vnum = *ep++;
 
-      std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-      for (unsigned int j = v.nof_edges(); j != 0; j--) {
+      const unsigned int* ei = edges.begin(vnum);
+      for (unsigned int j = edges.size(vnum); j != 0; j--) {
         const unsigned int     dest_vertex    = *ei++;
         Partition::Cell* const neighbour_cell = p.get_cell(dest_vertex);
         if (neighbour_cell->is_unit())
@@ -3974,10 +4380,10 @@ namespace bliss_digraphs {
       eqref_hash.update(1);
     }
 
-    const Vertex& v = vertices[p.elements[unit_cell->first]];
+    const unsigned int vnum = p.elements[unit_cell->first];
 
-    std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-    for (unsigned int j = v.nof_edges(); j > 0; j--) {
+    const unsigned int* ei = edges.begin(vnum);
+    for (unsigned int j = edges.size(vnum); j > 0; j--) {
       const unsigned int     dest_vertex    = *ei++;
       Partition::Cell* const neighbour_cell = p.get_cell(dest_vertex);
 
@@ -4134,23 +4540,21 @@ namespace bliss_digraphs {
         continue;
 
       uint_pointer_substitute ep           = p.elements + cell->first;
-      const Vertex&           first_vertex = vertices[*ep++];
+      const unsigned int      first_vertex = *ep++;
 
       /* Count how many edges lead from the first vertex to
        * the neighbouring cells */
-      for (std::vector<unsigned int>::const_iterator ei
-           = first_vertex.edges.begin();
-           ei != first_vertex.edges.end();
+      for (const unsigned int* ei = edges.begin(first_vertex);
+           ei != edges.end(first_vertex);
            ei++) {
         first_count[p.get_cell(*ei)->first]++;
       }
 
       /* Count and compare to the edges of the other vertices */
       for (unsigned int i = cell->length; i > 1; i--) {
-        const Vertex& vertex = vertices[*ep++];
-        for (std::vector<unsigned int>::const_iterator ei
-             = vertex.edges.begin();
-             ei != vertex.edges.end();
+        const unsigned int vertex = *ep++;
+        for (const unsigned int* ei = edges.begin(vertex);
+             ei != edges.end(vertex);
              ei++) {
           other_count[p.get_cell(*ei)->first]++;
         }
@@ -4289,9 +4693,9 @@ namespace bliss_digraphs {
          cell                  = cell->next_nonsingleton) {
       if (opt_use_comprec and p.cr_get_level(cell->first) != cr_level)
         continue;
-      const Vertex& v = vertices[p.elements[cell->first]];
-      std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-      for (unsigned int j = v.nof_edges(); j > 0; j--) {
+      const unsigned int vnum = p.elements[cell->first];
+      const unsigned int* ei = edges.begin(vnum);
+      for (unsigned int j = edges.size(vnum); j > 0; j--) {
         Partition::Cell* const neighbour_cell = p.get_cell(*ei++);
         if (neighbour_cell->is_unit())
           continue;
@@ -4331,9 +4735,9 @@ namespace bliss_digraphs {
       if (opt_use_comprec and p.cr_get_level(cell->first) != cr_level)
         continue;
 
-      const Vertex& v = vertices[p.elements[cell->first]];
-      std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-      for (unsigned int j = v.nof_edges(); j > 0; j--) {
+      const unsigned int vnum = p.elements[cell->first];
+      const unsigned int* ei = edges.begin(vnum);
+      for (unsigned int j = edges.size(vnum); j > 0; j--) {
         Partition::Cell* const neighbour_cell = p.get_cell(*ei++);
         if (neighbour_cell->is_unit())
           continue;
@@ -4375,9 +4779,9 @@ namespace bliss_digraphs {
          cell                  = cell->next_nonsingleton) {
       if (opt_use_comprec and p.cr_get_level(cell->first) != cr_level)
         continue;
-      const Vertex& v = vertices[p.elements[cell->first]];
-      std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-      for (unsigned int j = v.nof_edges(); j > 0; j--) {
+      const unsigned int vnum = p.elements[cell->first];
+      const unsigned int* ei = edges.begin(vnum);
+      for (unsigned int j = edges.size(vnum); j > 0; j--) {
         Partition::Cell* const neighbour_cell = p.get_cell(*ei++);
         if (neighbour_cell->is_unit())
           continue;
@@ -4432,17 +4836,13 @@ namespace bliss_digraphs {
 #endif
 
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      Vertex& v1 = vertices[i];
       edges1.clear();
-      for (std::vector<unsigned int>::iterator ei = v1.edges.begin();
-           ei != v1.edges.end();
-           ei++)
+      for (const unsigned int* ei = edges.begin(i); ei != edges.end(i); ei++)
         edges1.insert(perm[*ei]);
 
-      Vertex& v2 = vertices[perm[i]];
       edges2.clear();
-      for (std::vector<unsigned int>::iterator ei = v2.edges.begin();
-           ei != v2.edges.end();
+      for (const unsigned int* ei = edges.begin(perm[i]);
+           ei != edges.end(perm[i]);
            ei++)
         edges2.insert(*ei);
 
@@ -4461,17 +4861,13 @@ namespace bliss_digraphs {
     std::set<unsigned int, std::less<unsigned int> > edges2;
 
     for (unsigned int i = 0; i < get_nof_vertices(); i++) {
-      const Vertex& v1 = vertices[i];
       edges1.clear();
-      for (std::vector<unsigned int>::const_iterator ei = v1.edges.begin();
-           ei != v1.edges.end();
-           ei++)
+      for (const unsigned int* ei = edges.begin(i); ei != edges.end(i); ei++)
         edges1.insert(perm[*ei]);
 
-      const Vertex& v2 = vertices[perm[i]];
       edges2.clear();
-      for (std::vector<unsigned int>::const_iterator ei = v2.edges.begin();
-           ei != v2.edges.end();
+      for (const unsigned int* ei = edges.begin(perm[i]);
+           ei != edges.end(perm[i]);
            ei++)
         edges2.insert(*ei);
 
@@ -4505,9 +4901,9 @@ namespace bliss_digraphs {
     for (unsigned int i = 0; i < component.size(); i++) {
       Partition::Cell* const cell = component[i];
 
-      const Vertex& v = vertices[p.elements[cell->first]];
-      std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-      for (unsigned int j = v.nof_edges(); j > 0; j--) {
+      const unsigned int vnum = p.elements[cell->first];
+      const unsigned int* ei = edges.begin(vnum);
+      for (unsigned int j = edges.size(vnum); j > 0; j--) {
         const unsigned int neighbour = *ei++;
 
         Partition::Cell* const neighbour_cell = p.get_cell(neighbour);
@@ -4592,9 +4988,9 @@ namespace bliss_digraphs {
     for (unsigned int i = 0; i < comp.size(); i++) {
       Partition::Cell* const cell = comp[i];
 
-      const Vertex& v = vertices[p.elements[cell->first]];
-      std::vector<unsigned int>::const_iterator ei = v.edges.begin();
-      for (unsigned int j = v.nof_edges(); j > 0; j--) {
+      const unsigned int vnum = p.elements[cell->first];
+      const unsigned int* ei = edges.begin(vnum);
+      for (unsigned int j = edges.size(vnum); j > 0; j--) {
         const unsigned int neighbour = *ei++;
 
         Partition::Cell* const neighbour_cell = p.get_cell(neighbour);
@@ -30,6 +30,7 @@ namespace bliss_digraphs {
 }
 
 #include <cstdio>
+#include <utility>
 #include <vector>
 #include "kstack.hh"
 #include "kqueue.hh"
@@ -43,6 +44,109 @@ namespace bliss_digraphs {
   typedef std::vector<unsigned int>::iterator uint_pointer_substitute;
   typedef std::vector<unsigned int>::const_iterator uint_pointer_to_const_substitute;
 
+/** \internal
+ * \brief The adjacency lists of the vertices of a graph, stored one after
+ * another in a single array, in the manner of compressed sparse row storage.
+ *
+ * The list of the vertex v consists of the elements first[v], ...,
+ * first[v] + length[v] - 1 of the array targets, and, if the edges are
+ * colored, the colors of the edges are the corresponding elements of the
+ * array colors. Lists that are built one edge at a time reserve some spare
+ * room, and a list that outgrows its room is moved to the end of the array;
+ * the gaps that this leaves are removed by remove_duplicates(), which is
+ * called before the search, so that the search itself always streams through
+ * a single contiguous array.
+ */
+class EdgeStore
+{
+  std::vector<unsigned int> targets;
+  std::vector<unsigned int> colors;
+  std::vector<unsigned int> first;
+  std::vector<unsigned int> length;
+  std::vector<unsigned int> capacity;
+  unsigned int nof_edges_;
+  bool colored;
+  /* True if there are no gaps and no duplicate edges */
+  bool clean;
+  void reserve_one(const unsigned int v);
+public:
+  EdgeStore() : nof_edges_(0), colored(false), clean(true) {}
+
+  /**
+   * Add \a n vertices with empty lists.
+   */
+  void add_vertices(const unsigned int n);
+
+  /**
+   * Empty the lists of all of the vertices.
+   */
+  void clear();
+
+  /**
+   * Append \a w to the list of \a v, with color \a color.
+   * Time complexity: amortized O(1).
+   */
+  void push_back(const unsigned int v,
+                 const unsigned int w,
+                 const unsigned int color = 0);
+
+  /**
+   * Make the edges colored; the existing edges get color 0.
+   */
+  void enable_colors();
+
+  /**
+   * Replace the lists of the vertices by the lists
+   * \a targets[\a offsets[v]], ..., \a targets[\a offsets[v + 1] - 1]
+   * for v = 0, ..., \a N - 1, with the colors in the corresponding
+   * positions of \a colors if \a colors is not 0.
+   */
+  void assign(const unsigned int N,
+              const unsigned int* const offsets,
+              const unsigned int* const targets,
+              const unsigned int* const colors);
+
+  /**
+   * Replace the lists of the vertices by the reverses of the edges in
+   * \a other, so that w is in the list of v if and only if v is in the list
+   * of w in \a other. The list of each vertex is ordered by the position of
+   * the corresponding edge in \a other.
+   */
+  void assign_transpose(const EdgeStore& other);
+
+  /**
+   * Remove the duplicate edges from every list, keeping the first one, and
+   * remove the gaps between the lists. The vector \a tmp must have at least
+   * one entry for every vertex, all false, and is false again on return.
+   */
+  void remove_duplicates(std::vector<bool>& tmp);
+
+  /**
+   * Sort every list by vertex, and then by color.
+   */
+  void sort();
+
+  /** Returns the number of edges in the lists of all vertices. */
+  unsigned int nof_edges() const {return nof_edges_; }
+  /** Returns true if the edges are colored. */
+  bool has_colors() const {return colored; }
+  /** Returns the number of edges in the list of \a v. */
+  unsigned int size(const unsigned int v) const {return length[v]; }
+  /** Returns a pointer to the start of the list of \a v. */
+  const unsigned int* begin(const unsigned int v) const {
+    return targets.data() + first[v];
+  }
+  /** Returns a pointer to the end of the list of \a v. */
+  const unsigned int* end(const unsigned int v) const {
+    return targets.data() + first[v] + length[v];
+  }
+  /** Returns a pointer to the colors of the edges in the list of \a v,
+   *  or 0 if the edges are not colored. */
+  const unsigned int* colors_begin(const unsigned int v) const {
+    return colored ? colors.data() + first[v] : 0;
+  }
+};
+
 /**
  * \brief Statistics returned by the bliss search algorithm.
  */
@@ -159,6 +263,11 @@ public:
    */
   virtual void change_color(const unsigned int vertex, const unsigned int color) = 0;
 
+  /**
+   * Remove all of the edges of the graph, but not its vertices.
+   */
+  virtual void clear() = 0;
+
   /**
    * Check whether \a perm is an automorphism of this graph.
    * Unoptimized, mainly for debugging purposes.
@@ -575,27 +684,16 @@ protected:
   public:
     Vertex();
     ~Vertex();
-    void add_edge(const unsigned int other_vertex);
-    void remove_duplicate_edges(std::vector<bool>& tmp);
-    void sort_edges();
-
     unsigned int color;
-    std::vector<unsigned int> edges;
-    void clear() {
-      edges.clear();
-    }
-    unsigned int nof_edges() const {return edges.size(); }
   };
   std::vector<Vertex> vertices;
+  /* The edges incident to each vertex */
+  EdgeStore edges;
   void sort_edges();
   void remove_duplicate_edges();
 public:
   void clear() {
-    for (std::vector<Vertex>::iterator it = vertices.begin();
-         it < vertices.end();
-         ++it) {
-      it->clear();
-    }
+    edges.clear();
   }
 protected:
   /** \internal
@@ -689,6 +787,31 @@ public:
    */
   static Graph* read_dimacs(FILE* const fp, FILE* const errstr = stderr);
 
+  /**
+   * Create a new graph with \a N vertices, where the vertex v has color
+   * \a colors[v] (or 0 if \a colors is 0) and is adjacent to the vertices
+   * \a targets[\a offsets[v]], ..., \a targets[\a offsets[v + 1] - 1].
+   * Unlike add_edge(), this does not add the reverse of each edge, and so
+   * every edge must be listed at both of its ends.
+   * This is much faster than adding the edges one at a time.
+   */
+  static Graph* from_csr(const unsigned int N,
+                         const unsigned int* const colors,
+                         const unsigned int* const offsets,
+                         const unsigned int* const targets);
+
+  /**
+   * Replace the vertices and edges of the graph by those given by the
+   * arguments, as in from_csr().
+   * The memory already allocated for the graph is reused where possible,
+   * and so this is faster than creating a new graph when many graphs are
+   * processed one after another.
+   */
+  void assign_csr(const unsigned int N,
+                  const unsigned int* const colors,
+                  const unsigned int* const offsets,
+                  const unsigned int* const targets);
+
   /**
    * Write the graph to a file in a variant of the DIMACS format.
    * See the <A href="http://www.tcs.hut.fi/Software/bliss/">bliss website</A>
@@ -815,29 +938,30 @@ protected:
   public:
     Vertex();
     ~Vertex();
-    void add_edge_to(const unsigned int dest_vertex);
-    void add_edge_from(const unsigned int source_vertex);
-    void remove_duplicate_edges(std::vector<bool>& tmp);
-    void sort_edges();
     unsigned int color;
-    std::vector<unsigned int> edges_out;
-    std::vector<unsigned int> edges_in;
-    unsigned int nof_edges_in() const {return edges_in.size(); }
-    unsigned int nof_edges_out() const {return edges_out.size(); }
-    void clear() {
-      edges_out.clear();
-      edges_in.clear();
-    }
   };
   std::vector<Vertex> vertices;
 
+  /* The edges leaving and entering each vertex, with their colors if the
+   * edges are colored. */
+  EdgeStore edges_out;
+  EdgeStore edges_in;
+
+  /* Whether any edge was added with add_edge(source, target, color), if not
+   * then the edge colors are ignored, and the search is exactly as for a
+   * graph without edge colors. */
+  bool has_edge_colors;
+
+  /* Work space used when refining with edge colors, indexed by vertices or
+   * by the first elements of cells, and zero between uses. */
+  std::vector<unsigned int> neighbour_colors;
+  std::vector<std::pair<unsigned int, unsigned int> > colored_neighbours;
+
 public:
   void clear() {
-    for (std::vector<Vertex>::iterator it = vertices.begin();
-         it < vertices.end();
-         ++it) {
-      it->clear();
-    }
+    edges_out.clear();
+    edges_in.clear();
+    has_edge_colors = false;
   }
 protected:
   void remove_duplicate_edges();
@@ -886,6 +1010,28 @@ protected:
   bool split_neighbourhood_of_unit_cell(Partition::Cell* const);
   bool split_neighbourhood_of_cell(Partition::Cell* const);
 
+  /*
+   * The same when the edges are colored: the neighbours of a unit cell are
+   * split according to the colors of the edges joining them to the unit
+   * cell, and the neighbourhood of a cell is split one edge color at a time.
+   */
+  bool split_colored_neighbourhood_of_unit_cell(Partition::Cell* const);
+  bool split_colored_neighbours(Partition::Cell* const unit_cell,
+                                const EdgeStore& edge_store,
+                                const bool out,
+                                const bool was_equal_to_first);
+  bool split_colored_neighbourhood_of_cell(Partition::Cell* const);
+  bool split_colored_neighbourhood_of_cell(Partition::Cell* const cell,
+                                           const bool out,
+                                           const bool was_equal_to_first);
+
+  /* Record that the vertex v has an edge of color \a color to a vertex in
+   * \a cell, when finding the components for component recursion. */
+  void nucr_note_edge_color(Partition::Cell* const cell,
+                            const unsigned int color);
+  /* Returns true if all of the edges from v to \a cell counted since the
+   * last call have the same color, and resets the record. */
+  bool nucr_edge_colors_uniform(Partition::Cell* const cell);
 
   /** \internal
    * \copydoc AbstractGraph::is_equitable() const
@@ -942,6 +1088,32 @@ public:
    */
   static Digraph* read_dimacs(FILE* const fp, FILE* const errstr = stderr);
 
+  /**
+   * Create a new directed graph with \a N vertices, where the vertex v has
+   * color \a colors[v] (or 0 if \a colors is 0), and there are edges from v
+   * to the vertices \a targets[\a offsets[v]], ...,
+   * \a targets[\a offsets[v + 1] - 1]. If \a edge_colors is not 0, then the
+   * edges are colored, and the color of the edge to \a targets[i] is
+   * \a edge_colors[i].
+   * This is much faster than adding the edges one at a time.
+   */
+  static Digraph* from_csr(const unsigned int N,
+                           const unsigned int* const colors,
+                           const unsigned int* const offsets,
+                           const unsigned int* const targets,
+                           const unsigned int* const edge_colors);
+
+  /**
+   * Replace the vertices and edges of the directed graph by those given by
+   * the arguments, as in from_csr(), reusing the memory already allocated
+   * for the graph where possible.
+   */
+  void assign_csr(const unsigned int N,
+                  const unsigned int* const colors,
+                  const unsigned int* const offsets,
+                  const unsigned int* const targets,
+                  const unsigned int* const edge_colors);
+
   /**
    * \copydoc AbstractGraph::write_dimacs(FILE * const fp)
    */
@@ -988,6 +1160,17 @@ public:
    */
   void add_edge(const unsigned int source, const unsigned int target);
 
+  /**
+   * Add an edge with color \a color from the vertex \a source to the vertex
+   * \a target. Once this has been called, the edge colors are taken into
+   * account by the automorphism and canonical labeling algorithms, and edges
+   * added with add_edge(source, target) have color 0. If duplicate edges are
+   * added, then the color of the first one is used.
+   */
+  void add_edge(const unsigned int source,
+                const unsigned int target,
+                const unsigned int color);
+
   /**
    * Change the color of the vertex 'vertex' to 'color'.
    */
@@ -59,6 +59,7 @@ DeclareAttribute("DigraphAbsorptionProbabilities", IsDigraph);
 DeclareAttribute("DigraphAbsorptionExpectedSteps", IsDigraph);
 
 DeclareAttribute("DigraphAllSimpleCircuits", IsDigraph);
+DeclareGlobalFunction("SimpleCircuitsFinder");
 DeclareAttribute("DigraphLongestSimpleCircuit", IsDigraph);
 DeclareAttribute("DigraphAllUndirectedSimpleCircuits", IsDigraph);
 DeclareAttribute("DigraphAllChordlessCycles", IsDigraph);
@@ -79,6 +80,7 @@ DeclareAttribute("NrSpanningTrees", IsDigraph);
 DeclareAttribute("AsGraph", IsDigraph, "mutable");
 DeclareAttribute("AsTransformation", IsDigraph);
 DeclareAttribute("DIGRAPHS_ConnectivityData", IsDigraph, "mutable");
+DeclareAttribute("DIGRAPHS_RepresentativeDistances", IsDigraph);
 
 # Things that are attributes for immutable digraphs, but operations for mutable.
 
@@ -128,6 +130,7 @@ DeclareAttribute("DigraphMaximalMatching", IsDigraph);
 DeclareAttribute("DigraphMaximumMatching", IsDigraph);
 
 DeclareAttribute("Bridges", IsDigraph);
+DeclareAttribute("BiconnectedComponents", IsDigraph);
 DeclareAttributeThatReturnsDigraph("StrongOrientation", IsDigraph);
 
 DeclareAttribute("NonUpperSemimodularPair", IsDigraph);
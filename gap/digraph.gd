@@ -25,6 +25,9 @@ BindGlobal("DigraphFamily", NewFamily("DigraphFamily", IsDigraph));
 DeclareRepresentation("IsDigraphByOutNeighboursRep",
                       IsDigraph and IsComponentObjectRep,
                       ["OutNeighbours"]);
+DeclareRepresentation("IsDigraphByPersistentOutNeighboursRep",
+                      IsDigraphByOutNeighboursRep,
+                      ["PersistentOutNeighbours"]);
 
 # 2.  Digraph no-check constructors . . .
 DeclareOperation("ConvertToMutableDigraphNC", [IsRecord]);
@@ -152,3 +155,21 @@ DeclareOperation("RandomLattice", [IsFunction, IsPosInt]);
 # in the not-too-distant future!
 DeclareOperation("RandomMultiDigraph", [IsPosInt]);
 DeclareOperation("RandomMultiDigraph", [IsPosInt, IsPosInt]);
+
+# 11. Tracked mutable digraphs . . .
+DeclareFilter("IsTrackedDigraph");
+DeclareOperation("DigraphEnableTracking", [IsDigraph]);
+DeclareOperation("DigraphDisableTracking", [IsDigraph]);
+
+DeclareGlobalFunction("DIGRAPHS_TrackingReset");
+DeclareGlobalFunction("DIGRAPHS_TrackingAddVertex");
+DeclareGlobalFunction("DIGRAPHS_TrackingAddEdge");
+DeclareGlobalFunction("DIGRAPHS_TrackingRemoveEdge");
+
+# 12. Persistent immutable digraphs . . .
+DeclareGlobalFunction("DIGRAPHS_PersistentVector");
+DeclareGlobalFunction("DIGRAPHS_PersistentElm");
+DeclareGlobalFunction("DIGRAPHS_PersistentAssign");
+DeclareGlobalFunction("DIGRAPHS_PersistentList");
+DeclareGlobalFunction("DIGRAPHS_PersistentDigraph");
+DeclareGlobalFunction("DIGRAPHS_ExpandPersistentOutNeighbours");
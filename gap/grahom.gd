@@ -42,7 +42,8 @@ DeclareOperation("DigraphGreedyColouring", [IsDigraph, IsHomogeneousList]);
 DeclareOperation("DigraphGreedyColouringNC", [IsDigraph, IsHomogeneousList]);
 
 DeclareAttribute("DigraphWelshPowellOrder", IsDigraph);
-DeclareAttribute("DigraphSmallestLastOrder", IsDigraph);  # TODO: document
+DeclareAttribute("DigraphSmallestLastOrder", IsDigraph);
+DeclareAttribute("DigraphDSATURColouring", IsDigraph);
 
 DeclareOperation("IsDigraphEndomorphism", [IsDigraph, IsTransformation]);
 DeclareOperation("IsDigraphHomomorphism",
@@ -40,6 +40,10 @@ DeclareOperation("BlissCanonicalDigraph", [IsDigraph, IsHomogeneousList]);
 DeclareAttributeThatReturnsDigraph("NautyCanonicalDigraph", IsDigraph);
 DeclareOperation("NautyCanonicalDigraph", [IsDigraph, IsHomogeneousList]);
 
+DeclareAttribute("DigraphIsomorphismInvariant", IsDigraph);
+DeclareOperation("DigraphIsomorphismInvariant",
+                 [IsDigraph, IsHomogeneousList]);
+
 DeclareOperation("IsIsomorphicDigraph", [IsDigraph, IsDigraph]);
 DeclareOperation("IsIsomorphicDigraph",
                  [IsDigraph, IsDigraph, IsHomogeneousList, IsHomogeneousList]);
@@ -56,6 +60,11 @@ DeclareGlobalFunction("DIGRAPHS_ValidateVertexColouring");
 DeclareGlobalFunction("DIGRAPHS_ValidateEdgeColouring");
 DeclareGlobalFunction("DIGRAPHS_CollapseMultiColouredEdges");
 DeclareGlobalFunction("DIGRAPHS_CollapseMultipleEdges");
+DeclareGlobalFunction("DIGRAPHS_IsomorphismInvariantsAgree");
+
+DeclareGlobalFunction("GenerateDigraphs");
+DeclareGlobalFunction("WriteGeneratedDigraphs");
+DeclareGlobalFunction("DIGRAPHS_GenerateOptions");
 
 DeclareOperation("IsDigraphAutomorphism",
                  [IsDigraph, IsPerm]);
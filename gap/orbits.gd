@@ -11,8 +11,13 @@
 DeclareGlobalFunction("DIGRAPHS_Orbits");
 DeclareGlobalFunction("DIGRAPHS_TraceSchreierVector");
 DeclareGlobalFunction("DIGRAPHS_EvaluateWord");
+DeclareGlobalFunction("DIGRAPHS_Stabilizer");
 DeclareAttribute("DIGRAPHS_Stabilizers", IsDigraph, "mutable");
 DeclareGlobalFunction("DIGRAPHS_AddOrbitToHashMap");
+DeclareGlobalFunction("DIGRAPHS_ExpandRepresentativeOutNeighbours");
+DeclareGlobalFunction("DIGRAPHS_ExpandOutNeighbours");
+DeclareGlobalFunction("DIGRAPHS_SymmetryCompressedDigraph");
+DeclareGlobalFunction("DIGRAPHS_IsSymmetryCompressed");
 
 DeclareAttribute("DigraphGroup", IsDigraph);
 DeclareAttribute("DigraphOrbits", IsDigraph);
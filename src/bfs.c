@@ -0,0 +1,614 @@
+/********************************************************************************
+**
+*A  bfs.c                  breadth-first search
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "bfs.h"
+
+// C headers
+#include <limits.h>   // for CHAR_BIT
+#include <stdbool.h>  // for false, true, bool
+#include <stdlib.h>   // for free, qsort
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt, NEW_PLIST, . . .
+
+// Digraphs headers
+#include "csr.h"             // for CSR, new_csr_in_neighbours, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "digraphs.h"        // for DigraphNrVertices, FuncOutNeighbours
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+// A layer is found bottom-up if the number of edges leaving it is more than
+// 1 / ALPHA of the number of edges not yet scanned, and top-down again once it
+// contains fewer than 1 / BETA of the vertices.
+#define ALPHA 14
+#define BETA 24
+
+// The per vertex data shared by all searches. A vertex <v> has been
+// discovered if and only if SEEN[v] equals the timestamp <visited> of the
+// search, in which case DIST[v] is its distance from the sources; and
+// similarly for the other arrays.
+static UInt* SEEN     = NULL;
+static UInt* DIST     = NULL;
+static UInt* MARK     = NULL;  // the current layer in a bottom-up step
+static UInt* WANTED   = NULL;
+static UInt  CAPACITY = 0;
+static UInt  CLOCK    = 0;
+
+static void ensure_capacity(UInt const n) {
+  if (n <= CAPACITY) {
+    return;
+  }
+  free(SEEN);
+  free(DIST);
+  free(MARK);
+  free(WANTED);
+  SEEN     = safe_calloc(n, sizeof(UInt));
+  DIST     = safe_malloc(n * sizeof(UInt));
+  MARK     = safe_calloc(n, sizeof(UInt));
+  WANTED   = safe_calloc(n, sizeof(UInt));
+  CAPACITY = n;
+}
+
+Obj FuncDIGRAPHS_FREE_BFS_DATA(Obj self) {
+  free(SEEN);
+  free(DIST);
+  free(MARK);
+  free(WANTED);
+  SEEN     = NULL;
+  DIST     = NULL;
+  MARK     = NULL;
+  WANTED   = NULL;
+  CAPACITY = 0;
+  CLOCK    = 0;
+  return 0L;
+}
+
+static UInt new_timestamp(void) {
+  if (++CLOCK == 0) {
+    for (UInt v = 0; v < CAPACITY; v++) {
+      SEEN[v]   = 0;
+      MARK[v]   = 0;
+      WANTED[v] = 0;
+    }
+    CLOCK = 1;
+  }
+  return CLOCK;
+}
+
+static int cmp_uint(void const* a, void const* b) {
+  UInt const x = *(UInt const*) a;
+  UInt const y = *(UInt const*) b;
+  return (x > y) - (x < y);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The engine
+////////////////////////////////////////////////////////////////////////////////
+
+void init_bfs(BFS* const bfs, Obj D) {
+  bfs->D            = D;
+  bfs->out          = FuncOutNeighbours(0L, D);
+  bfs->n            = DigraphNrVertices(D);
+  bfs->has_nr_edges = false;
+  bfs->in           = NULL;
+  bfs->frontier     = safe_malloc((bfs->n + 1) * sizeof(UInt));
+  bfs->next         = safe_malloc((bfs->n + 1) * sizeof(UInt));
+  bfs->nr_frontier  = 0;
+  ensure_capacity(bfs->n);
+}
+
+void free_bfs(BFS* const bfs) {
+  if (bfs->in != NULL) {
+    free_csr(bfs->in);
+  }
+  free(bfs->frontier);
+  free(bfs->next);
+}
+
+void bfs_start(BFS* const        bfs,
+               UInt const* const sources,
+               UInt const        nr,
+               bool const        discover) {
+  bfs->visited     = new_timestamp();
+  bfs->wanted      = new_timestamp();
+  bfs->nr_to_find  = 0;
+  bfs->depth       = 0;
+  bfs->scanned     = 0;
+  bfs->bottom_up   = false;
+  bfs->nr_frontier = 0;
+  // MARK is used to remove duplicates from <sources>
+  UInt const mark = new_timestamp();
+  for (UInt i = 0; i < nr; i++) {
+    UInt const v = sources[i];
+    DIGRAPHS_ASSERT(v < bfs->n);
+    if (MARK[v] != mark) {
+      MARK[v]                           = mark;
+      bfs->frontier[bfs->nr_frontier++] = v;
+      if (discover) {
+        SEEN[v] = bfs->visited;
+        DIST[v] = 0;
+      }
+    }
+  }
+}
+
+void bfs_want(BFS* const bfs, UInt const v) {
+  DIGRAPHS_ASSERT(v < bfs->n);
+  if (SEEN[v] != bfs->visited && WANTED[v] != bfs->wanted) {
+    WANTED[v] = bfs->wanted;
+    bfs->nr_to_find++;
+  }
+}
+
+bool bfs_discovered(BFS const* const bfs, UInt const v) {
+  DIGRAPHS_ASSERT(v < bfs->n);
+  return SEEN[v] == bfs->visited;
+}
+
+UInt bfs_distance(BFS const* const bfs, UInt const v) {
+  DIGRAPHS_ASSERT(bfs_discovered(bfs, v));
+  return DIST[v];
+}
+
+// Discover the vertex <v> in the next layer, and return true if this was the
+// last vertex that had to be found.
+static inline bool discover(BFS* const bfs, UInt const v, UInt* const nr) {
+  SEEN[v]            = bfs->visited;
+  DIST[v]            = bfs->depth + 1;
+  bfs->next[(*nr)++] = v;
+  if (WANTED[v] == bfs->wanted) {
+    WANTED[v] = 0;
+    return --bfs->nr_to_find == 0;
+  }
+  return false;
+}
+
+static UInt nr_edges(BFS* const bfs) {
+  if (!bfs->has_nr_edges) {
+    bfs->nr_edges = 0;
+    for (UInt v = 1; v <= bfs->n; v++) {
+      bfs->nr_edges += LEN_LIST(ELM_PLIST(bfs->out, v));
+    }
+    bfs->has_nr_edges = true;
+  }
+  return bfs->nr_edges;
+}
+
+static bool top_down_step(BFS* const bfs, UInt* const nr) {
+  for (UInt i = 0; i < bfs->nr_frontier; i++) {
+    Obj const  nbs = ELM_PLIST(bfs->out, bfs->frontier[i] + 1);
+    UInt const len = LEN_LIST(nbs);
+    bfs->scanned += len;
+    for (UInt j = 1; j <= len; j++) {
+      UInt const w = INT_INTOBJ(ELM_PLIST(nbs, j)) - 1;
+      if (SEEN[w] != bfs->visited && discover(bfs, w, nr)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static bool bottom_up_step(BFS* const bfs, UInt* const nr) {
+  if (bfs->in == NULL) {
+    bfs->in = new_csr_in_neighbours(bfs->D);
+  }
+  CSR const* const in   = bfs->in;
+  UInt const       mark = new_timestamp();
+  for (UInt i = 0; i < bfs->nr_frontier; i++) {
+    MARK[bfs->frontier[i]] = mark;
+  }
+  for (UInt v = 0; v < bfs->n; v++) {
+    if (SEEN[v] == bfs->visited) {
+      continue;
+    }
+    for (UInt e = in->offsets[v]; e < in->offsets[v + 1]; e++) {
+      if (MARK[in->targets[e]] == mark) {
+        if (discover(bfs, v, nr)) {
+          return true;
+        }
+        break;
+      }
+    }
+  }
+  return false;
+}
+
+bool bfs_step(BFS* const bfs) {
+  if (bfs->nr_frontier == 0) {
+    return false;
+  }
+  // Choose the direction of the step
+  if (!bfs->bottom_up) {
+    UInt out_edges = 0;
+    for (UInt i = 0; i < bfs->nr_frontier; i++) {
+      out_edges += LEN_LIST(ELM_PLIST(bfs->out, bfs->frontier[i] + 1));
+    }
+    // The number of edges is only computed if the layer has many edges
+    if (out_edges * ALPHA > bfs->n) {
+      UInt const m = nr_edges(bfs);
+      if (out_edges * ALPHA > (m > bfs->scanned ? m - bfs->scanned : 0)) {
+        bfs->bottom_up = true;
+      }
+    }
+  } else if (bfs->nr_frontier * BETA < bfs->n) {
+    bfs->bottom_up = false;
+  }
+
+  UInt       nr   = 0;
+  bool const done = (bfs->bottom_up ? bottom_up_step(bfs, &nr)
+                                    : top_down_step(bfs, &nr));
+
+  UInt* const tmp  = bfs->frontier;
+  bfs->frontier    = bfs->next;
+  bfs->next        = tmp;
+  bfs->nr_frontier = nr;
+  bfs->depth++;
+  return !done && nr > 0;
+}
+
+void bfs_sort_layer(BFS* const bfs) {
+  // Layers found bottom-up are already sorted
+  if (!bfs->bottom_up) {
+    qsort(bfs->frontier, bfs->nr_frontier, sizeof(UInt), cmp_uint);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GAP level functions
+////////////////////////////////////////////////////////////////////////////////
+
+// Returns an array containing the vertices in the list <list> of vertices,
+// indexed from 0, and writes its length into <nr>.
+static UInt* vertices_from_list(Obj list, UInt* const nr) {
+  *nr          = LEN_LIST(list);
+  UInt* result = safe_malloc((*nr + 1) * sizeof(UInt));
+  for (UInt i = 0; i < *nr; i++) {
+    result[i] = INT_INTOBJ(ELM_LIST(list, i + 1)) - 1;
+  }
+  return result;
+}
+
+static Obj layer_to_plist(BFS const* const bfs) {
+  UInt const nr  = bfs->nr_frontier;
+  Obj        lay = NEW_PLIST(nr == 0 ? T_PLIST_EMPTY : T_PLIST_CYC_SSORT, nr);
+  SET_LEN_PLIST(lay, nr);
+  for (UInt i = 0; i < nr; i++) {
+    SET_ELM_PLIST(lay, i + 1, INTOBJ_INT(bfs->frontier[i] + 1));
+  }
+  return lay;
+}
+
+// The argument <sources> must be a non-empty list of vertices of <D>, and
+// <depth> an integer. Returns the list of layers of a breadth-first search in
+// <D> from <sources>, i.e. the <i>th entry is the set of vertices at distance
+// i - 1 from <sources>. Only the layers at distance at most <depth> are
+// returned, unless <depth> is negative, in which case all of them are.
+Obj FuncDIGRAPH_BFS_LAYERS(Obj self, Obj D, Obj sources, Obj depth) {
+  DIGRAPHS_ASSERT(IS_INTOBJ(depth));
+  Int const max = INT_INTOBJ(depth);
+  BFS       bfs;
+  init_bfs(&bfs, D);
+  UInt  nr;
+  UInt* src = vertices_from_list(sources, &nr);
+  bfs_start(&bfs, src, nr, true);
+  free(src);
+
+  Obj layers = NEW_PLIST(T_PLIST, 1);
+  bfs_sort_layer(&bfs);
+  PushPlist(layers, layer_to_plist(&bfs));
+  while ((max < 0 || (Int) bfs.depth < max) && bfs_step(&bfs)) {
+    bfs_sort_layer(&bfs);
+    PushPlist(layers, layer_to_plist(&bfs));
+  }
+  free_bfs(&bfs);
+  return layers;
+}
+
+// The argument <sources> must be a list of vertices of <D>. Returns the set
+// of vertices of <D> which are reachable from a vertex in <sources> along a
+// path of length at least 1.
+Obj FuncDIGRAPH_BFS_REACHABLE(Obj self, Obj D, Obj sources) {
+  BFS bfs;
+  init_bfs(&bfs, D);
+  UInt  nr;
+  UInt* src = vertices_from_list(sources, &nr);
+  bfs_start(&bfs, src, nr, false);
+  free(src);
+
+  // Every vertex is discovered at most once, and so <reached> has length at
+  // most n.
+  UInt* reached = safe_malloc((bfs.n + 1) * sizeof(UInt));
+  nr            = 0;
+  while (bfs_step(&bfs)) {
+    for (UInt i = 0; i < bfs.nr_frontier; i++) {
+      reached[nr++] = bfs.frontier[i];
+    }
+  }
+  qsort(reached, nr, sizeof(UInt), cmp_uint);
+
+  Obj result = NEW_PLIST(nr == 0 ? T_PLIST_EMPTY : T_PLIST_CYC_SSORT, nr);
+  SET_LEN_PLIST(result, nr);
+  for (UInt i = 0; i < nr; i++) {
+    SET_ELM_PLIST(result, i + 1, INTOBJ_INT(reached[i] + 1));
+  }
+  free(reached);
+  free_bfs(&bfs);
+  return result;
+}
+
+// The arguments <sources> and <targets> must be lists of vertices of <D>.
+// Returns the length of a shortest path from a vertex in <sources> to a
+// vertex in <targets>, or fail if there is no such path.
+Obj FuncDIGRAPH_BFS_SHORTEST_DISTANCE(Obj self,
+                                      Obj D,
+                                      Obj sources,
+                                      Obj targets) {
+  BFS bfs;
+  init_bfs(&bfs, D);
+  UInt  nr;
+  UInt* src = vertices_from_list(sources, &nr);
+  bfs_start(&bfs, src, nr, true);
+  free(src);
+
+  Obj   result = Fail;
+  UInt  nr_targets;
+  UInt* trg = vertices_from_list(targets, &nr_targets);
+  for (UInt i = 0; i < nr_targets; i++) {
+    if (bfs_discovered(&bfs, trg[i])) {
+      result = INTOBJ_INT(0);
+      break;
+    }
+    bfs_want(&bfs, trg[i]);
+  }
+  if (result == Fail && bfs.nr_to_find > 0) {
+    // Stop as soon as any target is discovered
+    bfs.nr_to_find = 1;
+    while (bfs_step(&bfs)) {
+    }
+    if (bfs.nr_to_find == 0) {
+      result = INTOBJ_INT(bfs.depth);
+    }
+  }
+  free(trg);
+  free_bfs(&bfs);
+  return result;
+}
+
+// Returns true if <pair> is a list of length 2 consisting of vertices of a
+// digraph with <n> vertices.
+static bool is_pair_of_vertices(Obj pair, UInt const n) {
+  if (!IS_LIST(pair) || LEN_LIST(pair) != 2) {
+    return false;
+  }
+  for (UInt i = 1; i <= 2; i++) {
+    Obj const v = ELM_LIST(pair, i);
+    if (!IS_INTOBJ(v) || INT_INTOBJ(v) < 1 || INT_INTOBJ(v) > (Int) n) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The argument <pairs> must be a list, and <reachability> true or false.
+// Returns fail if <pairs> is not a list of pairs of vertices of <D>.
+// Otherwise, if <reachability> is false, returns the list whose <i>th entry is
+// the length of a shortest path from pairs[i][1] to pairs[i][2], or fail if
+// there is no such path; and if <reachability> is true, returns the list whose
+// <i>th entry is true if there is a path of length at least 1 from pairs[i][1]
+// to pairs[i][2], and false if not. The pairs are grouped by their first
+// entry, and a single search is performed for each group, which stops when
+// every target in the group has been found.
+Obj FuncDIGRAPH_BFS_PAIRS(Obj self, Obj D, Obj pairs, Obj reachability) {
+  DIGRAPHS_ASSERT(reachability == True || reachability == False);
+  UInt const n = DigraphNrVertices(D);
+  if (!IS_LIST(pairs)) {
+    return Fail;
+  }
+  UInt const nr = LEN_LIST(pairs);
+  for (UInt i = 1; i <= nr; i++) {
+    if (!is_pair_of_vertices(ELM_LIST(pairs, i), n)) {
+      return Fail;
+    }
+  }
+
+  // The pairs with first entry <u> are order[offsets[u]], ...,
+  // order[offsets[u + 1] - 1], indexed from 0.
+  UInt* src     = safe_malloc((nr + 1) * sizeof(UInt));
+  UInt* trg     = safe_malloc((nr + 1) * sizeof(UInt));
+  UInt* offsets = safe_calloc(n + 2, sizeof(UInt));
+  UInt* order   = safe_malloc((nr + 1) * sizeof(UInt));
+  for (UInt i = 0; i < nr; i++) {
+    Obj const pair = ELM_LIST(pairs, i + 1);
+    src[i]         = INT_INTOBJ(ELM_LIST(pair, 1)) - 1;
+    trg[i]         = INT_INTOBJ(ELM_LIST(pair, 2)) - 1;
+    offsets[src[i] + 1]++;
+  }
+  for (UInt u = 0; u < n; u++) {
+    offsets[u + 1] += offsets[u];
+  }
+  UInt* fill = safe_malloc((n + 1) * sizeof(UInt));
+  for (UInt u = 0; u < n; u++) {
+    fill[u] = offsets[u];
+  }
+  for (UInt i = 0; i < nr; i++) {
+    order[fill[src[i]]++] = i;
+  }
+  free(fill);
+
+  bool const reach  = (reachability == True);
+  Obj        result = NEW_PLIST(nr == 0 ? T_PLIST_EMPTY : T_PLIST, nr);
+  SET_LEN_PLIST(result, nr);
+  BFS bfs;
+  init_bfs(&bfs, D);
+  for (UInt u = 0; u < n; u++) {
+    if (offsets[u] == offsets[u + 1]) {
+      continue;
+    }
+    bfs_start(&bfs, &u, 1, !reach);
+    for (UInt k = offsets[u]; k < offsets[u + 1]; k++) {
+      bfs_want(&bfs, trg[order[k]]);
+    }
+    while (bfs.nr_to_find > 0 && bfs_step(&bfs)) {
+    }
+    for (UInt k = offsets[u]; k < offsets[u + 1]; k++) {
+      UInt const i = order[k];
+      UInt const v = trg[i];
+      Obj        val;
+      if (reach) {
+        val = (bfs_discovered(&bfs, v) ? True : False);
+      } else {
+        val = (bfs_discovered(&bfs, v) ? INTOBJ_INT(bfs_distance(&bfs, v))
+                                       : Fail);
+      }
+      SET_ELM_PLIST(result, i + 1, val);
+    }
+  }
+  free_bfs(&bfs);
+  free(src);
+  free(trg);
+  free(offsets);
+  free(order);
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Bit-parallel searches from many sources
+////////////////////////////////////////////////////////////////////////////////
+
+// The number of searches performed simultaneously, one per bit of a UInt.
+#define NR_BITS_PER_UINT (sizeof(UInt) * CHAR_BIT)
+
+// Returns the position of the least significant bit which is set in <x>, which
+// must be non-zero.
+static inline UInt lowest_bit(UInt x) {
+  DIGRAPHS_ASSERT(x != 0);
+#if defined(__GNUC__)
+  return __builtin_ctzll((unsigned long long) x);
+#else
+  UInt i = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    i++;
+  }
+  return i;
+#endif
+}
+
+// The argument <sources> must be a list of vertices of <D>. Returns the list
+// whose <i>th entry is the list of distances from sources[i] to every vertex
+// of <D>, with fail for those vertices which are not reachable.
+//
+// Up to NR_BITS_PER_UINT searches are performed at once, in the manner of:
+//
+//   M. Then, M. Kaufmann, F. Chirigati, T.-A. Hoang-Vu, K. Pham, A. Kemper,
+//   T. Neumann, and H. T. Vo, The more the merrier: efficient multi-source
+//   graph traversal, PVLDB 8(4), 2014.
+//
+// i.e. the <k>th bit of SEEN[v] is set if and only if <v> has been discovered
+// in the <k>th search of the current batch, and similarly for the current and
+// next layers. Every edge is then scanned at most once per layer for the
+// whole batch, rather than once for each search.
+Obj FuncDIGRAPH_BFS_DISTANCE_ROWS(Obj self, Obj D, Obj sources) {
+  UInt const n = DigraphNrVertices(D);
+  UInt       nr;
+  UInt*      src = vertices_from_list(sources, &nr);
+
+  // The rows are created before the search, since NEW_PLIST can trigger a
+  // garbage collection, and filled in using immediate integers only.
+  Obj result = NEW_PLIST(nr == 0 ? T_PLIST_EMPTY : T_PLIST_TAB, nr);
+  SET_LEN_PLIST(result, nr);
+  for (UInt i = 0; i < nr; i++) {
+    Obj row = NEW_PLIST(n == 0 ? T_PLIST_EMPTY : T_PLIST, n);
+    SET_LEN_PLIST(row, n);
+    for (UInt v = 1; v <= n; v++) {
+      SET_ELM_PLIST(row, v, Fail);
+    }
+    SET_ELM_PLIST(result, i + 1, row);
+    CHANGED_BAG(result);
+  }
+  if (nr == 0 || n == 0) {
+    free(src);
+    return result;
+  }
+
+  CSR* const  out  = new_csr_out_neighbours(D);
+  UInt* const seen = safe_malloc(n * sizeof(UInt));
+  UInt* const here = safe_calloc(n, sizeof(UInt));
+  UInt* const next = safe_calloc(n, sizeof(UInt));
+  // The vertices <v> with here[v] != 0, and those with next[v] != 0, so that
+  // each layer only costs time proportional to the edges leaving it.
+  UInt* layer    = safe_malloc(n * sizeof(UInt));
+  UInt* frontier = safe_malloc(n * sizeof(UInt));
+  Obj   rows[NR_BITS_PER_UINT];
+
+  for (UInt first = 0; first < nr; first += NR_BITS_PER_UINT) {
+    UInt const batch = (nr - first < NR_BITS_PER_UINT ? nr - first
+                                                      : NR_BITS_PER_UINT);
+    UInt nr_layer = 0;
+    for (UInt v = 0; v < n; v++) {
+      seen[v] = 0;
+    }
+    for (UInt k = 0; k < batch; k++) {
+      UInt const s = src[first + k];
+      DIGRAPHS_ASSERT(s < n);
+      rows[k] = ELM_PLIST(result, first + k + 1);
+      if (here[s] == 0) {
+        layer[nr_layer++] = s;
+      }
+      seen[s] |= (UInt) 1 << k;
+      here[s] |= (UInt) 1 << k;
+      SET_ELM_PLIST(rows[k], s + 1, INTOBJ_INT(0));
+    }
+
+    for (UInt depth = 1; nr_layer > 0; depth++) {
+      UInt nr_frontier = 0;
+      for (UInt i = 0; i < nr_layer; i++) {
+        UInt const v    = layer[i];
+        UInt const bits = here[v];
+        here[v]         = 0;
+        for (UInt e = out->offsets[v]; e < out->offsets[v + 1]; e++) {
+          UInt const w     = out->targets[e];
+          UInt       fresh = bits & ~seen[w];
+          if (fresh == 0) {
+            continue;
+          }
+          if (next[w] == 0) {
+            frontier[nr_frontier++] = w;
+          }
+          seen[w] |= fresh;
+          next[w] |= fresh;
+          do {
+            SET_ELM_PLIST(rows[lowest_bit(fresh)], w + 1, INTOBJ_INT(depth));
+            fresh &= fresh - 1;
+          } while (fresh != 0);
+        }
+      }
+      for (UInt i = 0; i < nr_frontier; i++) {
+        UInt const w = frontier[i];
+        here[w]      = next[w];
+        next[w]      = 0;
+      }
+      UInt* const tmp = layer;
+      layer           = frontier;
+      frontier        = tmp;
+      nr_layer        = nr_frontier;
+    }
+  }
+
+  free_csr(out);
+  free(seen);
+  free(here);
+  free(next);
+  free(layer);
+  free(frontier);
+  free(src);
+  return result;
+}
@@ -0,0 +1,108 @@
+/********************************************************************************
+**
+*A  bfs.h                  breadth-first search
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_BFS_H_
+#define DIGRAPHS_SRC_BFS_H_
+
+// C headers
+#include <stdbool.h>  // for bool
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt
+
+// Digraphs headers
+#include "csr.h"  // for CSR
+
+// This file contains a breadth-first search engine, which starts from a set
+// of source vertices, and discovers the vertices of the digraph one layer at
+// a time. Each layer is either found top-down, from the out-neighbours of the
+// vertices in the current layer, or bottom-up, by checking whether any
+// in-neighbour of every undiscovered vertex is in the current layer; the
+// direction is chosen according to the number of edges leaving the current
+// layer, as in:
+//
+//   S. Beamer, K. Asanovic, and D. Patterson, Direction-optimizing
+//   breadth-first search, SC '12.
+//
+// The in-neighbours are only computed if a layer is ever found bottom-up, and
+// are then retained, so that a single BFS can be used for many searches in
+// the same digraph. The per vertex data is stored in arrays which are shared
+// by all searches, and which are reset in constant time by changing the
+// timestamp with which they are compared, and so only one search can be in
+// progress at any time. The vertices are indexed from 0.
+
+struct bfs_struct {
+  Obj   D;
+  Obj   out;        // the out-neighbours of D
+  UInt  n;          // the number of vertices of D
+  UInt  nr_edges;   // the number of edges of D, if known
+  bool  has_nr_edges;
+  CSR*  in;         // the in-neighbours of D, or NULL
+  UInt* frontier;   // the current layer
+  UInt  nr_frontier;
+  UInt* next;       // the next layer
+  UInt  depth;      // the distance of the current layer from the sources
+  UInt  scanned;    // the number of edges scanned top-down
+  bool  bottom_up;  // the direction in which the current layer was found
+  UInt  visited;    // timestamp of the discovered vertices
+  UInt  wanted;     // timestamp of the wanted vertices
+  // The search stops as soon as this many more wanted vertices are discovered
+  UInt nr_to_find;
+};
+
+typedef struct bfs_struct BFS;
+
+//! Initialise \p bfs for searching in the digraph \p D.
+void init_bfs(BFS* const bfs, Obj D);
+
+//! Free the memory used by \p bfs.
+void free_bfs(BFS* const bfs);
+
+//! Start a new search in \p bfs, with first layer consisting of the \p nr
+//! vertices in \p sources, with any duplicates removed. If \p discover is
+//! \c true, then the sources are discovered at distance 0. Otherwise, the
+//! sources are only discovered if they are reachable from a source along a
+//! path of length at least 1.
+void bfs_start(BFS* const        bfs,
+               UInt const* const sources,
+               UInt const        nr,
+               bool const        discover);
+
+//! Mark the vertex \p v as wanted in the current search, so that the search
+//! stops once every wanted vertex has been discovered. Has no effect if \p v
+//! has already been discovered.
+void bfs_want(BFS* const bfs, UInt const v);
+
+//! Replace the current layer of \p bfs by the next layer. Returns \c false if
+//! the search is finished, either because the next layer is empty, or because
+//! all of the wanted vertices have been discovered.
+bool bfs_step(BFS* const bfs);
+
+//! Sort the vertices in the current layer of \p bfs.
+void bfs_sort_layer(BFS* const bfs);
+
+//! Returns \c true if the vertex \p v has been discovered in the current
+//! search.
+bool bfs_discovered(BFS const* const bfs, UInt const v);
+
+//! Returns the distance of the discovered vertex \p v from the sources.
+UInt bfs_distance(BFS const* const bfs, UInt const v);
+
+Obj FuncDIGRAPHS_FREE_BFS_DATA(Obj self);
+Obj FuncDIGRAPH_BFS_LAYERS(Obj self, Obj D, Obj sources, Obj depth);
+Obj FuncDIGRAPH_BFS_REACHABLE(Obj self, Obj D, Obj sources);
+Obj FuncDIGRAPH_BFS_SHORTEST_DISTANCE(Obj self,
+                                      Obj D,
+                                      Obj sources,
+                                      Obj targets);
+Obj FuncDIGRAPH_BFS_PAIRS(Obj self, Obj D, Obj pairs, Obj reachability);
+Obj FuncDIGRAPH_BFS_DISTANCE_ROWS(Obj self, Obj D, Obj sources);
+
+#endif  // DIGRAPHS_SRC_BFS_H_
@@ -0,0 +1,246 @@
+/********************************************************************************
+**
+*A  biconnected.c          articulation points, bridges, and blocks
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "biconnected.h"
+
+// C headers
+#include <stdbool.h>  // for false, true, bool
+#include <stdlib.h>   // for free, qsort
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt, NEW_PLIST, . . .
+
+// Digraphs headers
+#include "csr.h"             // for CSR, new_csr_out_neighbours, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+// This file contains an iterative version of Tarjan's low-link depth first
+// search on the symmetric closure of a digraph, which simultaneously computes:
+//
+// 1. the articulation points;
+// 2. the bridges;
+// 3. the blocks (biconnected components), including the singleton blocks of
+//    isolated vertices; and
+// 4. a strong orientation, which is obtained by orienting every edge of the
+//    DFS tree away from the root, and every other edge from the vertex visited
+//    later to the vertex visited earlier. If the digraph is connected and
+//    bridgeless, then this orientation is strongly connected.
+//
+// The search visits the neighbours of every vertex in the order they appear
+// in the CSR, and starts from the vertices in increasing order, so that the
+// articulation points and bridges are found in the same order as the original
+// GAP level implementation. Loops are ignored, and an edge back to the parent
+// of a vertex in the DFS tree is not used to update its low value (so that a
+// multiple edge can be a bridge). Everything is linear in the number of
+// vertices and edges.
+
+static int cmp_uint(void const* a, void const* b) {
+  UInt const x = *(UInt const*) a;
+  UInt const y = *(UInt const*) b;
+  return (x > y) - (x < y);
+}
+
+// Returns true if the edge [x, y] of the symmetric closure belongs to the
+// strong orientation.
+static inline bool is_oriented(UInt const* const pre,
+                               UInt const* const parent,
+                               UInt const        x,
+                               UInt const        y) {
+  return parent[y] == x || (pre[x] > pre[y] && parent[x] != y);
+}
+
+static Obj strong_orientation(CSR const* const  g,
+                              UInt const* const pre,
+                              UInt const* const parent) {
+  UInt const n     = g->nr_vertices;
+  UInt*      count = safe_calloc((n > 0 ? n : 1), sizeof(UInt));
+  for (UInt v = 0; v < n; v++) {
+    for (UInt e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+      UInt const w = g->targets[e];
+      if (w != v && is_oriented(pre, parent, w, v)) {
+        count[w]++;
+      }
+    }
+  }
+  Obj out = NEW_PLIST(T_PLIST_TAB, n);
+  SET_LEN_PLIST(out, n);
+  for (UInt v = 0; v < n; v++) {
+    SET_ELM_PLIST(out, v + 1, NEW_PLIST(T_PLIST_CYC, count[v]));
+    CHANGED_BAG(out);
+  }
+  free(count);
+  // Visiting the vertices <v> in increasing order means that every list of
+  // out-neighbours is sorted, and that multiple edges are adjacent.
+  for (UInt v = 0; v < n; v++) {
+    for (UInt e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+      UInt const w = g->targets[e];
+      if (w != v && is_oriented(pre, parent, w, v)) {
+        Obj        nbs = ELM_PLIST(out, w + 1);
+        UInt const len = LEN_PLIST(nbs);
+        if (len == 0 || INT_INTOBJ(ELM_PLIST(nbs, len)) != (Int) v + 1) {
+          PushPlist(nbs, INTOBJ_INT(v + 1));
+        }
+      }
+    }
+  }
+  return out;
+}
+
+// The argument <symmetric> must be <true> if and only if the digraph <D> is
+// symmetric. Returns a record with components:
+//
+//   connected           true or false;
+//   articulation_points the articulation points of <D> (if <D> is connected);
+//   bridges             the bridges of <D> (if <D> is connected);
+//   blocks              the vertex sets of the blocks of <D>; and
+//   orientation         the out-neighbours of a strong orientation of <D> (if
+//                       <D> is symmetric, connected, and bridgeless) or fail.
+Obj FuncDIGRAPH_BICONNECTIVITY(Obj self, Obj D, Obj symmetric) {
+  CSR* g = (symmetric == True ? new_csr_out_neighbours(D)
+                              : new_csr_simple_symmetric(D));
+  UInt const n    = g->nr_vertices;
+  UInt const size = (n > 0 ? n : 1) * sizeof(UInt);
+
+  // pre[v] is the position of <v> in the order the vertices are visited,
+  // starting at 1, and 0 indicates that <v> is not yet visited.
+  UInt* pre    = safe_calloc((n > 0 ? n : 1), sizeof(UInt));
+  UInt* low    = safe_malloc(size);
+  UInt* parent = safe_malloc(size);
+  UInt* next   = safe_malloc(size);  // the next edge of <v> to consider
+  UInt* dfs    = safe_malloc(size);  // the DFS stack
+  UInt* stack  = safe_malloc(size);  // the vertices not yet in a block
+  UInt* block  = safe_malloc(size);
+  bool* is_ap  = safe_calloc((n > 0 ? n : 1), sizeof(bool));
+
+  Obj aps     = NEW_PLIST(T_PLIST, 0);
+  Obj bridges = NEW_PLIST(T_PLIST, 0);
+  Obj blocks  = NEW_PLIST(T_PLIST, 0);
+
+  UInt counter = 0, nr_roots = 0;
+
+  for (UInt r = 0; r < n; r++) {
+    if (pre[r] != 0) {
+      continue;
+    }
+    nr_roots++;
+    UInt nr_children = 0, top = 0, nr_stack = 0;
+    pre[r] = low[r]    = ++counter;
+    parent[r]          = r;
+    next[r]            = g->offsets[r];
+    dfs[top++]         = r;
+    stack[nr_stack++]  = r;
+
+    while (top > 0) {
+      UInt const v = dfs[top - 1];
+      if (next[v] < g->offsets[v + 1]) {
+        UInt const w = g->targets[next[v]++];
+        if (w == v) {
+          // loop
+        } else if (pre[w] != 0) {
+          // back edge, or the edge to the parent of <v>
+          if (w != parent[v] && pre[w] < low[v]) {
+            low[v] = pre[w];
+          }
+        } else {
+          // tree edge
+          if (v == r) {
+            nr_children++;
+          }
+          parent[w] = v;
+          pre[w] = low[w]   = ++counter;
+          next[w]           = g->offsets[w];
+          dfs[top++]        = w;
+          stack[nr_stack++] = w;
+        }
+        continue;
+      }
+      // backtracking from <v> to its parent <u>
+      top--;
+      if (v == r) {
+        if (nr_children == 0) {
+          // <r> is an isolated vertex
+          Obj b = NEW_PLIST(T_PLIST_CYC, 1);
+          SET_LEN_PLIST(b, 1);
+          SET_ELM_PLIST(b, 1, INTOBJ_INT(r + 1));
+          PushPlist(blocks, b);
+        } else if (nr_children > 1) {
+          is_ap[r] = true;
+          PushPlist(aps, INTOBJ_INT(r + 1));
+        }
+        nr_stack--;
+        DIGRAPHS_ASSERT(nr_stack == 0);
+        continue;
+      }
+      UInt const u = parent[v];
+      if (low[v] >= pre[u]) {
+        if (u != r && !is_ap[u]) {
+          is_ap[u] = true;
+          PushPlist(aps, INTOBJ_INT(u + 1));
+        }
+        // The vertices above and including <v> on <stack>, together with <u>,
+        // form a block.
+        UInt len     = 0;
+        block[len++] = u;
+        do {
+          block[len++] = stack[--nr_stack];
+        } while (block[len - 1] != v);
+        qsort(block, len, sizeof(UInt), cmp_uint);
+        Obj b = NEW_PLIST(T_PLIST_CYC, len);
+        SET_LEN_PLIST(b, len);
+        for (UInt i = 0; i < len; i++) {
+          SET_ELM_PLIST(b, i + 1, INTOBJ_INT(block[i] + 1));
+        }
+        PushPlist(blocks, b);
+      }
+      if (low[v] == pre[v]) {
+        Obj e = NEW_PLIST(T_PLIST_CYC, 2);
+        SET_LEN_PLIST(e, 2);
+        SET_ELM_PLIST(e, 1, INTOBJ_INT(u + 1));
+        SET_ELM_PLIST(e, 2, INTOBJ_INT(v + 1));
+        PushPlist(bridges, e);
+      }
+      if (low[v] < low[u]) {
+        low[u] = low[v];
+      }
+    }
+  }
+
+  Obj connected   = (nr_roots <= 1 ? True : False);
+  Obj orientation = Fail;
+  if (connected == True) {
+    if (symmetric == True && LEN_PLIST(bridges) == 0) {
+      orientation = strong_orientation(g, pre, parent);
+    }
+  } else {
+    // by convention, a disconnected digraph has no articulation points, or
+    // bridges.
+    aps     = NEW_PLIST(T_PLIST_EMPTY, 0);
+    bridges = NEW_PLIST(T_PLIST_EMPTY, 0);
+  }
+
+  free(pre);
+  free(low);
+  free(parent);
+  free(next);
+  free(dfs);
+  free(stack);
+  free(block);
+  free(is_ap);
+  free_csr(g);
+
+  Obj result = NEW_PREC(5);
+  AssPRec(result, RNamName("connected"), connected);
+  AssPRec(result, RNamName("articulation_points"), aps);
+  AssPRec(result, RNamName("bridges"), bridges);
+  AssPRec(result, RNamName("blocks"), blocks);
+  AssPRec(result, RNamName("orientation"), orientation);
+  return result;
+}
@@ -0,0 +1,19 @@
+/********************************************************************************
+**
+*A  biconnected.h          articulation points, bridges, and blocks
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_BICONNECTED_H_
+#define DIGRAPHS_SRC_BICONNECTED_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_BICONNECTIVITY(Obj self, Obj D, Obj symmetric);
+
+#endif  // DIGRAPHS_SRC_BICONNECTED_H_
@@ -0,0 +1,524 @@
+/********************************************************************************
+**
+*A  circuits.c             simple circuits
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "circuits.h"
+
+// C headers
+#include <stdbool.h>  // for false, true, bool
+#include <stdlib.h>   // for free
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt, NEW_PLIST, . . .
+
+// Digraphs headers
+#include "csr.h"             // for CSR, new_csr_out_neighbours, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+// This file contains Johnson's algorithm for enumerating the simple circuits
+// of a digraph, see:
+//
+//   D. B. Johnson, Finding all the elementary circuits of a directed graph,
+//   SIAM J. Comput. 4 (1975) 77-84.
+//
+// Loops and multiple edges are removed from the digraph first, the loops are
+// reported separately. The strongly connected components are found in the
+// same order as DigraphStronglyConnectedComponents, and the vertices <s> of
+// each component are taken in the order they appear in the component. Johnson's
+// search is then run on the strongly connected component of <s> in the
+// subdigraph induced by <s> and the vertices after <s> in its component, and
+// finds every circuit starting at <s> in this subdigraph. Every vertex is
+// identified by its 0-based index, and the neighbours of every vertex are
+// visited in the order they appear in OutNeighbours, so that the circuits are
+// found in the same order as the original GAP level implementation.
+//
+// If the maximum length of a circuit is bounded, then the search is cut off at
+// that depth, and any vertex where the search was cut off is treated as if a
+// circuit had been found through it (i.e. it is unblocked), since it is not
+// known whether or not there is a path back to <s>.
+//
+// Every circuit found is passed to the GAP level hook function as soon as it
+// is found, and so the memory used does not depend on the number of circuits,
+// and the search can be stopped at any point.
+//
+// If the hook function raises an error, then FuncDIGRAPH_SIMPLE_CIRCUITS does
+// not return, and so cannot free the data for its search. Hence the data for
+// every search in progress is kept in a stack, along with the GAP recursion
+// depth at which it was started. A search started from within the hook of
+// another search has a greater recursion depth, and so any search on the stack
+// whose depth is at least that of a new search was abandoned, and is freed
+// when the new search starts.
+
+struct circuits_struct {
+  CSR*  out;
+  CSR*  in;
+  UInt* comp;     // the vertices of the current strongly connected component
+  UInt* pos;      // pos[v] is the position of <v> in its component
+  UInt* cid;      // cid[v] is the index of the component containing <v>
+  UInt* mark;     // mark[v] == stamp if <v> is reachable from <s>
+  UInt* member;   // member[v] == stamp if <v> is in the SCC of <s>
+  UInt* queue;    // queue for the searches defining <member>
+  bool* blocked;  // Johnson's blocked vertices
+  UInt* B_head;   // B_head[w] is the first node of B[w] in the pool or NONE
+  UInt* B_next;   // the next node in the same B list as a node, or NONE
+  UInt* B_val;    // the vertex stored in a node
+  UInt  B_free;   // the first node in the list of free nodes, or NONE
+  UInt  B_size;   // the number of nodes used so far
+  UInt* path;     // the current path, starting at <s>
+  UInt* next;     // next[v] is the next edge of <v> to consider
+  bool* found;    // found[d] is true if a circuit was found below depth <d>
+
+  // Data for Tarjan's algorithm
+  UInt* pre;    // pre[v] is the position of <v> in the order visited, or 0
+  UInt* low;    // the Tarjan low points
+  UInt* dfs;    // the depth first search stack
+  UInt* stack;  // the stack of visited vertices not yet in a component
+  bool* on;     // on[v] is true if <v> is in <stack>
+  UInt* edge;   // edge[v] is the next edge of <v> to consider
+
+  // Arguments from GAP
+  Obj  hook;
+  Obj  user_param;
+  UInt limit;  // 0 means no limit
+  UInt min;
+  UInt max;  // 0 means no bound
+  UInt count;
+  bool stop;
+
+  // The stack of searches in progress
+  struct circuits_struct* prev;
+  Int                     depth;  // the recursion depth at the start
+};
+
+typedef struct circuits_struct Circuits;
+
+#define NONE ((UInt) -1)
+
+// The top of the stack of searches in progress, or NULL.
+static Circuits* CIRCUITS = NULL;
+
+////////////////////////////////////////////////////////////////////////////////
+// Set up
+////////////////////////////////////////////////////////////////////////////////
+
+// Remove loops and multiple edges from <csr>, keeping the first occurrence of
+// every edge, and sets loops[v] to true if <v> has a loop.
+static void simplify_csr(CSR* const csr, UInt* const mark, bool* const loops) {
+  UInt const n = csr->nr_vertices;
+  UInt       k = 0;
+  for (UInt v = 0; v < n; v++) {
+    mark[v] = NONE;
+  }
+  for (UInt v = 0; v < n; v++) {
+    UInt const start = csr->offsets[v];
+    csr->offsets[v]  = k;
+    loops[v]         = false;
+    for (UInt e = start; e < csr->offsets[v + 1]; e++) {
+      UInt const w = csr->targets[e];
+      if (w == v) {
+        loops[v] = true;
+      } else if (mark[w] != v) {
+        mark[w]            = v;
+        csr->targets[k++] = w;
+      }
+    }
+  }
+  csr->offsets[n] = k;
+  csr->nr_edges   = k;
+}
+
+static Circuits* new_circuits(Obj D) {
+  Circuits* c = safe_malloc(sizeof(Circuits));
+  c->out      = new_csr_out_neighbours(D);
+
+  UInt const n    = c->out->nr_vertices;
+  UInt const size = (n > 0 ? n : 1) * sizeof(UInt);
+  c->comp         = safe_malloc(size);
+  c->pos          = safe_malloc(size);
+  c->cid          = safe_malloc(size);
+  c->mark         = safe_malloc(size);
+  c->member       = safe_malloc(size);
+  c->queue        = safe_malloc(size);
+  c->blocked      = safe_calloc((n > 0 ? n : 1), sizeof(bool));
+  c->B_head       = safe_malloc(size);
+  c->path         = safe_malloc(size);
+  c->next         = safe_malloc(size);
+  c->found        = safe_calloc((n > 0 ? n : 1), sizeof(bool));
+  c->pre          = safe_calloc((n > 0 ? n : 1), sizeof(UInt));
+  c->low          = safe_malloc(size);
+  c->dfs          = safe_malloc(size);
+  c->stack        = safe_malloc(size);
+  c->on           = safe_calloc((n > 0 ? n : 1), sizeof(bool));
+  c->edge         = safe_malloc(size);
+
+  // <blocked> is used as scratch space for the loops here
+  simplify_csr(c->out, c->mark, c->blocked);
+  c->in = new_csr_reverse(c->out);
+
+  // Since B lists never contain repeats, and <v> only belongs to B[w] if
+  // there is an edge from <v> to <w>, the pool never needs more than one node
+  // per edge.
+  UInt const m = c->out->nr_edges;
+  c->B_next    = safe_malloc((m > 0 ? m : 1) * sizeof(UInt));
+  c->B_val     = safe_malloc((m > 0 ? m : 1) * sizeof(UInt));
+  return c;
+}
+
+static void free_circuits(Circuits* const c) {
+  free_csr(c->out);
+  free_csr(c->in);
+  free(c->comp);
+  free(c->pos);
+  free(c->cid);
+  free(c->mark);
+  free(c->member);
+  free(c->queue);
+  free(c->blocked);
+  free(c->B_head);
+  free(c->B_next);
+  free(c->B_val);
+  free(c->path);
+  free(c->next);
+  free(c->found);
+  free(c->pre);
+  free(c->low);
+  free(c->dfs);
+  free(c->stack);
+  free(c->on);
+  free(c->edge);
+  free(c);
+}
+
+// Free every search on the stack above <c>, which must be on the stack, or
+// every search if <c> is NULL.
+static void free_circuits_above(Circuits const* const c) {
+  while (CIRCUITS != c) {
+    Circuits* const prev = CIRCUITS->prev;
+    free_circuits(CIRCUITS);
+    CIRCUITS = prev;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reporting circuits
+////////////////////////////////////////////////////////////////////////////////
+
+static void report_circuit(Circuits* const c, UInt const* path, UInt len) {
+  if (len < c->min) {
+    return;
+  }
+  Obj circ = NEW_PLIST(T_PLIST_CYC, len);
+  SET_LEN_PLIST(circ, len);
+  for (UInt i = 0; i < len; i++) {
+    SET_ELM_PLIST(circ, i + 1, INTOBJ_INT(path[i] + 1));
+  }
+  if (c->hook == Fail) {
+    ASS_LIST(c->user_param, LEN_LIST(c->user_param) + 1, circ);
+  } else if (CALL_2ARGS(c->hook, c->user_param, circ) == True) {
+    c->stop = true;
+  }
+  c->count++;
+  if (c->limit != 0 && c->count >= c->limit) {
+    c->stop = true;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Johnson's algorithm
+////////////////////////////////////////////////////////////////////////////////
+
+static void add_to_B(Circuits* const c, UInt const w, UInt const v) {
+  for (UInt x = c->B_head[w]; x != NONE; x = c->B_next[x]) {
+    if (c->B_val[x] == v) {
+      return;
+    }
+  }
+  UInt x;
+  if (c->B_free != NONE) {
+    x         = c->B_free;
+    c->B_free = c->B_next[x];
+  } else {
+    DIGRAPHS_ASSERT(c->B_size < c->out->nr_edges);
+    x = c->B_size++;
+  }
+  c->B_val[x]  = v;
+  c->B_next[x] = c->B_head[w];
+  c->B_head[w] = x;
+}
+
+static void unblock(Circuits* const c, UInt const u) {
+  // <queue> is not in use while the search is running
+  UInt* stack = c->queue;
+  UInt  top   = 0;
+
+  c->blocked[u] = false;
+  stack[top++]  = u;
+  while (top > 0) {
+    UInt const x = stack[--top];
+    UInt       y = c->B_head[x];
+    while (y != NONE) {
+      UInt const w    = c->B_val[y];
+      UInt const next = c->B_next[y];
+      if (c->blocked[w]) {
+        c->blocked[w] = false;
+        stack[top++]  = w;
+      }
+      c->B_next[y] = c->B_free;
+      c->B_free    = y;
+      y            = next;
+    }
+    c->B_head[x] = NONE;
+  }
+}
+
+// Find the members of the SCC of <s> in the subdigraph induced by the vertices
+// in component <id> in position at least pos[s]. Returns the number of
+// members.
+static UInt scc_of_start(Circuits* const c, UInt const s, UInt const id) {
+  CSR const* const out   = c->out;
+  CSR const* const in    = c->in;
+  UInt* const      queue = c->queue;
+  UInt const       p     = c->pos[s];
+  UInt             head = 0, tail = 0;
+
+  c->mark[s]    = s;
+  queue[tail++] = s;
+  while (head < tail) {
+    UInt const x = queue[head++];
+    for (UInt e = out->offsets[x]; e < out->offsets[x + 1]; e++) {
+      UInt const w = out->targets[e];
+      if (c->cid[w] == id && c->pos[w] >= p && c->mark[w] != s) {
+        c->mark[w]    = s;
+        queue[tail++] = w;
+      }
+    }
+  }
+
+  UInt nr     = 1;
+  head = tail = 0;
+  c->member[s]  = s;
+  queue[tail++] = s;
+  while (head < tail) {
+    UInt const x = queue[head++];
+    for (UInt e = in->offsets[x]; e < in->offsets[x + 1]; e++) {
+      UInt const w = in->targets[e];
+      if (c->mark[w] == s && c->member[w] != s) {
+        c->member[w]  = s;
+        queue[tail++] = w;
+        nr++;
+      }
+    }
+  }
+  // Reset <blocked> and the B lists of the members
+  for (UInt i = 0; i < tail; i++) {
+    c->blocked[queue[i]] = false;
+    c->B_head[queue[i]]  = NONE;
+  }
+  c->B_free = NONE;
+  c->B_size = 0;
+  return nr;
+}
+
+// Johnson's CIRCUIT procedure, made iterative, starting at <s>.
+static void circuit(Circuits* const c, UInt const s) {
+  CSR const* const out = c->out;
+  UInt* const      path = c->path;
+  UInt             d    = 0;  // the depth of the top of the path
+
+  path[0]       = s;
+  c->found[0]   = false;
+  c->next[s]    = out->offsets[s];
+  c->blocked[s] = true;
+
+  while (true) {
+    UInt const v = path[d];
+    if (c->next[v] < out->offsets[v + 1]) {
+      UInt const w = out->targets[c->next[v]++];
+      if (c->member[w] != s) {
+        continue;
+      } else if (w == s) {
+        c->found[d] = true;
+        report_circuit(c, path, d + 1);
+        if (c->stop) {
+          return;
+        }
+      } else if (!c->blocked[w]) {
+        if (c->max == 0 || d + 1 < c->max) {
+          path[++d]     = w;
+          c->found[d]   = false;
+          c->next[w]    = out->offsets[w];
+          c->blocked[w] = true;
+        } else {
+          // the search is cut off here
+          c->found[d] = true;
+        }
+      }
+      continue;
+    }
+    // backtrack
+    if (c->found[d]) {
+      unblock(c, v);
+    } else {
+      for (UInt e = out->offsets[v]; e < out->offsets[v + 1]; e++) {
+        UInt const w = out->targets[e];
+        if (c->member[w] == s) {
+          add_to_B(c, w, v);
+        }
+      }
+    }
+    if (d == 0) {
+      return;
+    }
+    d--;
+    c->found[d] = c->found[d] || c->found[d + 1];
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Strongly connected components
+////////////////////////////////////////////////////////////////////////////////
+
+// Run Johnson's algorithm for every vertex of the SCC comp[0 .. len - 1].
+static void johnson_component(Circuits* const c, UInt const len) {
+  UInt const id = c->cid[c->comp[0]];
+  for (UInt i = 0; i < len; i++) {
+    c->pos[c->comp[i]] = i;
+  }
+  for (UInt i = 0; i + 1 < len && !c->stop; i++) {
+    UInt const s = c->comp[i];
+    if (scc_of_start(c, s, id) > 1) {
+      circuit(c, s);
+    }
+  }
+}
+
+// An iterative version of Tarjan's algorithm which finds the strongly
+// connected components in the same order as GABOW_SCC, and each component in
+// the order its vertices were first visited, and calls johnson_component on
+// every component with more than one vertex.
+static void johnson(Circuits* const c) {
+  CSR const* const out = c->out;
+  UInt const       n   = out->nr_vertices;
+  if (n == 0) {
+    return;
+  }
+  UInt* const pre   = c->pre;
+  UInt* const low   = c->low;
+  UInt* const dfs   = c->dfs;
+  UInt* const stack = c->stack;
+  bool* const on    = c->on;
+  UInt* const next  = c->edge;
+  UInt        nr_cid = 0, counter = 0;
+
+  for (UInt v = 0; v < n; v++) {
+    c->mark[v]   = NONE;
+    c->member[v] = NONE;
+  }
+
+  for (UInt r = 0; r < n && !c->stop; r++) {
+    if (pre[r] != 0) {
+      continue;
+    }
+    UInt top = 0, nr_stack = 0;
+    pre[r] = low[r]   = ++counter;
+    next[r]           = out->offsets[r];
+    dfs[top++]        = r;
+    stack[nr_stack++] = r;
+    on[r]             = true;
+    while (top > 0 && !c->stop) {
+      UInt const v = dfs[top - 1];
+      if (next[v] < out->offsets[v + 1]) {
+        UInt const w = out->targets[next[v]++];
+        if (pre[w] == 0) {
+          pre[w] = low[w]   = ++counter;
+          next[w]           = out->offsets[w];
+          dfs[top++]        = w;
+          stack[nr_stack++] = w;
+          on[w]             = true;
+        } else if (on[w] && pre[w] < low[v]) {
+          low[v] = pre[w];
+        }
+        continue;
+      }
+      top--;
+      if (top > 0 && low[v] < low[dfs[top - 1]]) {
+        low[dfs[top - 1]] = low[v];
+      }
+      if (low[v] == pre[v]) {
+        UInt len = 0;
+        while (stack[nr_stack - 1 - len] != v) {
+          len++;
+        }
+        len++;
+        nr_stack -= len;
+        for (UInt i = 0; i < len; i++) {
+          UInt const w = stack[nr_stack + i];
+          on[w]        = false;
+          c->comp[i]   = w;
+          c->cid[w]    = nr_cid;
+        }
+        nr_cid++;
+        if (len > 1) {
+          johnson_component(c, len);
+        }
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GAP level function
+////////////////////////////////////////////////////////////////////////////////
+
+// The argument <hook> must be fail or a function with 2 arguments, if <hook>
+// is fail, then <user_param> must be a list. The arguments <limit> and <max>
+// must be non-negative integers, where 0 means no limit or bound, and <min>
+// must be a positive integer. Returns <user_param>.
+Obj FuncDIGRAPH_SIMPLE_CIRCUITS(Obj self,
+                                Obj D,
+                                Obj hook,
+                                Obj user_param,
+                                Obj limit,
+                                Obj min,
+                                Obj max) {
+  // Free the searches abandoned because of an error in their hook
+  Int const depth = GetRecursionDepth();
+  while (CIRCUITS != NULL && CIRCUITS->depth >= depth) {
+    free_circuits_above(CIRCUITS->prev);
+  }
+  Circuits* c   = new_circuits(D);
+  c->prev       = CIRCUITS;
+  c->depth      = depth;
+  CIRCUITS      = c;
+  c->hook       = hook;
+  c->user_param = user_param;
+  c->limit      = INT_INTOBJ(limit);
+  c->min        = INT_INTOBJ(min);
+  c->max        = INT_INTOBJ(max);
+  c->count      = 0;
+  c->stop       = false;
+
+  // Loops are the circuits of length 1, and are found first. The loops were
+  // recorded in <blocked> by new_circuits.
+  UInt const n = c->out->nr_vertices;
+  for (UInt v = 0; v < n; v++) {
+    if (c->blocked[v]) {
+      c->blocked[v] = false;
+      if (!c->stop) {
+        report_circuit(c, &v, 1);
+      }
+    }
+  }
+  if (!c->stop && c->max != 1) {
+    johnson(c);
+  }
+  free_circuits_above(c->prev);
+  return user_param;
+}
@@ -0,0 +1,25 @@
+/********************************************************************************
+**
+*A  circuits.h             simple circuits
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_CIRCUITS_H_
+#define DIGRAPHS_SRC_CIRCUITS_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_SIMPLE_CIRCUITS(Obj self,
+                                Obj D,
+                                Obj hook,
+                                Obj user_param,
+                                Obj limit,
+                                Obj min,
+                                Obj max);
+
+#endif  // DIGRAPHS_SRC_CIRCUITS_H_
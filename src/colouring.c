@@ -0,0 +1,495 @@
+/********************************************************************************
+**
+*A  colouring.c            vertex colouring heuristics
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "colouring.h"
+
+// C headers
+#include <limits.h>   // for CHAR_BIT
+#include <stdbool.h>  // for false, true, bool
+#include <stdlib.h>   // for free
+#include <string.h>   // for memset
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, Int, ELM_PLIST, . . .
+
+// Digraphs headers
+#include "csr.h"             // for CSR, new_csr_symmetric, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "digraphs.h"        // for DigraphNrVertices
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+// This file contains a number of heuristics for finding proper vertex
+// colourings of the symmetric closure of a digraph without loops. All of the
+// functions in this file work on a CSR containing the out- and in-neighbours
+// of every vertex, and use 0-based vertices and colours internally.
+
+#define WORD_BITS (sizeof(UInt) * CHAR_BIT)
+#define NR_WORDS(nr_bits) (((nr_bits) + WORD_BITS - 1) / WORD_BITS)
+#define MASK(bit) ((UInt) 1 << ((bit) % WORD_BITS))
+
+////////////////////////////////////////////////////////////////////////////////
+// A binary min-heap of vertices with lazy deletion.
+//
+// The keys of a vertex are compared lexicographically, ties are broken by the
+// smallest vertex. Rather than updating the position of a vertex in the heap
+// when its key changes, a new entry is pushed, and the caller discards stale
+// entries when they are popped. In this file, a new entry is only pushed when
+// an edge is traversed, and so a capacity of n + m always suffices.
+////////////////////////////////////////////////////////////////////////////////
+
+struct heap_entry_struct {
+  UInt key1;
+  UInt key2;
+  UInt vertex;
+};
+
+typedef struct heap_entry_struct HeapEntry;
+
+struct heap_struct {
+  HeapEntry* entries;
+  UInt       size;
+  UInt       capacity;
+};
+
+typedef struct heap_struct Heap;
+
+static Heap* new_heap(UInt const capacity) {
+  Heap* heap     = safe_malloc(sizeof(Heap));
+  heap->capacity = (capacity > 0 ? capacity : 1);
+  heap->entries  = safe_malloc(heap->capacity * sizeof(HeapEntry));
+  heap->size     = 0;
+  return heap;
+}
+
+static void free_heap(Heap* const heap) {
+  free(heap->entries);
+  free(heap);
+}
+
+static inline bool heap_lt(HeapEntry const* const x, HeapEntry const* const y) {
+  if (x->key1 != y->key1) {
+    return x->key1 < y->key1;
+  } else if (x->key2 != y->key2) {
+    return x->key2 < y->key2;
+  }
+  return x->vertex < y->vertex;
+}
+
+static void
+heap_push(Heap* const heap, UInt const key1, UInt const key2, UInt const v) {
+  DIGRAPHS_ASSERT(heap->size < heap->capacity);
+  HeapEntry* entries = heap->entries;
+  UInt       i       = heap->size++;
+  entries[i].key1    = key1;
+  entries[i].key2    = key2;
+  entries[i].vertex  = v;
+  while (i > 0 && heap_lt(&entries[i], &entries[(i - 1) / 2])) {
+    HeapEntry tmp        = entries[i];
+    entries[i]           = entries[(i - 1) / 2];
+    entries[(i - 1) / 2] = tmp;
+    i                    = (i - 1) / 2;
+  }
+}
+
+static HeapEntry heap_pop(Heap* const heap) {
+  DIGRAPHS_ASSERT(heap->size > 0);
+  HeapEntry* entries = heap->entries;
+  HeapEntry  result  = entries[0];
+  entries[0]         = entries[--heap->size];
+  UInt i             = 0;
+  while (true) {
+    UInt min = i;
+    UInt l   = 2 * i + 1;
+    UInt r   = 2 * i + 2;
+    if (l < heap->size && heap_lt(&entries[l], &entries[min])) {
+      min = l;
+    }
+    if (r < heap->size && heap_lt(&entries[r], &entries[min])) {
+      min = r;
+    }
+    if (min == i) {
+      break;
+    }
+    HeapEntry tmp = entries[i];
+    entries[i]    = entries[min];
+    entries[min]  = tmp;
+    i             = min;
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Orders
+////////////////////////////////////////////////////////////////////////////////
+
+// Put the vertices of <g> into <order> in non-increasing order of degree, ties
+// are broken by the smallest vertex. This is a counting sort, and so runs in
+// linear time.
+static void welsh_powell_order(CSR const* const g, UInt* const order) {
+  UInt const n      = g->nr_vertices;
+  UInt       maxdeg = 0;
+  for (UInt v = 0; v < n; v++) {
+    UInt const deg = degree_csr(g, v);
+    maxdeg         = (deg > maxdeg ? deg : maxdeg);
+  }
+  UInt* count = safe_calloc(maxdeg + 2, sizeof(UInt));
+  for (UInt v = 0; v < n; v++) {
+    count[maxdeg - degree_csr(g, v) + 1]++;
+  }
+  for (UInt d = 0; d <= maxdeg; d++) {
+    count[d + 1] += count[d];
+  }
+  for (UInt v = 0; v < n; v++) {
+    order[count[maxdeg - degree_csr(g, v)]++] = v;
+  }
+  free(count);
+}
+
+// Put the vertices of <g> into <order> in smallest-last order: the last vertex
+// has minimum degree in <g>, the second last vertex has minimum degree in the
+// graph obtained by removing the last vertex, and so on. Ties are broken by the
+// smallest vertex. Every neighbour of a vertex in <g> (including loops and
+// multiple edges) contributes to its degree.
+static void smallest_last_order(CSR const* const g, UInt* const order) {
+  UInt const n       = g->nr_vertices;
+  UInt*      deg     = safe_malloc((n > 0 ? n : 1) * sizeof(UInt));
+  bool*      removed = safe_calloc(n > 0 ? n : 1, sizeof(bool));
+  Heap*      heap    = new_heap(n + g->nr_edges);
+
+  for (UInt v = 0; v < n; v++) {
+    deg[v] = degree_csr(g, v);
+    heap_push(heap, deg[v], 0, v);
+  }
+
+  UInt pos = n;
+  while (pos > 0) {
+    HeapEntry const min = heap_pop(heap);
+    UInt const      v   = min.vertex;
+    if (removed[v] || min.key1 != deg[v]) {
+      continue;  // stale
+    }
+    removed[v]   = true;
+    order[--pos] = v;
+    for (UInt e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+      UInt const u = g->targets[e];
+      if (!removed[u]) {
+        heap_push(heap, --deg[u], 0, u);
+      }
+    }
+  }
+  free(deg);
+  free(removed);
+  free_heap(heap);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Colourings
+//
+// Each of the following functions puts a proper colouring of <g> into
+// <colours>, and returns the number of colours used.
+////////////////////////////////////////////////////////////////////////////////
+
+// Colours the vertices one colour class at a time: every vertex in <order>
+// that is not yet coloured and not adjacent to a vertex already in the current
+// class is added to the class. This is the algorithm that was used by
+// DigraphGreedyColouringNC at the GAP level, and so the colourings it returns
+// are unchanged. Returns 0 if <order> does not contain every vertex.
+static UInt
+sweep_colouring(CSR const* const g, UInt const* const order, UInt* colours) {
+  UInt const n        = g->nr_vertices;
+  UInt const nr_words = NR_WORDS(n);
+  UInt* available = safe_malloc((nr_words > 0 ? nr_words : 1) * sizeof(UInt));
+  bool* coloured  = safe_calloc(n > 0 ? n : 1, sizeof(bool));
+  UInt  nr_coloured = 0, colour = 0;
+
+  while (nr_coloured < n) {
+    memset(available, 0xFF, nr_words * sizeof(UInt));
+    bool progress = false;
+    for (UInt i = 0; i < n; i++) {
+      UInt const v = order[i];
+      if (coloured[v] || !(available[v / WORD_BITS] & MASK(v))) {
+        continue;
+      }
+      coloured[v] = true;
+      colours[v]  = colour;
+      nr_coloured++;
+      progress = true;
+      for (UInt e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+        UInt const u = g->targets[e];
+        available[u / WORD_BITS] &= ~MASK(u);
+      }
+    }
+    if (!progress) {
+      // Only possible if <order> is not a permutation
+      colour = 0;
+      break;
+    }
+    colour++;
+  }
+  free(available);
+  free(coloured);
+  return colour;
+}
+
+// Colours the vertices in <order> one at a time, each with the least colour
+// not used by any of its neighbours.
+static UInt first_fit_colouring(CSR const* const g,
+                                UInt const* const order,
+                                UInt*             colours) {
+  UInt const n          = g->nr_vertices;
+  UInt*      stamp      = safe_calloc(n + 1, sizeof(UInt));
+  bool*      done       = safe_calloc(n > 0 ? n : 1, sizeof(bool));
+  UInt       nr_colours = 0;
+
+  for (UInt i = 0; i < n; i++) {
+    UInt const v = order[i];
+    for (UInt e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+      UInt const u = g->targets[e];
+      if (done[u]) {
+        stamp[colours[u]] = i + 1;
+      }
+    }
+    UInt c = 0;
+    while (stamp[c] == i + 1) {
+      c++;
+    }
+    colours[v] = c;
+    done[v]    = true;
+    nr_colours = (c + 1 > nr_colours ? c + 1 : nr_colours);
+  }
+  free(stamp);
+  free(done);
+  return nr_colours;
+}
+
+// Brélaz's DSATUR: repeatedly colour an uncoloured vertex with the largest
+// number of distinct colours among its neighbours (its saturation) with the
+// least colour not used by any of its neighbours. Ties are broken by the
+// largest degree, and then by the smallest vertex.
+//
+// A vertex <v> of degree <d> always receives a colour in [0 .. d], and so the
+// neighbouring colours of <v> in this range are stored in a bitset of d + 1
+// bits. These bitsets use O(n + m) memory in total. Colours larger than d
+// that appear on the neighbours of <v> are only needed for the saturation, and
+// are rare, so these are counted by checking the other neighbours of <v>.
+static UInt dsatur_colouring(CSR const* const g, UInt* colours) {
+  UInt const n      = g->nr_vertices;
+  UInt       maxdeg = 0;
+  UInt*      offset = safe_malloc((n + 1) * sizeof(UInt));
+
+  offset[0] = 0;
+  for (UInt v = 0; v < n; v++) {
+    UInt const deg = degree_csr(g, v);
+    maxdeg         = (deg > maxdeg ? deg : maxdeg);
+    offset[v + 1]  = offset[v] + NR_WORDS(deg + 1);
+  }
+
+  UInt* nbs_colours = safe_calloc(offset[n] > 0 ? offset[n] : 1, sizeof(UInt));
+  UInt* saturation  = safe_calloc(n > 0 ? n : 1, sizeof(UInt));
+  bool* coloured    = safe_calloc(n > 0 ? n : 1, sizeof(bool));
+  UInt* seen        = safe_calloc(n > 0 ? n : 1, sizeof(UInt));
+  Heap* heap        = new_heap(n + g->nr_edges);
+  UInt  nr_colours  = 0;
+
+  for (UInt v = 0; v < n; v++) {
+    heap_push(heap, n, maxdeg - degree_csr(g, v), v);
+  }
+
+  for (UInt i = 1; i <= n; i++) {
+    HeapEntry max;
+    do {
+      max = heap_pop(heap);
+    } while (coloured[max.vertex] || max.key1 != n - saturation[max.vertex]);
+
+    UInt const  v    = max.vertex;
+    UInt const* bits = nbs_colours + offset[v];
+    UInt        c    = 0;
+    while (bits[c / WORD_BITS] == ~(UInt) 0) {
+      c += WORD_BITS;
+    }
+    while (bits[c / WORD_BITS] & MASK(c)) {
+      c++;
+    }
+    DIGRAPHS_ASSERT(c <= degree_csr(g, v));
+    colours[v]  = c;
+    coloured[v] = true;
+    nr_colours  = (c + 1 > nr_colours ? c + 1 : nr_colours);
+
+    // Update the saturation of every uncoloured neighbour of <v> exactly once,
+    // even if there are multiple edges.
+    for (UInt e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+      UInt const u = g->targets[e];
+      if (coloured[u] || seen[u] == i) {
+        continue;
+      }
+      seen[u]    = i;
+      bool fresh = true;
+      if (c <= degree_csr(g, u)) {
+        UInt* word = nbs_colours + offset[u] + c / WORD_BITS;
+        fresh      = !(*word & MASK(c));
+        *word |= MASK(c);
+      } else {
+        for (UInt f = g->offsets[u]; f < g->offsets[u + 1]; f++) {
+          UInt const w = g->targets[f];
+          if (w != v && coloured[w] && colours[w] == c) {
+            fresh = false;
+            break;
+          }
+        }
+      }
+      if (fresh) {
+        saturation[u]++;
+        heap_push(heap, n - saturation[u], maxdeg - degree_csr(g, u), u);
+      }
+    }
+  }
+  free(offset);
+  free(nbs_colours);
+  free(saturation);
+  free(coloured);
+  free(seen);
+  free_heap(heap);
+  return nr_colours;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GAP level functions
+////////////////////////////////////////////////////////////////////////////////
+
+static Obj colours_to_plist(UInt const* const colours, UInt const n) {
+  Obj result = NEW_PLIST_IMM(T_PLIST_CYC, n);
+  SET_LEN_PLIST(result, n);
+  for (UInt v = 0; v < n; v++) {
+    SET_ELM_PLIST(result, v + 1, INTOBJ_INT(colours[v] + 1));
+  }
+  return result;
+}
+
+// The argument <D> must be a digraph without loops, and <order> a permutation
+// of its vertices.
+Obj FuncDIGRAPH_GREEDY_COLOURING(Obj self, Obj D, Obj order) {
+  UInt const n = DigraphNrVertices(D);
+  if (!IS_LIST(order) || (UInt) LEN_LIST(order) != n) {
+    ErrorQuit("the 2nd argument <order> must be a permutation of [1 .. %d]",
+              (Int) n,
+              0L);
+  }
+  // ELM_LIST can enter an error (for example, if <order> has holes), and so
+  // the 0-based order is kept in a GAP string, which is reclaimed by the
+  // garbage collector if this happens, rather than in a malloc'ed buffer. The
+  // pointer <ord> is only fetched once there are no more GAP allocations.
+  Obj buf = NEW_STRING((n > 0 ? n : 1) * sizeof(UInt));
+  for (UInt i = 0; i < n; i++) {
+    Obj x = ELM_LIST(order, i + 1);
+    if (!IS_INTOBJ(x) || INT_INTOBJ(x) < 1 || (UInt) INT_INTOBJ(x) > n) {
+      ErrorQuit("the 2nd argument <order> must be a permutation of [1 .. %d]",
+                (Int) n,
+                0L);
+    }
+    ((UInt*) CHARS_STRING(buf))[i] = INT_INTOBJ(x) - 1;
+  }
+
+  CSR*  g       = new_csr_symmetric(D, false);
+  UInt* ord     = (UInt*) CHARS_STRING(buf);
+  UInt* colours = safe_malloc((n > 0 ? n : 1) * sizeof(UInt));
+  UInt const nr_colours = sweep_colouring(g, ord, colours);
+  Obj        result     = Fail;
+  if (nr_colours > 0 || n == 0) {
+    result = colours_to_plist(colours, n);
+  }
+  free(colours);
+  free_csr(g);
+  if (result == Fail) {
+    ErrorQuit("the 2nd argument <order> must be a permutation of [1 .. %d]",
+              (Int) n,
+              0L);
+  }
+  return result;
+}
+
+// The argument <D> must be a digraph without loops.
+Obj FuncDIGRAPH_DSATUR_COLOURING(Obj self, Obj D) {
+  CSR*       g       = new_csr_symmetric(D, false);
+  UInt const n       = g->nr_vertices;
+  UInt*      colours = safe_malloc((n > 0 ? n : 1) * sizeof(UInt));
+  dsatur_colouring(g, colours);
+  Obj result = colours_to_plist(colours, n);
+  free(colours);
+  free_csr(g);
+  return result;
+}
+
+Obj FuncDIGRAPH_WELSH_POWELL_ORDER(Obj self, Obj D) {
+  CSR*       g     = new_csr_symmetric(D, true);
+  UInt const n     = g->nr_vertices;
+  UInt*      order = safe_malloc((n > 0 ? n : 1) * sizeof(UInt));
+  welsh_powell_order(g, order);
+  // <order> is a permutation, and so <colours_to_plist> just adds 1
+  Obj result = colours_to_plist(order, n);
+  free(order);
+  free_csr(g);
+  return result;
+}
+
+Obj FuncDIGRAPH_SMALLEST_LAST_ORDER(Obj self, Obj D) {
+  CSR*       g     = new_csr_symmetric(D, true);
+  UInt const n     = g->nr_vertices;
+  UInt*      order = safe_malloc((n > 0 ? n : 1) * sizeof(UInt));
+  smallest_last_order(g, order);
+  // <order> is a permutation, and so <colours_to_plist> just adds 1
+  Obj result = colours_to_plist(order, n);
+  free(order);
+  free_csr(g);
+  return result;
+}
+
+// Returns the colouring with the fewest colours found by DSATUR, the greedy
+// colouring with respect to the Welsh-Powell order, and the first-fit
+// colouring with respect to the smallest-last order. The argument <D> must be
+// a digraph without loops.
+Obj FuncDIGRAPH_HEURISTIC_COLOURING(Obj self, Obj D) {
+  CSR*       g     = new_csr_symmetric(D, false);
+  UInt const n     = g->nr_vertices;
+  UInt const size  = (n > 0 ? n : 1) * sizeof(UInt);
+  UInt*      best  = safe_malloc(size);
+  UInt*      other = safe_malloc(size);
+  UInt*      order = safe_malloc(size);
+
+  UInt nr_best = dsatur_colouring(g, best);
+
+  if (nr_best > 2) {
+    welsh_powell_order(g, order);
+    UInt const nr = sweep_colouring(g, order, other);
+    if (nr < nr_best) {
+      UInt* tmp = best;
+      best      = other;
+      other     = tmp;
+      nr_best   = nr;
+    }
+  }
+
+  if (nr_best > 2) {
+    smallest_last_order(g, order);
+    UInt const nr = first_fit_colouring(g, order, other);
+    if (nr < nr_best) {
+      UInt* tmp = best;
+      best      = other;
+      other     = tmp;
+      nr_best   = nr;
+    }
+  }
+
+  Obj result = colours_to_plist(best, n);
+  free(best);
+  free(other);
+  free(order);
+  free_csr(g);
+  return result;
+}
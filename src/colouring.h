@@ -0,0 +1,23 @@
+/********************************************************************************
+**
+*A  colouring.h            vertex colouring heuristics
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_COLOURING_H_
+#define DIGRAPHS_SRC_COLOURING_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_GREEDY_COLOURING(Obj self, Obj D, Obj order);
+Obj FuncDIGRAPH_DSATUR_COLOURING(Obj self, Obj D);
+Obj FuncDIGRAPH_WELSH_POWELL_ORDER(Obj self, Obj D);
+Obj FuncDIGRAPH_SMALLEST_LAST_ORDER(Obj self, Obj D);
+Obj FuncDIGRAPH_HEURISTIC_COLOURING(Obj self, Obj D);
+
+#endif  // DIGRAPHS_SRC_COLOURING_H_
@@ -0,0 +1,365 @@
+/********************************************************************************
+**
+*A  constructors.c         line digraphs, quotients, and induced subdigraphs
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "constructors.h"
+
+// C headers
+#include <stdbool.h>  // for false, true, bool
+#include <stdlib.h>   // for free, qsort
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt, NEW_PLIST, . . .
+
+// Digraphs headers
+#include "csr.h"             // for CSR, new_csr_out_neighbours, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "digraphs.h"        // for DigraphNrVertices, FuncOutNeighbours
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+// This file contains the out-neighbours of some digraphs constructed from a
+// given digraph, computed directly from the out-neighbours of the given
+// digraph. The out-neighbours of every vertex are the same, and in the same
+// order, as those computed by the original GAP level implementations.
+
+static Obj new_row(UInt const len) {
+  Obj row = NEW_PLIST(len == 0 ? T_PLIST_EMPTY : T_PLIST_CYC, len);
+  SET_LEN_PLIST(row, len);
+  return row;
+}
+
+static Obj new_rows(UInt const len) {
+  Obj rows = NEW_PLIST(len == 0 ? T_PLIST_EMPTY : T_PLIST_TAB, len);
+  SET_LEN_PLIST(rows, len);
+  return rows;
+}
+
+static int cmp_uint(void const* a, void const* b) {
+  UInt const x = *(UInt const*) a;
+  UInt const y = *(UInt const*) b;
+  return (x > y) - (x < y);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Line digraphs
+////////////////////////////////////////////////////////////////////////////////
+
+// The vertices of the line digraph of <D> are the edges of <D>, in the order
+// of DigraphEdges, and there is an edge from [a, b] to every edge [b, c]
+// other than [a, b] itself. Since the edges are numbered in order, the
+// out-neighbours of every vertex are sorted.
+Obj FuncDIGRAPH_LINE_DIGRAPH(Obj self, Obj D) {
+  CSR*       out = new_csr_out_neighbours(D);
+  UInt const n   = out->nr_vertices;
+  UInt const m   = out->nr_edges;
+
+  Obj result = new_rows(m);
+  for (UInt a = 0; a < n; a++) {
+    for (UInt e = out->offsets[a]; e < out->offsets[a + 1]; e++) {
+      UInt const b = out->targets[e];
+      // If [a, b] is a loop, then the only edges [b, c] equal to [a, b] are
+      // the loops at <b>, which are omitted.
+      UInt len = degree_csr(out, b);
+      if (a == b) {
+        for (UInt f = out->offsets[b]; f < out->offsets[b + 1]; f++) {
+          len -= (out->targets[f] == b);
+        }
+      }
+      Obj  row = new_row(len);
+      UInt k   = 0;
+      for (UInt f = out->offsets[b]; f < out->offsets[b + 1]; f++) {
+        if (a != b || out->targets[f] != b) {
+          SET_ELM_PLIST(row, ++k, INTOBJ_INT(f + 1));
+        }
+      }
+      DIGRAPHS_ASSERT(k == len);
+      SET_ELM_PLIST(result, e + 1, row);
+      CHANGED_BAG(result);
+    }
+  }
+  free_csr(out);
+  return result;
+}
+
+// The argument <D> must be a symmetric digraph. The vertices of the
+// undirected line digraph of <D> are the undirected edges {a, b} of <D>, in
+// the order of Set(DigraphEdges(D), Set), and there is an edge between any two
+// distinct undirected edges with an endpoint in common.
+Obj FuncDIGRAPH_LINE_UNDIRECTED_DIGRAPH(Obj self, Obj D) {
+  CSR*       out    = new_csr_out_neighbours(D);
+  CSR*       sorted = new_csr_sorted(out);
+  UInt const n      = sorted->nr_vertices;
+  free_csr(out);
+
+  // The undirected edge with number <i> (indexed from 0) is {src[i], ran[i]}
+  // where src[i] <= ran[i], numbered in increasing order.
+  UInt  nr  = 0;
+  UInt* src = safe_malloc((sorted->nr_edges + 1) * sizeof(UInt));
+  UInt* ran = safe_malloc((sorted->nr_edges + 1) * sizeof(UInt));
+  for (UInt a = 0; a < n; a++) {
+    for (UInt e = sorted->offsets[a]; e < sorted->offsets[a + 1]; e++) {
+      UInt const b = sorted->targets[e];
+      if (b >= a
+          && (e == sorted->offsets[a] || sorted->targets[e - 1] != b)) {
+        src[nr]   = a;
+        ran[nr++] = b;
+      }
+    }
+  }
+
+  // The numbers of the undirected edges incident to each vertex <v> are:
+  //
+  //   inc[offsets[v]], ..., inc[offsets[v + 1] - 1]
+  //
+  // in increasing order.
+  UInt* offsets = safe_calloc(n + 2, sizeof(UInt));
+  UInt* inc     = safe_malloc((2 * nr + 1) * sizeof(UInt));
+  for (UInt i = 0; i < nr; i++) {
+    offsets[src[i] + 1]++;
+    if (src[i] != ran[i]) {
+      offsets[ran[i] + 1]++;
+    }
+  }
+  for (UInt v = 0; v < n; v++) {
+    offsets[v + 1] += offsets[v];
+  }
+  UInt* fill = safe_malloc((n + 1) * sizeof(UInt));
+  for (UInt v = 0; v < n; v++) {
+    fill[v] = offsets[v];
+  }
+  for (UInt i = 0; i < nr; i++) {
+    inc[fill[src[i]]++] = i;
+    if (src[i] != ran[i]) {
+      inc[fill[ran[i]]++] = i;
+    }
+  }
+  free(fill);
+
+  // The only undirected edge incident to both <a> and <b> is {a, b}, and so
+  // the out-neighbours of {a, b} are the merge of the edges incident to <a>
+  // and to <b>, with {a, b} removed.
+  Obj result = new_rows(nr);
+  for (UInt i = 0; i < nr; i++) {
+    UInt const a = src[i], b = ran[i];
+    UInt       p = offsets[a], q = offsets[b];
+    UInt const p_end = offsets[a + 1], q_end = (a == b ? q : offsets[b + 1]);
+    Obj        row   = new_row(p_end - p + q_end - q - (a == b ? 1 : 2));
+    UInt       k     = 0;
+    while (p < p_end || q < q_end) {
+      UInt j;
+      if (q == q_end || (p < p_end && inc[p] < inc[q])) {
+        j = inc[p++];
+      } else {
+        j = inc[q++];
+      }
+      if (j != i) {
+        SET_ELM_PLIST(row, ++k, INTOBJ_INT(j + 1));
+      }
+    }
+    DIGRAPHS_ASSERT(k == (UInt) LEN_PLIST(row));
+    SET_ELM_PLIST(result, i + 1, row);
+    CHANGED_BAG(result);
+  }
+
+  free(src);
+  free(ran);
+  free(offsets);
+  free(inc);
+  free_csr(sorted);
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Induced subdigraphs
+////////////////////////////////////////////////////////////////////////////////
+
+// The argument <list> must be a list, and <edge_labels> either the list of
+// edge labels of <D> or fail. Returns fail if <list> is not a duplicate-free
+// list of vertices of <D>, and otherwise returns a record with components
+// "out", the out-neighbours of the subdigraph of <D> induced by <list>, and
+// "edge_labels", the corresponding edge labels, or fail if <edge_labels> is
+// fail.
+Obj FuncDIGRAPH_INDUCED_SUBDIGRAPH(Obj self, Obj D, Obj list, Obj edge_labels) {
+  UInt const n   = DigraphNrVertices(D);
+  Obj const  out = FuncOutNeighbours(self, D);
+  UInt const M   = LEN_LIST(list);
+
+  // lookup[v] is the position of <v> in <list>, or 0 if <v> is not in <list>
+  UInt* lookup = safe_calloc(n + 1, sizeof(UInt));
+  for (UInt i = 1; i <= M; i++) {
+    Obj const x = ELM_LIST(list, i);
+    if (!IS_INTOBJ(x) || INT_INTOBJ(x) < 1 || INT_INTOBJ(x) > (Int) n
+        || lookup[INT_INTOBJ(x) - 1] != 0) {
+      free(lookup);
+      return Fail;
+    }
+    lookup[INT_INTOBJ(x) - 1] = i;
+  }
+
+  Obj new_out = new_rows(M);
+  Obj new_edl = (edge_labels == Fail ? Fail : new_rows(M));
+  for (UInt v = 1; v <= M; v++) {
+    UInt const vv  = INT_INTOBJ(ELM_LIST(list, v));
+    Obj const  nbs = ELM_PLIST(out, vv);
+    UInt const len = LEN_LIST(nbs);
+    UInt       k   = 0;
+    for (UInt i = 1; i <= len; i++) {
+      k += (lookup[INT_INTOBJ(ELM_LIST(nbs, i)) - 1] != 0);
+    }
+    Obj next = new_row(k);
+    Obj labs = 0;
+    Obj old  = 0;
+    if (new_edl != Fail) {
+      labs = NEW_PLIST(k == 0 ? T_PLIST_EMPTY : T_PLIST, k);
+      SET_LEN_PLIST(labs, k);
+      old = ELM_LIST(edge_labels, vv);
+    }
+    k = 0;
+    for (UInt i = 1; i <= len; i++) {
+      UInt const w = lookup[INT_INTOBJ(ELM_LIST(nbs, i)) - 1];
+      if (w != 0) {
+        SET_ELM_PLIST(next, ++k, INTOBJ_INT(w));
+        if (labs != 0) {
+          SET_ELM_PLIST(labs, k, ELM_LIST(old, i));
+          CHANGED_BAG(labs);
+        }
+      }
+    }
+    SET_ELM_PLIST(new_out, v, next);
+    CHANGED_BAG(new_out);
+    if (labs != 0) {
+      SET_ELM_PLIST(new_edl, v, labs);
+      CHANGED_BAG(new_edl);
+    }
+  }
+  free(lookup);
+
+  Obj result = NEW_PREC(2);
+  AssPRec(result, RNamName("out"), new_out);
+  AssPRec(result, RNamName("edge_labels"), new_edl);
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Quotient digraphs
+////////////////////////////////////////////////////////////////////////////////
+
+// Writes the part (indexed from 1) containing each vertex <v> of <D> into
+// lookup[v], and the number of vertices in each part <x> into size[x]. Returns
+// false if <partition> is not a partition of the <n> vertices of <D>.
+static bool partition_lookup(Obj const   partition,
+                             UInt const  n,
+                             UInt* const lookup,
+                             UInt* const size) {
+  UInt nr = 0;
+  for (UInt x = 1; x <= (UInt) LEN_LIST(partition); x++) {
+    Obj const part = ELM_LIST(partition, x);
+    if (!IS_LIST(part)) {
+      return false;
+    }
+    for (UInt i = 1; i <= (UInt) LEN_LIST(part); i++) {
+      Obj const v = ELM_LIST(part, i);
+      if (!IS_INTOBJ(v) || INT_INTOBJ(v) < 1 || INT_INTOBJ(v) > (Int) n
+          || lookup[INT_INTOBJ(v) - 1] != 0) {
+        return false;
+      }
+      lookup[INT_INTOBJ(v) - 1] = x;
+      size[x]++;
+      nr++;
+    }
+  }
+  return nr == n;
+}
+
+// The argument <partition> must be a list, and <vertex_labels> the list of
+// vertex labels of <D>. Returns fail if <partition> is not a partition of the
+// vertices of <D>, and otherwise returns a record with components "out", the
+// out-neighbours of the quotient of <D> by <partition>, where the
+// out-neighbours of every vertex are sorted and duplicate-free, and
+// "vertex_labels", the list whose <i>th entry is the list of labels of the
+// vertices in the <i>th part of <partition>, in increasing order of vertex.
+Obj FuncDIGRAPH_QUOTIENT_DIGRAPH(Obj self,
+                                 Obj D,
+                                 Obj partition,
+                                 Obj vertex_labels) {
+  UInt const n   = DigraphNrVertices(D);
+  Obj const  out = FuncOutNeighbours(self, D);
+  UInt const M   = LEN_LIST(partition);
+
+  UInt* lookup = safe_calloc(n + 1, sizeof(UInt));
+  UInt* size   = safe_calloc(M + 1, sizeof(UInt));
+  if (!partition_lookup(partition, n, lookup, size)) {
+    free(lookup);
+    free(size);
+    return Fail;
+  }
+
+  // The vertices in each part <x> are members[start[x]], ...,
+  // members[start[x + 1] - 1], in increasing order.
+  UInt* start   = safe_calloc(M + 2, sizeof(UInt));
+  UInt* members = safe_malloc((n + 1) * sizeof(UInt));
+  for (UInt x = 1; x <= M; x++) {
+    start[x + 1] = start[x] + size[x];
+  }
+  UInt* fill = safe_malloc((M + 1) * sizeof(UInt));
+  for (UInt x = 1; x <= M; x++) {
+    fill[x] = start[x];
+  }
+  for (UInt v = 0; v < n; v++) {
+    members[fill[lookup[v]]++] = v;
+  }
+  free(fill);
+
+  // stamp[y] == x if and only if <y> has already been found as an
+  // out-neighbour of <x>.
+  UInt* stamp = safe_calloc(M + 1, sizeof(UInt));
+  UInt* buf   = safe_malloc((M + 1) * sizeof(UInt));
+
+  Obj new_out = new_rows(M);
+  Obj new_vl  = new_rows(M);
+  for (UInt x = 1; x <= M; x++) {
+    Obj labels = NEW_PLIST(size[x] == 0 ? T_PLIST_EMPTY : T_PLIST, size[x]);
+    SET_LEN_PLIST(labels, size[x]);
+    UInt k = 0;
+    for (UInt i = start[x]; i < start[x + 1]; i++) {
+      UInt const u = members[i];
+      SET_ELM_PLIST(labels, i - start[x] + 1, ELM_LIST(vertex_labels, u + 1));
+      CHANGED_BAG(labels);
+      Obj const  nbs = ELM_PLIST(out, u + 1);
+      UInt const len = LEN_LIST(nbs);
+      for (UInt j = 1; j <= len; j++) {
+        UInt const y = lookup[INT_INTOBJ(ELM_LIST(nbs, j)) - 1];
+        if (stamp[y] != x) {
+          stamp[y] = x;
+          buf[k++] = y;
+        }
+      }
+    }
+    qsort(buf, k, sizeof(UInt), cmp_uint);
+    Obj row = new_row(k);
+    for (UInt j = 0; j < k; j++) {
+      SET_ELM_PLIST(row, j + 1, INTOBJ_INT(buf[j]));
+    }
+    SET_ELM_PLIST(new_out, x, row);
+    CHANGED_BAG(new_out);
+    SET_ELM_PLIST(new_vl, x, labels);
+    CHANGED_BAG(new_vl);
+  }
+  free(lookup);
+  free(size);
+  free(start);
+  free(members);
+  free(stamp);
+  free(buf);
+
+  Obj result = NEW_PREC(2);
+  AssPRec(result, RNamName("out"), new_out);
+  AssPRec(result, RNamName("vertex_labels"), new_vl);
+  return result;
+}
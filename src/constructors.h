@@ -0,0 +1,25 @@
+/********************************************************************************
+**
+*A  constructors.h         line digraphs, quotients, and induced subdigraphs
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_CONSTRUCTORS_H_
+#define DIGRAPHS_SRC_CONSTRUCTORS_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_LINE_DIGRAPH(Obj self, Obj D);
+Obj FuncDIGRAPH_LINE_UNDIRECTED_DIGRAPH(Obj self, Obj D);
+Obj FuncDIGRAPH_INDUCED_SUBDIGRAPH(Obj self, Obj D, Obj list, Obj edge_labels);
+Obj FuncDIGRAPH_QUOTIENT_DIGRAPH(Obj self,
+                                 Obj D,
+                                 Obj partition,
+                                 Obj vertex_labels);
+
+#endif  // DIGRAPHS_SRC_CONSTRUCTORS_H_
@@ -0,0 +1,164 @@
+/********************************************************************************
+**
+*A  csr.c                  compressed sparse row adjacency
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "csr.h"
+
+// C headers
+#include <stdlib.h>  // for free
+
+// GAP headers
+#include "gap-includes.h"  // for ELM_PLIST, LEN_PLIST, . . .
+
+// Digraphs headers
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "digraphs.h"        // for DigraphNrVertices, FuncOutNeighbours
+#include "safemalloc.h"      // for safe_malloc
+
+static CSR* new_csr(UInt const nr_vertices, UInt const nr_edges) {
+  CSR* csr         = safe_malloc(sizeof(CSR));
+  csr->nr_vertices = nr_vertices;
+  csr->nr_edges    = nr_edges;
+  csr->offsets     = safe_calloc(nr_vertices + 1, sizeof(UInt));
+  csr->targets     = safe_malloc((nr_edges > 0 ? nr_edges : 1) * sizeof(UInt));
+  return csr;
+}
+
+CSR* new_csr_out_neighbours(Obj D) {
+  UInt const n   = DigraphNrVertices(D);
+  Obj const  out = FuncOutNeighbours(0L, D);
+  UInt       m   = 0;
+  for (UInt v = 1; v <= n; v++) {
+    Obj nbs = ELM_PLIST(out, v);
+    PLAIN_LIST(nbs);
+    m += LEN_PLIST(nbs);
+  }
+  CSR* csr = new_csr(n, m);
+  UInt k   = 0;
+  for (UInt v = 1; v <= n; v++) {
+    Obj const  nbs = ELM_PLIST(out, v);
+    UInt const len = LEN_PLIST(nbs);
+    csr->offsets[v - 1] = k;
+    for (UInt j = 1; j <= len; j++) {
+      csr->targets[k++] = INT_INTOBJ(ELM_PLIST(nbs, j)) - 1;
+    }
+  }
+  csr->offsets[n] = k;
+  DIGRAPHS_ASSERT(k == m);
+  return csr;
+}
+
+CSR* new_csr_reverse(CSR const* const csr) {
+  UInt const n   = csr->nr_vertices;
+  CSR*       rev = new_csr(n, csr->nr_edges);
+  // Count the in-degrees, shifted by one so that the prefix sums give the
+  // offsets.
+  for (UInt e = 0; e < csr->nr_edges; e++) {
+    rev->offsets[csr->targets[e] + 1]++;
+  }
+  for (UInt v = 0; v < n; v++) {
+    rev->offsets[v + 1] += rev->offsets[v];
+  }
+  UInt* pos = safe_malloc((n > 0 ? n : 1) * sizeof(UInt));
+  for (UInt v = 0; v < n; v++) {
+    pos[v] = rev->offsets[v];
+  }
+  // Sources are visited in increasing order, so every row of <rev> is sorted
+  for (UInt v = 0; v < n; v++) {
+    for (UInt e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+      rev->targets[pos[csr->targets[e]]++] = v;
+    }
+  }
+  free(pos);
+  return rev;
+}
+
+CSR* new_csr_sorted(CSR const* const csr) {
+  CSR* in     = new_csr_reverse(csr);
+  CSR* sorted = new_csr_reverse(in);
+  free_csr(in);
+  return sorted;
+}
+
+CSR* new_csr_in_neighbours(Obj D) {
+  CSR* out = new_csr_out_neighbours(D);
+  CSR* in  = new_csr_reverse(out);
+  free_csr(out);
+  return in;
+}
+
+CSR* new_csr_symmetric(Obj D, bool const loops) {
+  CSR* out = new_csr_out_neighbours(D);
+  CSR* in  = new_csr_reverse(out);
+
+  UInt const n   = out->nr_vertices;
+  CSR*       sym = new_csr(n, 2 * out->nr_edges);
+  UInt       k   = 0;
+  for (UInt v = 0; v < n; v++) {
+    sym->offsets[v] = k;
+    for (UInt e = out->offsets[v]; e < out->offsets[v + 1]; e++) {
+      if (loops || out->targets[e] != v) {
+        sym->targets[k++] = out->targets[e];
+      }
+    }
+    for (UInt e = in->offsets[v]; e < in->offsets[v + 1]; e++) {
+      if (loops || in->targets[e] != v) {
+        sym->targets[k++] = in->targets[e];
+      }
+    }
+  }
+  sym->offsets[n] = k;
+  sym->nr_edges   = k;
+  free_csr(out);
+  free_csr(in);
+  return sym;
+}
+
+CSR* new_csr_simple_symmetric(Obj D) {
+  CSR* out = new_csr_out_neighbours(D);
+  CSR* in  = new_csr_reverse(out);
+  // The reverse of the reverse has the same edges as <out>, but every row is
+  // sorted, and so the rows of <in> and <sorted> can be merged.
+  CSR* sorted = new_csr_reverse(in);
+  free_csr(out);
+
+  UInt const n   = sorted->nr_vertices;
+  CSR*       sym = new_csr(n, 2 * sorted->nr_edges);
+  UInt       k   = 0;
+  for (UInt v = 0; v < n; v++) {
+    sym->offsets[v] = k;
+    UInt i          = sorted->offsets[v];
+    UInt j          = in->offsets[v];
+    while (i < sorted->offsets[v + 1] || j < in->offsets[v + 1]) {
+      UInt w;
+      if (j == in->offsets[v + 1]
+          || (i < sorted->offsets[v + 1]
+              && sorted->targets[i] <= in->targets[j])) {
+        w = sorted->targets[i++];
+      } else {
+        w = in->targets[j++];
+      }
+      if (w != v && (k == sym->offsets[v] || sym->targets[k - 1] != w)) {
+        sym->targets[k++] = w;
+      }
+    }
+  }
+  sym->offsets[n] = k;
+  sym->nr_edges   = k;
+  free_csr(sorted);
+  free_csr(in);
+  return sym;
+}
+
+void free_csr(CSR* const csr) {
+  DIGRAPHS_ASSERT(csr != NULL);
+  free(csr->offsets);
+  free(csr->targets);
+  free(csr);
+}
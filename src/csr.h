@@ -0,0 +1,73 @@
+/********************************************************************************
+**
+*A  csr.h                  compressed sparse row adjacency
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_CSR_H_
+#define DIGRAPHS_SRC_CSR_H_
+
+// C headers
+#include <stdbool.h>  // for bool
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt
+
+// Digraphs headers
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+
+// This file contains a read-only compressed sparse row (CSR) copy of the
+// adjacency of a digraph, for use in kernel algorithms that traverse the whole
+// digraph, possibly many times. The neighbours of the vertex <v> (indexed from
+// 0) are:
+//
+//   targets[offsets[v]], ..., targets[offsets[v + 1] - 1]
+//
+// in the same order as in the GAP level list of (out- or in-) neighbours.
+// Multiple edges are retained.
+
+struct csr_struct {
+  UInt  nr_vertices;
+  UInt  nr_edges;
+  UInt* offsets;  // length nr_vertices + 1
+  UInt* targets;  // length nr_edges
+};
+
+typedef struct csr_struct CSR;
+
+//! Returns a CSR containing the out-neighbours of the digraph \p D.
+CSR* new_csr_out_neighbours(Obj D);
+
+//! Returns a CSR containing the in-neighbours of the digraph \p D.
+CSR* new_csr_in_neighbours(Obj D);
+
+//! Returns a CSR containing the out- and in-neighbours of every vertex of the
+//! digraph \p D, i.e. the adjacency of its symmetric closure. Loops are
+//! included if and only if \p loops is \c true.
+CSR* new_csr_symmetric(Obj D, bool const loops);
+
+//! Returns a CSR containing the adjacency of the symmetric closure of the
+//! digraph \p D without loops or multiple edges, with every row sorted.
+CSR* new_csr_simple_symmetric(Obj D);
+
+//! Returns a CSR containing the in-neighbours of the CSR \p csr.
+CSR* new_csr_reverse(CSR const* const csr);
+
+//! Returns a CSR with the same rows as the CSR \p csr, but with every row
+//! sorted.
+CSR* new_csr_sorted(CSR const* const csr);
+
+//! Free a CSR.
+void free_csr(CSR* const csr);
+
+//! Returns the number of neighbours of the vertex \p v.
+static inline UInt degree_csr(CSR const* const csr, UInt const v) {
+  DIGRAPHS_ASSERT(v < csr->nr_vertices);
+  return csr->offsets[v + 1] - csr->offsets[v];
+}
+
+#endif  // DIGRAPHS_SRC_CSR_H_
@@ -0,0 +1,326 @@
+/********************************************************************************
+**
+*A  cycles.c               chordless cycles and cycle bases
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "cycles.h"
+
+// C headers
+#include <stdbool.h>  // for false, true, bool
+#include <stdlib.h>   // for free
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt, NEW_PLIST, . . .
+
+// Digraphs headers
+#include "csr.h"             // for CSR, new_csr_out_neighbours, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "digraphs.h"        // for DigraphNrEdges
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+////////////////////////////////////////////////////////////////////////////////
+// Chordless cycles
+////////////////////////////////////////////////////////////////////////////////
+
+// This is the algorithm of Dias, Castonguay, Longo, and Jradi, see:
+//
+//   https://arxiv.org/pdf/1404.7610
+//
+// which only ever extends chordless paths, and so never generates a cycle
+// with a chord. Every chordless cycle of length at least 4 is found by
+// extending a chordless path <x, u, y> where label(u) < label(x) < label(y),
+// and the vertices appended to it have labels greater than label(u). The
+// paths are extended iteratively, so that the depth of the search is not
+// limited by the size of the C stack.
+//
+// The vertices are visited in the same order as in the original GAP level
+// implementation of DigraphAllChordlessCycles, and so the cycles are found in
+// the same order.
+
+// Returns true if [u, v] is an edge of the digraph whose out-neighbours (with
+// every row sorted) are <sorted>.
+static bool is_edge(CSR const* const sorted, UInt const u, UInt const v) {
+  UInt lo = sorted->offsets[u], hi = sorted->offsets[u + 1];
+  while (lo < hi) {
+    UInt const mid = lo + (hi - lo) / 2;
+    if (sorted->targets[mid] < v) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo < sorted->offsets[u + 1] && sorted->targets[lo] == v;
+}
+
+static inline void block_neighbours(CSR const* const g,
+                                    UInt* const      blocked,
+                                    UInt const       v) {
+  for (UInt e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+    blocked[g->targets[e]]++;
+  }
+}
+
+static inline void unblock_neighbours(CSR const* const g,
+                                      UInt* const      blocked,
+                                      UInt const       v) {
+  for (UInt e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+    DIGRAPHS_ASSERT(blocked[g->targets[e]] > 0);
+    blocked[g->targets[e]]--;
+  }
+}
+
+static void push_cycle(Obj cycles, UInt const* const path, UInt const len) {
+  Obj cycle = NEW_PLIST(T_PLIST_CYC, len);
+  SET_LEN_PLIST(cycle, len);
+  for (UInt i = 0; i < len; i++) {
+    SET_ELM_PLIST(cycle, i + 1, INTOBJ_INT(path[i] + 1));
+  }
+  PushPlist(cycles, cycle);
+}
+
+// Returns the number of chordless paths <x, u, y> with the labels of u, x, y
+// increasing, and if <triples> is not NULL, then these paths are written into
+// <triples>, and the triangles found are pushed onto <cycles>.
+static UInt triplets(CSR const* const  sorted,
+                     UInt const* const label,
+                     UInt* const       triples,
+                     Obj               cycles) {
+  UInt nr = 0;
+  for (UInt u = 0; u < sorted->nr_vertices; u++) {
+    UInt const first = sorted->offsets[u], last = sorted->offsets[u + 1];
+    for (UInt a = first; a < last; a++) {
+      for (UInt b = a + 1; b < last; b++) {
+        UInt const p = sorted->targets[a], q = sorted->targets[b];
+        UInt       x, y;
+        if (label[u] < label[p] && label[p] < label[q]) {
+          x = p;
+          y = q;
+        } else if (label[u] < label[q] && label[q] < label[p]) {
+          x = q;
+          y = p;
+        } else {
+          continue;
+        }
+        if (!is_edge(sorted, x, y)) {
+          if (triples != NULL) {
+            triples[3 * nr]     = x;
+            triples[3 * nr + 1] = u;
+            triples[3 * nr + 2] = y;
+          }
+          nr++;
+        } else if (triples != NULL) {
+          UInt const triangle[3] = {x, u, y};
+          push_cycle(cycles, triangle, 3);
+        }
+      }
+    }
+  }
+  return nr;
+}
+
+// The argument <D> must be a symmetric digraph without loops or multiple
+// edges, and <labels> a list of the labels of its vertices, which must be a
+// permutation of the vertices. Returns the list of chordless cycles of <D>.
+Obj FuncDIGRAPH_ALL_CHORDLESS_CYCLES(Obj self, Obj D, Obj labels) {
+  CSR* g = new_csr_out_neighbours(D);
+  // Since <D> is symmetric, its in-neighbours are its out-neighbours, and the
+  // rows of <sorted> are sorted.
+  CSR*       sorted = new_csr_reverse(g);
+  UInt const n      = g->nr_vertices;
+  UInt const size   = (n > 0 ? n : 1) + 1;
+
+  UInt* label   = safe_malloc(size * sizeof(UInt));
+  UInt* blocked = safe_calloc(size, sizeof(UInt));
+  UInt* path    = safe_malloc(size * sizeof(UInt));
+  UInt* next    = safe_malloc(size * sizeof(UInt));
+  for (UInt v = 0; v < n; v++) {
+    label[v] = INT_INTOBJ(ELM_LIST(labels, v + 1));
+  }
+
+  Obj        cycles  = NEW_PLIST(T_PLIST, 0);
+  UInt const nr      = triplets(sorted, label, NULL, cycles);
+  UInt*      triples = safe_malloc((3 * nr + 1) * sizeof(UInt));
+  triplets(sorted, label, triples, cycles);
+
+  // The triples are extended in reverse order.
+  for (UInt t = nr; t-- > 0;) {
+    UInt const u   = triples[3 * t + 1];
+    UInt const key = label[u];
+    block_neighbours(g, blocked, u);
+    path[0]  = triples[3 * t];
+    path[1]  = u;
+    path[2]  = triples[3 * t + 2];
+    UInt len = 3;
+    block_neighbours(g, blocked, path[2]);
+    next[2] = g->offsets[path[2]];
+
+    while (len > 2) {
+      UInt const w = path[len - 1];
+      if (next[len - 1] < g->offsets[w + 1]) {
+        UInt const v = g->targets[next[len - 1]++];
+        if (label[v] > key && blocked[v] == 1) {
+          path[len] = v;
+          if (is_edge(sorted, v, path[0])) {
+            push_cycle(cycles, path, len + 1);
+          } else {
+            len++;
+            block_neighbours(g, blocked, v);
+            next[len - 1] = g->offsets[v];
+          }
+        }
+      } else {
+        unblock_neighbours(g, blocked, w);
+        len--;
+      }
+    }
+    unblock_neighbours(g, blocked, u);
+  }
+
+  free(label);
+  free(blocked);
+  free(path);
+  free(next);
+  free(triples);
+  free_csr(g);
+  free_csr(sorted);
+  return cycles;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Cycle basis
+////////////////////////////////////////////////////////////////////////////////
+
+// The cycle basis is obtained from a spanning forest of the underlying
+// undirected graph of the digraph, which is found by a stack-based search
+// that considers, for every vertex <u> removed from the stack, the out-edges
+// and then the in-edges of <u>. Every edge not in the spanning forest, which
+// joins <u> to a vertex <v> still on the stack, determines a fundamental
+// cycle: the path in the forest from <u> to the parent of <v>, together with
+// the edge itself and the edge from the parent of <v> to <v>. The edges are
+// numbered in the order given by the out-neighbours of the digraph, and each
+// cycle is written directly into the bits of a GF(2) vector of length equal
+// to the number of edges.
+
+// The argument <D> must be a digraph without loops or multiple edges, such
+// that at most one of [u, v] and [v, u] is an edge for all vertices <u> and
+// <v>, and <zero> must be a zero GF(2) vector, in IsGF2VectorRep, with length
+// equal to the number of edges of <D>. Returns the list of vectors of a cycle
+// basis of <D>, in the same format as DigraphCycleBasis.
+Obj FuncDIGRAPH_CYCLE_BASIS(Obj self, Obj D, Obj zero) {
+  if (!IS_GF2VEC_REP(zero)) {
+    ErrorQuit("the 2nd argument <zero> must be a GF(2) vector in "
+              "IsGF2VectorRep, not %s,",
+              (Int) TNAM_OBJ(zero),
+              0L);
+  } else if (LEN_GF2VEC(zero) != DigraphNrEdges(D)) {
+    ErrorQuit("the 2nd argument <zero> must have length %d, found %d,",
+              DigraphNrEdges(D),
+              LEN_GF2VEC(zero));
+  }
+  for (UInt i = 0; i < NUMBER_BLOCKS_GF2VEC(zero); i++) {
+    if (BLOCKS_GF2VEC(zero)[i] != 0) {
+      ErrorQuit("the 2nd argument <zero> must be a zero vector,", 0L, 0L);
+    }
+  }
+
+  CSR*       out  = new_csr_out_neighbours(D);
+  UInt const n    = out->nr_vertices;
+  UInt const m    = out->nr_edges;
+  UInt const size = (n > 0 ? n : 1) + 1;
+
+  // The in-edges of every vertex, and their positions in <out>, in the same
+  // order as the GAP level in-neighbours.
+  UInt* in_offsets = safe_calloc(size, sizeof(UInt));
+  UInt* in_sources = safe_malloc((m > 0 ? m : 1) * sizeof(UInt));
+  UInt* in_edges   = safe_malloc((m > 0 ? m : 1) * sizeof(UInt));
+  for (UInt e = 0; e < m; e++) {
+    in_offsets[out->targets[e] + 1]++;
+  }
+  for (UInt v = 0; v < n; v++) {
+    in_offsets[v + 1] += in_offsets[v];
+  }
+  UInt* fill = safe_malloc(size * sizeof(UInt));
+  for (UInt v = 0; v < n; v++) {
+    fill[v] = in_offsets[v];
+  }
+  for (UInt u = 0; u < n; u++) {
+    for (UInt e = out->offsets[u]; e < out->offsets[u + 1]; e++) {
+      UInt const v       = out->targets[e];
+      in_sources[fill[v]] = u;
+      in_edges[fill[v]++] = e;
+    }
+  }
+  free(fill);
+
+  // edge[v] is the position (starting at 1) of the edge joining <v> to
+  // parent[v] in the spanning forest, and 0 if <v> is a root.
+  UInt* edge     = safe_malloc(size * sizeof(UInt));
+  UInt* parent   = safe_malloc(size * sizeof(UInt));
+  UInt* stack    = safe_malloc(size * sizeof(UInt));
+  bool* visited  = safe_calloc(size, sizeof(bool));
+  bool* in_stack = safe_calloc(size, sizeof(bool));
+
+  Obj basis = NEW_PLIST(T_PLIST, 0);
+
+  for (UInt s = 0; s < n; s++) {
+    if (visited[s]) {
+      continue;
+    }
+    visited[s]  = true;
+    edge[s]     = 0;
+    parent[s]   = s;
+    UInt top    = 0;
+    stack[top++] = s;
+    in_stack[s]  = true;
+    while (top > 0) {
+      UInt const u = stack[--top];
+      in_stack[u]  = false;
+      UInt const nr_out = out->offsets[u + 1] - out->offsets[u];
+      UInt const nr     = nr_out + in_offsets[u + 1] - in_offsets[u];
+      for (UInt k = 0; k < nr; k++) {
+        UInt v, i;
+        if (k < nr_out) {
+          i = out->offsets[u] + k;
+          v = out->targets[i];
+        } else {
+          UInt const j = in_offsets[u] + k - nr_out;
+          v            = in_sources[j];
+          i            = in_edges[j];
+        }
+        i++;
+        if (!visited[v]) {
+          visited[v]   = true;
+          edge[v]      = i;
+          parent[v]    = u;
+          stack[top++] = v;
+          in_stack[v]  = true;
+        } else if (in_stack[v]) {
+          Obj vec = SHALLOW_COPY_OBJ(zero);
+          for (UInt w = u; w != parent[v]; w = parent[w]) {
+            DIGRAPHS_ASSERT(edge[w] != 0);
+            BLOCK_ELM_GF2VEC(vec, edge[w]) |= MASK_POS_GF2VEC(edge[w]);
+          }
+          BLOCK_ELM_GF2VEC(vec, i) |= MASK_POS_GF2VEC(i);
+          BLOCK_ELM_GF2VEC(vec, edge[v]) |= MASK_POS_GF2VEC(edge[v]);
+          PushPlist(basis, vec);
+        }
+      }
+    }
+  }
+
+  free(in_offsets);
+  free(in_sources);
+  free(in_edges);
+  free(edge);
+  free(parent);
+  free(stack);
+  free(visited);
+  free(in_stack);
+  free_csr(out);
+  return basis;
+}
@@ -0,0 +1,20 @@
+/********************************************************************************
+**
+*A  cycles.h               chordless cycles and cycle bases
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_CYCLES_H_
+#define DIGRAPHS_SRC_CYCLES_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_ALL_CHORDLESS_CYCLES(Obj self, Obj D, Obj labels);
+Obj FuncDIGRAPH_CYCLE_BASIS(Obj self, Obj D, Obj zero);
+
+#endif  // DIGRAPHS_SRC_CYCLES_H_
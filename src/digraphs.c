@@ -16,16 +16,29 @@
 
 #include <stdbool.h>  // for false, true, bool
 #include <stdint.h>   // for uint64_t
-#include <stdlib.h>   // for NULL, free
-#include <string.h>   // for memcpy
+#include <stdlib.h>   // for NULL, free, qsort
+#include <string.h>   // for memcpy, memset
 
+#include "bfs.h"              // for FuncDIGRAPH_BFS_LAYERS, . . .
+#include "biconnected.h"      // for FuncDIGRAPH_BICONNECTIVITY
 #include "bliss-includes.h"   // for bliss stuff
+#include "circuits.h"         // for FuncDIGRAPH_SIMPLE_CIRCUITS
 #include "cliques.h"          // for FuncDIGRAPHS_FREE_CLIQUES_DATA
+#include "colouring.h"        // for FuncDIGRAPH_DSATUR_COLOURING, . . .
+#include "constructors.h"     // for FuncDIGRAPH_LINE_DIGRAPH, . . .
+#include "cycles.h"           // for FuncDIGRAPH_CYCLE_BASIS, . . .
 #include "digraphs-config.h"  // for DIGRAPHS_WITH_INCLUDED_BLISS
 #include "digraphs-debug.h"   // for DIGRAPHS_ASSERT
+#include "dominators.h"       // for FuncDIGRAPH_DOMINATOR_TREES
+#include "generate.h"         // for FuncDIGRAPHS_GENERATE
 #include "homos.h"            // for FuncHomomorphismDigraphsFinder
+#include "matching.h"         // for FuncDIGRAPH_MAXIMUM_MATCHING, . . .
+#include "mcs.h"              // for FuncDIGRAPH_MAXIMUM_COMMON_INDUCED_SUB...
+#include "orbits.h"           // for FuncDIGRAPH_ORBITS, . . .
 #include "planar.h"           // for FUNC_IS_PLANAR, . . .
+#include "products.h"         // for FuncDIGRAPH_PRODUCT
 #include "safemalloc.h"       // for safe_malloc
+#include "stab-chain.h"       // for FuncDIGRAPH_STAB_CHAIN
 
 #undef PACKAGE
 #undef PACKAGE_BUGREPORT
@@ -40,6 +53,8 @@ Obj IsDigraph;
 Obj IsMultiDigraph;
 Obj IsDigraphEdge;
 Obj DIGRAPHS_ValidateVertexColouring;
+Obj DIGRAPHS_ExpandOutNeighbours;
+Obj DIGRAPHS_ExpandPersistentOutNeighbours;
 Obj Infinity;
 Obj IsSymmetricDigraph;
 Obj GeneratorsOfGroup;
@@ -58,6 +73,7 @@ Obj OnTuples;
 Obj Group;
 Obj ClosureGroup;
 Obj InfoWarning;
+Obj ValueOption;
 
 static inline bool IsAttributeStoringRep(Obj o) {
   return (CALL_1ARGS(IsAttributeStoringRepObj, o) == True ? true : false);
@@ -69,20 +85,48 @@ static Obj FuncDIGRAPH_NR_VERTICES(Obj self, Obj D) {
   return INTOBJ_INT(DigraphNrVertices(D));
 }
 
+static Int RNamOutNeighbours               = 0;
+static Int RNamRepresentativeOutNeighbours = 0;
+static Int RNamPersistentOutNeighbours     = 0;
+static Int RNamDigraphNrVertices           = 0;
+
+static void InitRNams(void) {
+  if (!RNamOutNeighbours) {
+    RNamOutNeighbours               = RNamName("OutNeighbours");
+    RNamRepresentativeOutNeighbours = RNamName("RepresentativeOutNeighbours");
+    RNamPersistentOutNeighbours     = RNamName("PersistentOutNeighbours");
+    RNamDigraphNrVertices           = RNamName("DigraphNrVertices");
+  }
+}
+
 Int DigraphNrVertices(Obj D) {
+  InitRNams();
+  // Avoid expanding the out-neighbours of a symmetry-compressed digraph
+  if (!IsbPRec(D, RNamOutNeighbours) && IsbPRec(D, RNamDigraphNrVertices)) {
+    return INT_INTOBJ(ElmPRec(D, RNamDigraphNrVertices));
+  }
   return LEN_LIST(FuncOutNeighbours(0L, D));
 }
 
-static Int RNamOutNeighbours = 0;
-
 Obj FuncOutNeighbours(Obj self, Obj D) {
-  if (!RNamOutNeighbours) {
-    RNamOutNeighbours = RNamName("OutNeighbours");
-  }
+  InitRNams();
   if (CALL_1ARGS(IsDigraph, D) != True) {
     ErrorQuit("expected a digraph, not a %s", (Int) TNAM_OBJ(D), 0L);
   } else if (IsbPRec(D, RNamOutNeighbours)) {
     return ElmPRec(D, RNamOutNeighbours);
+  } else if (IsbPRec(D, RNamRepresentativeOutNeighbours)) {
+    // A symmetry-compressed digraph, the out-neighbours of every vertex are
+    // computed from those of the orbit representatives the first time they
+    // are required, see DIGRAPHS_SymmetryCompressedDigraph.
+    Obj out = CALL_1ARGS(DIGRAPHS_ExpandOutNeighbours, D);
+    AssPRec(D, RNamOutNeighbours, out);
+    return out;
+  } else if (IsbPRec(D, RNamPersistentOutNeighbours)) {
+    // A digraph obtained by editing an immutable digraph, whose out-neighbours
+    // are stored in a persistent vector, see DIGRAPHS_PersistentDigraph.
+    Obj out = CALL_1ARGS(DIGRAPHS_ExpandPersistentOutNeighbours, D);
+    AssPRec(D, RNamOutNeighbours, out);
+    return out;
   } else {
     ErrorQuit(
         "the `OutNeighbours` component is not set for this digraph,", 0L, 0L);
@@ -1494,6 +1538,123 @@ static Obj FuncDIGRAPH_HASH(Obj self, Obj digraph) {
   return INTOBJ_INT(h);
 }
 
+static int cmp_uint(void const* a, void const* b) {
+  UInt const x = *((UInt const*) a);
+  UInt const y = *((UInt const*) b);
+  return (x > y) - (x < y);
+}
+
+// Returns the number of distinct entries in colour[0 .. n - 1], using tmp as
+// scratch space.
+static UInt nr_distinct_colours(UInt const n, UInt const* colour, UInt* tmp) {
+  UInt i, nr;
+
+  if (n == 0) {
+    return 0;
+  }
+  memcpy(tmp, colour, n * sizeof(UInt));
+  qsort(tmp, n, sizeof(UInt), cmp_uint);
+  nr = 1;
+  for (i = 1; i < n; i++) {
+    nr += (tmp[i] != tmp[i - 1]);
+  }
+  return nr;
+}
+
+// The maximum number of rounds of colour refinement performed by
+// DIGRAPH_ISOMORPHISM_INVARIANT. Each round takes O(m + n log(n)) time, and
+// refining until the colouring is stable can take about n / 2 rounds, for
+// example for a chain. Digraphs which are not distinguished after this many
+// rounds are left to the canonical labelling.
+#define MAX_REFINEMENT_ROUNDS 8
+
+// Returns a hash of the colouring of the vertices of <digraph> obtained from
+// the initial colouring <colours> (or the colouring where every vertex has the
+// same colour if <colours> is Fail) by <rounds> rounds of colour refinement
+// (the 1-dimensional Weisfeiler-Leman algorithm), or by refining until the
+// colouring is stable, but for at most MAX_REFINEMENT_ROUNDS rounds, if
+// <rounds> is 0. In each round, the new colour of a vertex is a hash of its
+// old colour, and the multisets of the old colours of its out- and
+// in-neighbours. In particular, after 1 round the colour of a vertex
+// determines its out- and in-degree, and after 2 rounds it also determines the
+// multisets of the degrees of its neighbours.
+//
+// The colours are hash values, rather than the indices of the colour classes,
+// and so the value returned only depends on the isomorphism class of the
+// coloured digraph. Refining stops early if a round does not split any colour
+// class, and the number of rounds is included in the hash.
+static Obj FuncDIGRAPH_ISOMORPHISM_INVARIANT(Obj self,
+                                             Obj digraph,
+                                             Obj colours,
+                                             Obj rounds) {
+  UInt  n, i, j, r, max_rounds, nr, nr_classes, new_nr_classes, h, w;
+  UInt *colour, *new_colour, *out_acc, *in_acc, *tmp, *swap;
+  Obj   out, a;
+
+  n          = DigraphNrVertices(digraph);
+  out        = FuncOutNeighbours(self, digraph);
+  max_rounds = INT_INTOBJ(rounds);
+  if (max_rounds == 0 || max_rounds > MAX_REFINEMENT_ROUNDS) {
+    max_rounds = MAX_REFINEMENT_ROUNDS;
+  }
+  DIGRAPHS_ASSERT(colours == Fail || (UInt) LEN_LIST(colours) == n);
+
+  colour     = safe_malloc((n + 1) * sizeof(UInt));
+  new_colour = safe_malloc((n + 1) * sizeof(UInt));
+  out_acc    = safe_malloc((n + 1) * sizeof(UInt));
+  in_acc     = safe_malloc((n + 1) * sizeof(UInt));
+  tmp        = safe_malloc((n + 1) * sizeof(UInt));
+
+  for (i = 0; i < n; i++) {
+    colour[i] = colours == Fail ? 0 : INT_INTOBJ(ELM_LIST(colours, i + 1));
+  }
+  nr_classes = nr_distinct_colours(n, colour, tmp);
+
+  for (r = 0; r < max_rounds; r++) {
+    memset(out_acc, 0, n * sizeof(UInt));
+    memset(in_acc, 0, n * sizeof(UInt));
+    for (i = 0; i < n; i++) {
+      a  = ELM_PLIST(out, i + 1);
+      nr = LEN_PLIST(a);
+      for (j = 1; j <= nr; j++) {
+        w = INT_INTOBJ(ELM_PLIST(a, j)) - 1;
+        out_acc[i] += fmix(colour[w]);
+        in_acc[w] += fmix(colour[i] + 0x9e3779b9);
+      }
+    }
+    for (i = 0; i < n; i++) {
+      h             = fmix(colour[i] + 0x9e3779b9);
+      h             = fmix(h + out_acc[i]);
+      new_colour[i] = fmix(h + in_acc[i]);
+    }
+    swap       = colour;
+    colour     = new_colour;
+    new_colour = swap;
+    new_nr_classes = nr_distinct_colours(n, colour, tmp);
+    if (new_nr_classes == nr_classes) {
+      r++;
+      break;
+    }
+    nr_classes = new_nr_classes;
+  }
+
+  h = 0;
+  for (i = 0; i < n; i++) {
+    h += fmix(colour[i]);
+  }
+  h = fmix(h + r);
+
+  free(colour);
+  free(new_colour);
+  free(out_acc);
+  free(in_acc);
+  free(tmp);
+  // Discard the low bits of <h>, so that the value fits in a small integer
+  // (which has 60 bits on 64-bit systems and 28 bits on 32-bit systems) and is
+  // non-negative.
+  return INTOBJ_INT(h >> 4);
+}
+
 static Obj FuncDIGRAPH_EQUALS(Obj self, Obj digraph1, Obj digraph2) {
   UInt i, n1, n2, m1, m2;
   Obj  out1, out2, a, b;
@@ -1666,6 +1827,7 @@ static Obj FuncDIGRAPH_LT(Obj self, Obj digraph1, Obj digraph2) {
 
 // bliss
 
+#ifndef DIGRAPHS_WITH_INCLUDED_BLISS
 static BlissGraph* buildBlissMultiDigraph(Obj digraph) {
   UInt        n, i, j, k, l, nr;
   Obj         adji, adj;
@@ -1688,6 +1850,303 @@ static BlissGraph* buildBlissMultiDigraph(Obj digraph) {
   }
   return graph;
 }
+#endif
+
+#ifdef DIGRAPHS_WITH_INCLUDED_BLISS
+// When the included bliss is used, every graph is passed to bliss by writing
+// it into the arrays below, and then assigning it to one of two bliss graphs,
+// which are refilled in place by every call, rather than created and released
+// each time. The arrays only ever grow, and so for many small digraphs there
+// are no allocations at all.
+static BlissGraph*   BLISS_GRAPH           = NULL;  // undirected
+static BlissGraph*   BLISS_DIGRAPH         = NULL;  // directed
+static unsigned int* BLISS_COLOURS         = NULL;  // the vertex colours
+static unsigned int* BLISS_OFFSETS         = NULL;  // the list offsets
+static unsigned int* BLISS_POS             = NULL;  // the next list positions
+static unsigned int* BLISS_TARGETS         = NULL;  // the adjacency lists
+static unsigned int* BLISS_EDGE_COLOURS    = NULL;
+static UInt          BLISS_VERTEX_CAPACITY = 0;
+static UInt          BLISS_TARGET_CAPACITY = 0;
+
+// Ensure that the arrays above have room for a graph with <nr_vertices>
+// vertices and <nr_targets> entries in its adjacency lists. The contents of
+// the arrays are not preserved.
+static void ensureBlissCapacity(UInt nr_vertices, UInt nr_targets) {
+  if (nr_vertices + 1 > BLISS_VERTEX_CAPACITY) {
+    BLISS_VERTEX_CAPACITY = MAX(nr_vertices + 1, 2 * BLISS_VERTEX_CAPACITY);
+    free(BLISS_COLOURS);
+    free(BLISS_OFFSETS);
+    free(BLISS_POS);
+    BLISS_COLOURS = safe_malloc(BLISS_VERTEX_CAPACITY * sizeof(unsigned int));
+    BLISS_OFFSETS = safe_malloc(BLISS_VERTEX_CAPACITY * sizeof(unsigned int));
+    BLISS_POS     = safe_malloc(BLISS_VERTEX_CAPACITY * sizeof(unsigned int));
+  }
+  if (nr_targets + 1 > BLISS_TARGET_CAPACITY) {
+    BLISS_TARGET_CAPACITY = MAX(nr_targets + 1, 2 * BLISS_TARGET_CAPACITY);
+    free(BLISS_TARGETS);
+    free(BLISS_EDGE_COLOURS);
+    BLISS_TARGETS = safe_malloc(BLISS_TARGET_CAPACITY * sizeof(unsigned int));
+    BLISS_EDGE_COLOURS =
+        safe_malloc(BLISS_TARGET_CAPACITY * sizeof(unsigned int));
+  }
+}
+
+// Assign the undirected graph with <N> vertices, and the colours (or NULL)
+// and adjacency lists in the arrays above, to BLISS_GRAPH, and return it.
+static BlissGraph* assignBlissGraph(UInt N, unsigned int* colours) {
+  if (BLISS_GRAPH == NULL) {
+    BLISS_GRAPH = bliss_digraphs_new(0);
+  }
+  bliss_digraphs_assign_csr(
+      BLISS_GRAPH, N, colours, BLISS_OFFSETS, BLISS_TARGETS);
+  return BLISS_GRAPH;
+}
+
+// Turn the degrees of the vertices 0, ..., N - 1, stored in BLISS_OFFSETS[1],
+// ..., BLISS_OFFSETS[N], into the offsets of their adjacency lists, and copy
+// the offsets into BLISS_POS.
+static void blissDegreesToOffsets(UInt N) {
+  UInt i;
+  BLISS_OFFSETS[0] = 0;
+  for (i = 1; i <= N; i++) {
+    BLISS_OFFSETS[i] += BLISS_OFFSETS[i - 1];
+  }
+  memcpy(BLISS_POS, BLISS_OFFSETS, N * sizeof(unsigned int));
+}
+
+// Add the undirected edge {u, v} to the adjacency lists in BLISS_TARGETS, at
+// the positions given by BLISS_POS, or, if <count> is true, only increase the
+// degrees of u and v stored in BLISS_OFFSETS.
+static inline void addBlissEdge(bool count, UInt u, UInt v) {
+  if (count) {
+    BLISS_OFFSETS[u + 1]++;
+    BLISS_OFFSETS[v + 1]++;
+  } else {
+    BLISS_TARGETS[BLISS_POS[u]++] = v;
+    BLISS_TARGETS[BLISS_POS[v]++] = u;
+  }
+}
+
+// Write the colours in <vert_colours> into BLISS_COLOURS, and return it, or
+// return NULL if <vert_colours> is Fail. The capacity of BLISS_COLOURS must
+// be at least <n>.
+static unsigned int* blissVertexColours(Obj vert_colours, UInt n) {
+  UInt i;
+
+  if (vert_colours == Fail) {
+    return NULL;
+  }
+  DIGRAPHS_ASSERT(n == (UInt) LEN_LIST(vert_colours));
+  DIGRAPHS_ASSERT(n < BLISS_VERTEX_CAPACITY);
+  for (i = 0; i < n; i++) {
+    BLISS_COLOURS[i] = INT_INTOBJ(ELM_LIST(vert_colours, i + 1));
+  }
+  return BLISS_COLOURS;
+}
+
+// Returns a directed bliss graph with the same vertices and edges as
+// <digraph>, where the colours of the vertices and edges are given by
+// <vert_colours> (or all equal if <vert_colours> is Fail), and <edge_colours>.
+// The edge colours are handled directly by the included bliss, and so, unlike
+// in buildBlissDigraph, no additional vertices are required. This assumes that
+// <digraph> has no multiple edges. The graph is passed to bliss in a single
+// call, as offset and target arrays, rather than one edge at a time.
+static BlissGraph* buildBlissDigraphWithEdgeColours(Obj digraph,
+                                                    Obj vert_colours,
+                                                    Obj edge_colours) {
+  UInt          n, m, i, j, nr;
+  Obj           adj, adji, coli;
+  unsigned int* colours;
+
+  adj = FuncOutNeighbours(0L, digraph);
+  n   = DigraphNrVertices(digraph);
+  m   = DigraphNrEdges(digraph);
+  DIGRAPHS_ASSERT(n == (UInt) LEN_LIST(edge_colours));
+
+  ensureBlissCapacity(n, m);
+  colours = blissVertexColours(vert_colours, n);
+
+  BLISS_OFFSETS[0] = 0;
+  for (i = 1; i <= n; i++) {
+    adji = ELM_PLIST(adj, i);
+    coli = ELM_LIST(edge_colours, i);
+    nr   = LEN_PLIST(adji);
+    DIGRAPHS_ASSERT(nr == (UInt) LEN_LIST(coli));
+    for (j = 1; j <= nr; j++) {
+      BLISS_TARGETS[BLISS_OFFSETS[i - 1] + j - 1] =
+          INT_INTOBJ(ELM_PLIST(adji, j)) - 1;
+      BLISS_EDGE_COLOURS[BLISS_OFFSETS[i - 1] + j - 1] =
+          INT_INTOBJ(ELM_LIST(coli, j));
+    }
+    BLISS_OFFSETS[i] = BLISS_OFFSETS[i - 1] + nr;
+  }
+  DIGRAPHS_ASSERT(BLISS_OFFSETS[n] == m);
+
+  if (BLISS_DIGRAPH == NULL) {
+    BLISS_DIGRAPH = bliss_digraphs_new_digraph(0);
+  }
+  bliss_digraphs_assign_digraph_csr(BLISS_DIGRAPH,
+                                    n,
+                                    colours,
+                                    BLISS_OFFSETS,
+                                    BLISS_TARGETS,
+                                    BLISS_EDGE_COLOURS);
+  return BLISS_DIGRAPH;
+}
+
+// Returns the same undirected bliss graph as buildBlissDigraph when
+// <edge_colours> is Fail, but passed to bliss in a single call, as offset and
+// target arrays. The vertices 0, ..., n - 1 and n, ..., 2n - 1 are the sources
+// and ranges of the edges of <digraph>, respectively, and the vertex 2n + i is
+// adjacent to i and n + i. The neighbours of every vertex are listed in the
+// order in which buildBlissDigraph adds them, so that the canonical labellings
+// returned by bliss are the same.
+static BlissGraph* buildBlissDigraphWithoutEdgeColours(Obj digraph,
+                                                       Obj vert_colours) {
+  UInt          n, m, N, i, j, k, nr, num_vc;
+  Obj           adj, adji;
+  unsigned int* colours;
+
+  adj = FuncOutNeighbours(0L, digraph);
+  n   = DigraphNrVertices(digraph);
+  m   = DigraphNrEdges(digraph);
+
+  if (m == 0) {
+    ensureBlissCapacity(n, 0);
+    colours = blissVertexColours(vert_colours, n);
+    memset(BLISS_OFFSETS, 0, (n + 1) * sizeof(unsigned int));
+    return assignBlissGraph(n, colours);
+  }
+
+  N = 3 * n;
+  ensureBlissCapacity(N, 2 * m + 4 * n);
+  colours = BLISS_COLOURS;
+  if (vert_colours == Fail) {
+    for (i = 0; i < n; i++) {
+      colours[i] = 0;
+    }
+    num_vc = 1;
+  } else {
+    blissVertexColours(vert_colours, n);
+    num_vc = 0;
+    for (i = 0; i < n; i++) {
+      num_vc = MAX(num_vc, colours[i]);
+    }
+  }
+  for (i = 0; i < n; i++) {
+    colours[n + i]     = vert_colours == Fail ? 1 : num_vc + colours[i];
+    colours[2 * n + i] = 2 * num_vc + 2;
+  }
+
+  // The degree of the vertex i is stored in BLISS_OFFSETS[i + 1]
+  memset(BLISS_OFFSETS, 0, (N + 1) * sizeof(unsigned int));
+  for (i = 1; i <= n; i++) {
+    adji = ELM_PLIST(adj, i);
+    nr   = LEN_PLIST(adji);
+    BLISS_OFFSETS[i] += nr + 1;
+    for (j = 1; j <= nr; j++) {
+      BLISS_OFFSETS[n + INT_INTOBJ(ELM_PLIST(adji, j))]++;
+    }
+    BLISS_OFFSETS[n + i]++;
+    BLISS_OFFSETS[2 * n + i] = 2;
+  }
+  blissDegreesToOffsets(N);
+  DIGRAPHS_ASSERT(BLISS_OFFSETS[N] == 2 * m + 4 * n);
+
+  for (i = 0; i < n; i++) {
+    addBlissEdge(false, i, 2 * n + i);
+    addBlissEdge(false, n + i, 2 * n + i);
+  }
+  for (i = 0; i < n; i++) {
+    adji = ELM_PLIST(adj, i + 1);
+    nr   = LEN_PLIST(adji);
+    for (j = 1; j <= nr; j++) {
+      k = n + INT_INTOBJ(ELM_PLIST(adji, j)) - 1;
+      addBlissEdge(false, i, k);
+    }
+  }
+  return assignBlissGraph(N, colours);
+}
+
+// Add the edges of the undirected graph representing the multidigraph with
+// out-neighbours <adj> and <n> vertices, with or without vertex colours, in
+// the order in which they were once added one at a time with
+// bliss_digraphs_add_edge, so that the canonical labellings returned by bliss
+// do not change. The edge with index e is represented by the vertices
+// <first> + 2e and <first> + 2e + 1, where <first> is 3n if <coloured> is
+// true, and n if not.
+static void
+addBlissMultiDigraphEdges(Obj adj, UInt n, bool coloured, bool count) {
+  UInt const out = coloured ? n : 0;
+  UInt const in  = coloured ? 2 * n : 0;
+  UInt       i, j, k, nr;
+  Obj        adji;
+
+  k = coloured ? 3 * n : n;
+  for (i = 0; i < n; i++) {
+    if (coloured) {
+      addBlissEdge(count, i, n + i);
+      addBlissEdge(count, i, 2 * n + i);
+    }
+    adji = ELM_PLIST(adj, i + 1);
+    nr   = LEN_PLIST(adji);
+    for (j = 1; j <= nr; j++) {
+      addBlissEdge(count, out + i, k);
+      addBlissEdge(count, k, k + 1);
+      addBlissEdge(count, k + 1, in + INT_INTOBJ(ELM_PLIST(adji, j)) - 1);
+      k += 2;
+    }
+  }
+}
+
+// Returns the undirected bliss graph representing the multidigraph <digraph>,
+// with vertex colours <colours>, or without if <colours> is Fail.
+static BlissGraph* fillBlissMultiDigraph(Obj digraph, Obj colours) {
+  UInt       n, m, N, i;
+  Obj        adj;
+  bool const coloured = (colours != Fail);
+
+  adj = FuncOutNeighbours(0L, digraph);
+  n   = DigraphNrVertices(digraph);
+  m   = DigraphNrEdges(digraph);
+  N   = (coloured ? 3 * n : n) + 2 * m;
+
+  ensureBlissCapacity(N, (coloured ? 4 * n : 0) + 6 * m);
+  if (coloured) {
+    blissVertexColours(colours, n);
+    for (i = n; i < 2 * n; i++) {
+      BLISS_COLOURS[i]     = n + 1;
+      BLISS_COLOURS[i + n] = n + 2;
+    }
+    for (i = 3 * n; i < N; i += 2) {
+      BLISS_COLOURS[i]     = n + 3;
+      BLISS_COLOURS[i + 1] = n + 4;
+    }
+  } else {
+    for (i = 0; i < n; i++) {
+      BLISS_COLOURS[i] = 0;
+    }
+    for (i = n; i < N; i += 2) {
+      BLISS_COLOURS[i]     = 1;
+      BLISS_COLOURS[i + 1] = 2;
+    }
+  }
+
+  memset(BLISS_OFFSETS, 0, (N + 1) * sizeof(unsigned int));
+  addBlissMultiDigraphEdges(adj, n, coloured, true);
+  blissDegreesToOffsets(N);
+  addBlissMultiDigraphEdges(adj, n, coloured, false);
+  return assignBlissGraph(N, BLISS_COLOURS);
+}
+
+static BlissGraph* buildBlissMultiDigraph(Obj digraph) {
+  return fillBlissMultiDigraph(digraph, Fail);
+}
+
+static BlissGraph* buildBlissMultiDigraphWithColours(Obj digraph, Obj colours) {
+  return fillBlissMultiDigraph(digraph, colours);
+}
+#endif
 
 // TODO: document mult (and everything else)
 static BlissGraph*
@@ -1696,6 +2155,14 @@ buildBlissDigraph(Obj digraph, Obj vert_colours, Obj edge_colours) {
   Obj         adjj, adj;
   BlissGraph* graph;
 
+#ifdef DIGRAPHS_WITH_INCLUDED_BLISS
+  if (edge_colours != Fail) {
+    return buildBlissDigraphWithEdgeColours(
+        digraph, vert_colours, edge_colours);
+  }
+  return buildBlissDigraphWithoutEdgeColours(digraph, vert_colours);
+#endif
+
   n      = DigraphNrVertices(digraph);
   num_vc = 0;
   num_ec = 0;
@@ -1800,6 +2267,7 @@ buildBlissDigraph(Obj digraph, Obj vert_colours, Obj edge_colours) {
   return graph;
 }
 
+#ifndef DIGRAPHS_WITH_INCLUDED_BLISS
 static BlissGraph* buildBlissMultiDigraphWithColours(Obj digraph, Obj colours) {
   UInt        n, i, j, k, l, nr;
   Obj         adji, adj;
@@ -1837,25 +2305,163 @@ static BlissGraph* buildBlissMultiDigraphWithColours(Obj digraph, Obj colours) {
 
   return graph;
 }
+#endif
 
+#ifdef DIGRAPHS_WITH_INCLUDED_BLISS
+// The bliss graphs returned by the functions buildBliss* are owned by this
+// file, and are refilled by the next call, and so they are not released.
+static inline void releaseBlissGraph(BlissGraph* graph) {
+  (void) graph;
+}
+#else
+static inline void releaseBlissGraph(BlissGraph* graph) {
+  bliss_digraphs_release(graph);
+}
+#endif
+
+// A set of permutations of [0 .. degree - 1], such as the automorphisms found
+// by bliss, stored as consecutive arrays of images. Duplicates are detected
+// using an open addressing hash table, whose entries are the indices (plus 1)
+// of the permutations, or 0 for an empty slot. No GAP objects are created
+// until the permutations are converted using PermBufferToList, and the memory
+// is kept between uses, so that adding a permutation does not usually
+// allocate anything.
+typedef struct {
+  UInt4* images;
+  UInt   size;        // the number of entries of images
+  UInt   degree;
+  UInt   nr;          // the number of permutations
+  UInt   capacity;    // the number of permutations there is room for
+  UInt*  table;       // the hash table
+  UInt   table_size;  // a power of 2, at least 2 * capacity
+} PermBuffer;
+
+static PermBuffer VERT_PERMS = {NULL, 0, 0, 0, 0, NULL, 0};
+static PermBuffer EDGE_PERMS = {NULL, 0, 0, 0, 0, NULL, 0};
+
+static inline UInt4* PermBufferImages(PermBuffer const* buf, UInt i) {
+  return buf->images + i * buf->degree;
+}
+
+static UInt HashPerm(UInt4 const* images, UInt degree) {
+  UInt h = 0;
+  for (UInt i = 0; i < degree; i++) {
+    h = fmix(h + images[i] + 0x9e3779b9);
+  }
+  return h;
+}
+
+// Empty <buf>, and make it contain permutations of degree <degree>.
+static void ClearPermBuffer(PermBuffer* buf, UInt degree) {
+  buf->degree   = degree;
+  buf->nr       = 0;
+  buf->capacity = MIN(buf->size / MAX(degree, 1), buf->table_size / 2);
+  if (buf->table != NULL) {
+    memset(buf->table, 0, buf->table_size * sizeof(UInt));
+  }
+}
+
+// Returns the empty slot in the hash table of <buf> where the permutation
+// with index <i> belongs, or the slot containing an equal permutation.
+static UInt* PermBufferSlot(PermBuffer const* buf, UInt i) {
+  UInt4 const* images = PermBufferImages(buf, i);
+  UInt const   mask   = buf->table_size - 1;
+  UInt         h      = HashPerm(images, buf->degree) & mask;
+  while (buf->table[h] != 0
+         && memcmp(PermBufferImages(buf, buf->table[h] - 1),
+                   images,
+                   buf->degree * sizeof(UInt4))
+                != 0) {
+    h = (h + 1) & mask;
+  }
+  return buf->table + h;
+}
+
+// Returns space for the images of one more permutation, which is added to
+// <buf> by a subsequent call to AddPermBuffer.
+static UInt4* NextPermBuffer(PermBuffer* buf) {
+  UInt4* images;
+  UInt   i;
+
+  if (buf->nr == buf->capacity) {
+    buf->capacity = MAX(8, 2 * buf->capacity);
+    buf->size     = buf->capacity * MAX(buf->degree, 1);
+    images        = safe_malloc(buf->size * sizeof(UInt4));
+    if (buf->nr != 0) {
+      memcpy(images, buf->images, buf->nr * buf->degree * sizeof(UInt4));
+    }
+    free(buf->images);
+    buf->images = images;
+
+    free(buf->table);
+    buf->table_size = 2 * buf->capacity;
+    buf->table      = safe_calloc(buf->table_size, sizeof(UInt));
+    for (i = 0; i < buf->nr; i++) {
+      *PermBufferSlot(buf, i) = i + 1;
+    }
+  }
+  return PermBufferImages(buf, buf->nr);
+}
+
+// Add the permutation written into the space returned by NextPermBuffer to
+// <buf>, unless it is already there.
+static void AddPermBuffer(PermBuffer* buf) {
+  UInt* slot = PermBufferSlot(buf, buf->nr);
+  if (*slot == 0) {
+    *slot = ++buf->nr;
+  }
+}
+
+static UInt PERM_BUFFER_DEGREE = 0;  // the degree used by ComparePerms
+
+static int ComparePerms(void const* a, void const* b) {
+  UInt4 const* x = (UInt4 const*) a;
+  UInt4 const* y = (UInt4 const*) b;
+  for (UInt i = 0; i < PERM_BUFFER_DEGREE; i++) {
+    if (x[i] != y[i]) {
+      return x[i] < y[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+// Returns a GAP list of the permutations in <buf>, in the order given by
+// SortDensePlist.
+static Obj PermBufferToList(PermBuffer* buf) {
+  Obj  out, p;
+  UInt i;
+
+  if (buf->nr > 1 && buf->degree > 0) {
+    PERM_BUFFER_DEGREE = buf->degree;
+    qsort(buf->images, buf->nr, buf->degree * sizeof(UInt4), ComparePerms);
+  }
+  out = NEW_PLIST(T_PLIST, buf->nr);
+  for (i = 0; i < buf->nr; i++) {
+    p = NEW_PERM4(buf->degree);
+    memcpy(ADDR_PERM4(p),
+           PermBufferImages(buf, i),
+           buf->degree * sizeof(UInt4));
+    SET_ELM_PLIST(out, i + 1, p);
+    CHANGED_BAG(out);
+  }
+  SET_LEN_PLIST(out, buf->nr);
+  return out;
+}
+
+// user_param = a PermBuffer for the perms of the vertices
 static void digraph_hook_function(void*               user_param,
                                   unsigned int        N,
                                   const unsigned int* aut) {
-  UInt4* ptr;
-  Obj    p, gens;
-  UInt   i, n;
-
-  n = INT_INTOBJ(ELM_PLIST(user_param, 2));  // the degree
-  DIGRAPHS_ASSERT(n <= N);
-  p   = NEW_PERM4(n);
-  ptr = ADDR_PERM4(p);
+  PermBuffer* buf = (PermBuffer*) user_param;
+  UInt4*      ptr;
+  UInt        i;
 
-  for (i = 0; i < n; i++) {
+  DIGRAPHS_ASSERT(buf->degree <= N);
+  ptr = NextPermBuffer(buf);
+  for (i = 0; i < buf->degree; i++) {
     ptr[i] = aut[i];
   }
-
-  gens = ELM_PLIST(user_param, 1);
-  AssPlist(gens, LEN_PLIST(gens) + 1, p);
+  AddPermBuffer(buf);
 }
 
 // Take a list of C integers, and multiply them together into a GAP int
@@ -1871,42 +2477,36 @@ static Obj FuncDIGRAPH_AUTOMORPHISMS(Obj self,
                                      Obj digraph,
                                      Obj vert_colours,
                                      Obj edge_colours) {
-  Obj                 autos, p, n;
+  Obj                 autos, p;
   BlissGraph*         graph;
   UInt4*              ptr;
   const unsigned int* canon;
-  Int                 i;
+  Int                 i, n;
 
   graph = buildBlissDigraph(digraph, vert_colours, edge_colours);
-
-  autos = NEW_PLIST(T_PLIST, 3);
-  n     = INTOBJ_INT(DigraphNrVertices(digraph));
-
-  SET_ELM_PLIST(autos, 1, NEW_PLIST(T_PLIST, 0));  // perms of the vertices
-  CHANGED_BAG(autos);
-  SET_ELM_PLIST(autos, 2, n);
-  SET_LEN_PLIST(autos, 2);
+  n     = DigraphNrVertices(digraph);
+  ClearPermBuffer(&VERT_PERMS, n);
 
   BlissStats stats;
 
   canon = bliss_digraphs_find_canonical_labeling(
-      graph, digraph_hook_function, autos, &stats);
+      graph, digraph_hook_function, &VERT_PERMS, &stats);
 
-  p   = NEW_PERM4(INT_INTOBJ(n));
+  p   = NEW_PERM4(n);
   ptr = ADDR_PERM4(p);
 
-  for (i = 0; i < INT_INTOBJ(n); i++) {
+  for (i = 0; i < n; i++) {
     ptr[i] = canon[i];
   }
+  releaseBlissGraph(graph);
+
+  autos = NEW_PLIST(T_PLIST, 3);
+  SET_ELM_PLIST(autos, 1, PermBufferToList(&VERT_PERMS));  // perms of vertices
+  CHANGED_BAG(autos);
   SET_ELM_PLIST(autos, 2, p);
+  SET_LEN_PLIST(autos, 2);
   CHANGED_BAG(autos);
 
-  bliss_digraphs_release(graph);
-  if (LEN_PLIST(ELM_PLIST(autos, 1)) != 0) {
-    SortDensePlist(ELM_PLIST(autos, 1));
-    RemoveDupsDensePlist(ELM_PLIST(autos, 1));
-  }
-
 #ifdef DIGRAPHS_WITH_INCLUDED_BLISS
   Obj size = MultiplyList(stats.group_size, stats.group_size_len);
   bliss_digraphs_free_blissstats(&stats);
@@ -1918,56 +2518,27 @@ static Obj FuncDIGRAPH_AUTOMORPHISMS(Obj self,
   return autos;
 }
 
-// user_param = [vertex perms, nr vertices, edge perms, nr edges]
+// The user_param of multidigraph_hook_function
+typedef struct {
+  PermBuffer* vert_perms;
+  PermBuffer* edge_perms;
+  // The edge with index e is represented by the vertices offset + 2e and
+  // offset + 2e + 1 of the bliss graph
+  UInt offset;
+} MultiDigraphHookData;
+
 static void multidigraph_hook_function(void*               user_param,
                                        unsigned int        N,
                                        const unsigned int* aut) {
-  UInt4* ptr;
-  Obj    p, gens;
-  UInt   i, n, m;
-  bool   stab;
-
-  m = INT_INTOBJ(ELM_PLIST(user_param, 2));  // the nr of vertices
-  DIGRAPHS_ASSERT(m <= N);
-
-  stab = true;
-  for (i = 0; i < m; i++) {
-    if (aut[i] != i) {
-      stab = false;
-    }
-  }
-  if (stab) {                                    // permutation of the edges
-    n   = INT_INTOBJ(ELM_PLIST(user_param, 4));  // the nr of edges
-    p   = NEW_PERM4(n);
-    ptr = ADDR_PERM4(p);
-    DIGRAPHS_ASSERT(2 * (n - 1) + m <= N);
-    for (i = 0; i < n; i++) {
-      ptr[i] = (aut[2 * i + m] - m) / 2;
-    }
-    gens = ELM_PLIST(user_param, 3);
-  } else {  // permutation of the vertices
-    p   = NEW_PERM4(m);
-    ptr = ADDR_PERM4(p);
-    DIGRAPHS_ASSERT(m <= N);
-    for (i = 0; i < m; i++) {
-      ptr[i] = aut[i];
-    }
-    gens = ELM_PLIST(user_param, 1);
-  }
-
-  AssPlist(gens, LEN_PLIST(gens) + 1, p);
-}
-
-// user_param = [vertex perms, nr vertices, edge perms, nr edges]
-static void multidigraph_colours_hook_function(void*               user_param,
-                                               unsigned int        N,
-                                               const unsigned int* aut) {
-  UInt4* ptr;
-  Obj    p, gens;
-  UInt   i, n, m;
-  bool   stab;
-
-  m = INT_INTOBJ(ELM_PLIST(user_param, 2));  // the nr of vertices
+  MultiDigraphHookData* data = (MultiDigraphHookData*) user_param;
+  PermBuffer*           buf;
+  UInt4*                ptr;
+  UInt                  i, n, m, offset;
+  bool                  stab;
+
+  m      = data->vert_perms->degree;  // the nr of vertices
+  n      = data->edge_perms->degree;  // the nr of edges
+  offset = data->offset;
   DIGRAPHS_ASSERT(m <= N);
 
   stab = true;
@@ -1976,60 +2547,50 @@ static void multidigraph_colours_hook_function(void*               user_param,
       stab = false;
     }
   }
-  if (stab) {                                    // permutation of the edges
-    n   = INT_INTOBJ(ELM_PLIST(user_param, 4));  // the nr of edges
-    p   = NEW_PERM4(n);
-    ptr = ADDR_PERM4(p);
-    DIGRAPHS_ASSERT(2 * (n - 1) + 3 * m <= N);
+  if (stab) {  // permutation of the edges
+    DIGRAPHS_ASSERT(n == 0 || 2 * (n - 1) + offset < N);
+    buf = data->edge_perms;
+    ptr = NextPermBuffer(buf);
     for (i = 0; i < n; i++) {
-      ptr[i] = (aut[2 * i + 3 * m] - 3 * m) / 2;
+      ptr[i] = (aut[2 * i + offset] - offset) / 2;
     }
-    gens = ELM_PLIST(user_param, 3);
   } else {  // permutation of the vertices
-    p   = NEW_PERM4(m);
-    ptr = ADDR_PERM4(p);
-    DIGRAPHS_ASSERT(m < N);
+    buf = data->vert_perms;
+    ptr = NextPermBuffer(buf);
     for (i = 0; i < m; i++) {
       ptr[i] = aut[i];
     }
-    gens = ELM_PLIST(user_param, 1);
   }
-
-  AssPlist(gens, LEN_PLIST(gens) + 1, p);
+  AddPermBuffer(buf);
 }
 
 static Obj FuncMULTIDIGRAPH_AUTOMORPHISMS(Obj self, Obj digraph, Obj colours) {
-  Obj                 autos, p, q, out;
-  BlissGraph*         graph;
-  UInt4*              ptr;
-  const unsigned int* canon;
-  Int                 i, m, n;
+  Obj                  autos, p, q, out;
+  BlissGraph*          graph;
+  UInt4*               ptr;
+  const unsigned int*  canon;
+  Int                  i, m, n;
+  MultiDigraphHookData data;
 
   if (colours == False) {
     graph = buildBlissMultiDigraph(digraph);
   } else {
     graph = buildBlissMultiDigraphWithColours(digraph, colours);
   }
-  autos = NEW_PLIST(T_PLIST, 4);
-  SET_ELM_PLIST(autos, 1, NEW_PLIST(T_PLIST, 0));  // perms of the vertices
-  CHANGED_BAG(autos);
-  SET_ELM_PLIST(autos, 2, INTOBJ_INT(DigraphNrVertices(digraph)));
-  SET_ELM_PLIST(autos, 3, NEW_PLIST(T_PLIST, 0));  // perms of the edges
-  CHANGED_BAG(autos);
-  SET_ELM_PLIST(autos, 4, INTOBJ_INT(DigraphNrEdges(digraph)));
+  m = DigraphNrVertices(digraph);
+  n = DigraphNrEdges(digraph);
+  ClearPermBuffer(&VERT_PERMS, m);
+  ClearPermBuffer(&EDGE_PERMS, n);
+  data.vert_perms = &VERT_PERMS;
+  data.edge_perms = &EDGE_PERMS;
+  data.offset     = (colours == False ? m : 3 * m);
 
   BlissStats stats;
 
-  if (colours == False) {
-    canon = bliss_digraphs_find_canonical_labeling(
-        graph, multidigraph_hook_function, autos, &stats);
-  } else {
-    canon = bliss_digraphs_find_canonical_labeling(
-        graph, multidigraph_colours_hook_function, autos, &stats);
-  }
+  canon = bliss_digraphs_find_canonical_labeling(
+      graph, multidigraph_hook_function, &data, &stats);
 
   // Get canonical labeling as GAP perms
-  m   = DigraphNrVertices(digraph);
   p   = NEW_PERM4(m);  // perm of vertices
   ptr = ADDR_PERM4(p);
 
@@ -2037,21 +2598,14 @@ static Obj FuncMULTIDIGRAPH_AUTOMORPHISMS(Obj self, Obj digraph, Obj colours) {
     ptr[i] = canon[i];
   }
 
-  n   = DigraphNrEdges(digraph);
   q   = NEW_PERM4(n);  // perm of edges
   ptr = ADDR_PERM4(q);
 
-  if (colours == False) {
-    for (i = 0; i < n; i++) {
-      ptr[i] = canon[2 * i + m] - m;
-    }
-  } else {
-    for (i = 0; i < n; i++) {
-      ptr[i] = canon[2 * i + 3 * m] - 3 * m;
-    }
+  for (i = 0; i < n; i++) {
+    ptr[i] = canon[2 * i + data.offset] - data.offset;
   }
 
-  bliss_digraphs_release(graph);
+  releaseBlissGraph(graph);
 
   // put the canonical labeling (as a list of two perms) into autos[2]
   out = NEW_PLIST(T_PLIST, 2);
@@ -2060,20 +2614,13 @@ static Obj FuncMULTIDIGRAPH_AUTOMORPHISMS(Obj self, Obj digraph, Obj colours) {
   SET_LEN_PLIST(out, 2);
   CHANGED_BAG(out);
 
-  SET_ELM_PLIST(autos, 2, out);
+  autos = NEW_PLIST(T_PLIST, 4);
+  SET_ELM_PLIST(autos, 1, PermBufferToList(&VERT_PERMS));  // perms of vertices
   CHANGED_BAG(autos);
-
-  // remove 4th entry of autos (the number of edges) . . .
+  SET_ELM_PLIST(autos, 2, out);
+  SET_ELM_PLIST(autos, 3, PermBufferToList(&EDGE_PERMS));  // perms of edges
   SET_LEN_PLIST(autos, 3);
-
-  if (LEN_PLIST(ELM_PLIST(autos, 1)) != 0) {
-    SortDensePlist(ELM_PLIST(autos, 1));
-    RemoveDupsDensePlist(ELM_PLIST(autos, 1));
-  }
-  if (LEN_PLIST(ELM_PLIST(autos, 3)) != 0) {
-    SortDensePlist(ELM_PLIST(autos, 3));
-    RemoveDupsDensePlist(ELM_PLIST(autos, 3));
-  }
+  CHANGED_BAG(autos);
 
 #ifdef DIGRAPHS_WITH_INCLUDED_BLISS
   Obj size = MultiplyList(stats.group_size, stats.group_size_len);
@@ -2093,11 +2640,7 @@ static Obj FuncDIGRAPH_CANONICAL_LABELLING(Obj self, Obj digraph, Obj colours) {
   Int                 n, i;
   const unsigned int* canon;
 
-  if (colours == Fail) {
-    graph = buildBlissDigraph(digraph, NULL, NULL);
-  } else {
-    graph = buildBlissDigraph(digraph, colours, NULL);
-  }
+  graph = buildBlissDigraph(digraph, colours, Fail);
 
   canon = bliss_digraphs_find_canonical_labeling(graph, 0, 0, 0);
 
@@ -2108,7 +2651,7 @@ static Obj FuncDIGRAPH_CANONICAL_LABELLING(Obj self, Obj digraph, Obj colours) {
   for (i = 0; i < n; i++) {
     ptr[i] = canon[i];
   }
-  bliss_digraphs_release(graph);
+  releaseBlissGraph(graph);
 
   return p;
 }
@@ -2151,7 +2694,7 @@ FuncMULTIDIGRAPH_CANONICAL_LABELLING(Obj self, Obj digraph, Obj colours) {
     }
   }
 
-  bliss_digraphs_release(graph);
+  releaseBlissGraph(graph);
 
   out = NEW_PLIST(T_PLIST, 2);
   SET_ELM_PLIST(out, 1, p);
@@ -2198,6 +2741,7 @@ static StructGVarFunc GVarFuncs[] = {
     GVAR_FUNC(DIGRAPH_EQUALS, 2, "digraph1, digraph2"),
     GVAR_FUNC(DIGRAPH_LT, 2, "digraph1, digraph2"),
     GVAR_FUNC(DIGRAPH_HASH, 1, "digraph"),
+    GVAR_FUNC(DIGRAPH_ISOMORPHISM_INVARIANT, 3, "digraph, colours, rounds"),
     GVAR_FUNC(DIGRAPH_PATH, 3, "digraph, u, v"),
     GVAR_FUNC(DIGRAPH_AUTOMORPHISMS, 3, "digraph, vert_colours, edge_colours"),
     GVAR_FUNC(MULTIDIGRAPH_AUTOMORPHISMS, 2, "digraph, colours"),
@@ -2220,8 +2764,39 @@ static StructGVarFunc GVarFuncs[] = {
     GVAR_FUNC(SUBGRAPH_HOMEOMORPHIC_TO_K23, 1, "digraph"),
     GVAR_FUNC(SUBGRAPH_HOMEOMORPHIC_TO_K33, 1, "digraph"),
     GVAR_FUNC(SUBGRAPH_HOMEOMORPHIC_TO_K4, 1, "digraph"),
+    GVAR_FUNC(DIGRAPH_GREEDY_COLOURING, 2, "digraph, order"),
+    GVAR_FUNC(DIGRAPH_DSATUR_COLOURING, 1, "digraph"),
+    GVAR_FUNC(DIGRAPH_WELSH_POWELL_ORDER, 1, "digraph"),
+    GVAR_FUNC(DIGRAPH_SMALLEST_LAST_ORDER, 1, "digraph"),
+    GVAR_FUNC(DIGRAPH_HEURISTIC_COLOURING, 1, "digraph"),
+    GVAR_FUNC(DIGRAPH_MAXIMUM_COMMON_INDUCED_SUBDIGRAPH, 2, "D1, D2"),
+    GVAR_FUNC(DIGRAPH_BICONNECTIVITY, 2, "digraph, symmetric"),
+    GVAR_FUNC(DIGRAPH_DOMINATOR_TREES, 2, "digraph, roots"),
+    GVAR_FUNC(DIGRAPH_SIMPLE_CIRCUITS,
+              6,
+              "digraph, hook, user_param, limit, min, max"),
+    GVAR_FUNC(DIGRAPH_ALL_CHORDLESS_CYCLES, 2, "digraph, labels"),
+    GVAR_FUNC(DIGRAPH_CYCLE_BASIS, 2, "digraph, zero"),
+    GVAR_FUNC(DIGRAPH_PRODUCT, 3, "D1, D2, product"),
+    GVAR_FUNC(DIGRAPH_LINE_DIGRAPH, 1, "D"),
+    GVAR_FUNC(DIGRAPH_LINE_UNDIRECTED_DIGRAPH, 1, "D"),
+    GVAR_FUNC(DIGRAPH_INDUCED_SUBDIGRAPH, 3, "D, list, edge_labels"),
+    GVAR_FUNC(DIGRAPH_QUOTIENT_DIGRAPH, 3, "D, partition, vertex_labels"),
+    GVAR_FUNC(DIGRAPH_MAXIMAL_MATCHING, 1, "D"),
+    GVAR_FUNC(DIGRAPH_MAXIMUM_MATCHING, 3, "D, mate, U"),
+    GVAR_FUNC(DIGRAPH_BFS_LAYERS, 3, "D, sources, depth"),
+    GVAR_FUNC(DIGRAPH_BFS_REACHABLE, 2, "D, sources"),
+    GVAR_FUNC(DIGRAPH_BFS_SHORTEST_DISTANCE, 3, "D, sources, targets"),
+    GVAR_FUNC(DIGRAPH_BFS_PAIRS, 3, "D, pairs, reachability"),
+    GVAR_FUNC(DIGRAPH_BFS_DISTANCE_ROWS, 2, "D, sources"),
+    GVAR_FUNC(DIGRAPH_STAB_CHAIN, 5, "gens, degree, base, random, size"),
+    GVAR_FUNC(DIGRAPH_ORBITS, 2, "gens, N"),
+    GVAR_FUNC(DIGRAPH_TRACE_SCHREIER_VECTOR, 3, "gens, sch, r"),
+    GVAR_FUNC(DIGRAPH_EVALUATE_WORD, 2, "gens, word"),
+    GVAR_FUNC(DIGRAPHS_GENERATE, 2, "n, opts"),
     GVAR_FUNC(DIGRAPHS_FREE_HOMOS_DATA, 0, ""),
     GVAR_FUNC(DIGRAPHS_FREE_CLIQUES_DATA, 0, ""),
+    GVAR_FUNC(DIGRAPHS_FREE_BFS_DATA, 0, ""),
 
     {0, 0, 0, 0, 0} /* Finish with an empty entry */
 };
@@ -2237,6 +2812,10 @@ static Int InitKernel(StructInitInfo* module) {
   ImportGVarFromLibrary("IsDigraphEdge", &IsDigraphEdge);
   ImportGVarFromLibrary("DIGRAPHS_ValidateVertexColouring",
                         &DIGRAPHS_ValidateVertexColouring);
+  ImportGVarFromLibrary("DIGRAPHS_ExpandOutNeighbours",
+                        &DIGRAPHS_ExpandOutNeighbours);
+  ImportGVarFromLibrary("DIGRAPHS_ExpandPersistentOutNeighbours",
+                        &DIGRAPHS_ExpandPersistentOutNeighbours);
   ImportGVarFromLibrary("infinity", &Infinity);
   ImportGVarFromLibrary("IsSymmetricDigraph", &IsSymmetricDigraph);
   ImportGVarFromLibrary("AutomorphismGroup", &AutomorphismGroup);
@@ -2255,6 +2834,7 @@ static Int InitKernel(StructInitInfo* module) {
   ImportGVarFromLibrary("Group", &Group);
   ImportGVarFromLibrary("ClosureGroup", &ClosureGroup);
   ImportGVarFromLibrary("InfoWarning", &InfoWarning);
+  ImportGVarFromLibrary("ValueOption", &ValueOption);
   /* return success                                                      */
   return 0;
 }
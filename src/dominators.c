@@ -0,0 +1,237 @@
+/********************************************************************************
+**
+*A  dominators.c           dominator trees
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "dominators.h"
+
+// C headers
+#include <stdbool.h>  // for true
+#include <stdlib.h>   // for free
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt, NEW_PLIST, . . .
+
+// Digraphs headers
+#include "csr.h"             // for CSR, new_csr_out_neighbours, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+// This file contains the SEMI-NCA algorithm for computing the dominator tree
+// of the vertices of a digraph reachable from a root, see:
+//
+//   L. Georgiadis, R. E. Tarjan, and R. F. Werneck, Finding dominators in
+//   practice, J. Graph Algorithms Appl. 10 (2006) 69-94.
+//
+// The semidominators are computed exactly as in the Lengauer-Tarjan algorithm
+// (with simple path compression), and then the immediate dominator of every
+// vertex <w> is found as the nearest common ancestor, in the partially built
+// dominator tree, of the parent and the semidominator of <w>.
+//
+// Within the algorithm, the reachable vertices are identified with their
+// position in the preorder of the depth first search, starting at 1, and 0
+// indicates an unreachable vertex or the absence of an ancestor.
+//
+// The out- and in-neighbours of the digraph, and the work arrays below, are
+// created once and shared by all of the roots passed to
+// DIGRAPH_DOMINATOR_TREES. Only the entries belonging to the vertices reached
+// from a root are reset afterwards, so that computing the dominator tree of a
+// root is linear (in practice) in the size of the subdigraph reachable from
+// that root, and not in the size of the whole digraph. Since the roots share
+// these arrays, they are processed one at a time.
+
+struct dom_struct {
+  CSR*  out;
+  CSR*  in;
+  UInt* num;     // num[v] is the preorder number of the vertex <v>
+  UInt* next;    // next[v] is the next edge of <v> to consider in the DFS
+  UInt* vert;    // vert[i] is the vertex with preorder number <i>
+  UInt* parent;  // parent in the DFS tree
+  UInt* semi;    // semidominator, and then immediate dominator
+  UInt* label;
+  UInt* anc;     // ancestor in the forest used by eval
+  UInt* path;    // stack used by compress
+};
+
+typedef struct dom_struct Dom;
+
+static Dom* new_dom(Obj D) {
+  Dom* dom = safe_malloc(sizeof(Dom));
+  dom->out = new_csr_out_neighbours(D);
+  dom->in  = new_csr_reverse(dom->out);
+
+  UInt const n = dom->out->nr_vertices;
+  dom->num     = safe_calloc(n + 1, sizeof(UInt));
+  dom->next    = safe_malloc((n + 1) * sizeof(UInt));
+  dom->vert    = safe_malloc((n + 1) * sizeof(UInt));
+  dom->parent  = safe_malloc((n + 1) * sizeof(UInt));
+  dom->semi    = safe_malloc((n + 1) * sizeof(UInt));
+  dom->label   = safe_malloc((n + 1) * sizeof(UInt));
+  dom->anc     = safe_malloc((n + 1) * sizeof(UInt));
+  dom->path    = safe_malloc((n + 1) * sizeof(UInt));
+  return dom;
+}
+
+static void free_dom(Dom* const dom) {
+  free_csr(dom->out);
+  free_csr(dom->in);
+  free(dom->num);
+  free(dom->next);
+  free(dom->vert);
+  free(dom->parent);
+  free(dom->semi);
+  free(dom->label);
+  free(dom->anc);
+  free(dom->path);
+  free(dom);
+}
+
+// Performs a depth first search from <root>, visiting the out-neighbours of
+// every vertex in order, and returns the number of vertices reached.
+static UInt dfs(Dom* const dom, UInt const root) {
+  CSR const* const out = dom->out;
+  UInt             N   = 1;
+  dom->num[root]       = 1;
+  dom->vert[1]         = root;
+  dom->parent[1]       = 0;
+  dom->next[root]      = out->offsets[root];
+
+  UInt v = root;
+  while (true) {
+    if (dom->next[v] < out->offsets[v + 1]) {
+      UInt const w = out->targets[dom->next[v]++];
+      if (dom->num[w] == 0) {
+        dom->num[w]    = ++N;
+        dom->vert[N]   = w;
+        dom->parent[N] = dom->num[v];
+        dom->next[w]   = out->offsets[w];
+        v              = w;
+      }
+    } else if (v == root) {
+      return N;
+    } else {
+      v = dom->vert[dom->parent[dom->num[v]]];
+    }
+  }
+}
+
+// Compress the path from <i> to the root of its tree in the forest <anc>,
+// so that label[i] has the minimum semidominator on that path.
+static void compress(Dom* const dom, UInt i) {
+  UInt* const anc   = dom->anc;
+  UInt* const label = dom->label;
+  UInt* const semi  = dom->semi;
+  UInt        len   = 0;
+  while (anc[anc[i]] != 0) {
+    dom->path[len++] = i;
+    i                = anc[i];
+  }
+  while (len > 0) {
+    UInt const j = dom->path[--len];
+    if (semi[label[anc[j]]] < semi[label[j]]) {
+      label[j] = label[anc[j]];
+    }
+    anc[j] = anc[anc[j]];
+  }
+}
+
+// Computes the immediate dominators of the vertices with preorder numbers
+// 2, ..., N, and stores them (as preorder numbers) in semi.
+static void semi_nca(Dom* const dom, UInt const N) {
+  CSR const* const in     = dom->in;
+  UInt* const      semi   = dom->semi;
+  UInt* const      label  = dom->label;
+  UInt* const      anc    = dom->anc;
+  UInt* const      parent = dom->parent;
+
+  for (UInt i = 1; i <= N; i++) {
+    semi[i]  = i;
+    label[i] = i;
+    anc[i]   = 0;
+  }
+  for (UInt i = N; i >= 2; i--) {
+    UInt const w = dom->vert[i];
+    for (UInt e = in->offsets[w]; e < in->offsets[w + 1]; e++) {
+      UInt const j = dom->num[in->targets[e]];
+      if (j == 0) {
+        continue;  // not reachable from the root
+      }
+      UInt u = j;
+      if (anc[j] != 0) {
+        compress(dom, j);
+        u = label[j];
+      }
+      if (semi[u] < semi[i]) {
+        semi[i] = semi[u];
+      }
+    }
+    anc[i] = parent[i];
+  }
+  // semi[i] is no longer required once idom(i) is known, and the immediate
+  // dominators are found in preorder, so the same array is reused.
+  for (UInt i = 2; i <= N; i++) {
+    UInt d = parent[i];
+    while (d > semi[i]) {
+      d = semi[d];
+    }
+    semi[i] = d;
+  }
+}
+
+static Obj dominator_tree(Dom* const dom, UInt const root) {
+  UInt const N = dfs(dom, root);
+  semi_nca(dom, N);
+
+  UInt max = 0;
+  for (UInt i = 1; i <= N; i++) {
+    if (dom->vert[i] > max) {
+      max = dom->vert[i];
+    }
+  }
+  // Unreachable vertices do not have an immediate dominator, and so <idom>
+  // has holes in the corresponding positions.
+  Obj idom = NEW_PLIST(T_PLIST, max + 1);
+  SET_LEN_PLIST(idom, max + 1);
+  Obj preorder = NEW_PLIST(T_PLIST_CYC, N);
+  SET_LEN_PLIST(preorder, N);
+
+  SET_ELM_PLIST(idom, root + 1, Fail);
+  SET_ELM_PLIST(preorder, 1, INTOBJ_INT(root + 1));
+  for (UInt i = 2; i <= N; i++) {
+    UInt const v = dom->vert[i];
+    SET_ELM_PLIST(idom, v + 1, INTOBJ_INT(dom->vert[dom->semi[i]] + 1));
+    SET_ELM_PLIST(preorder, i, INTOBJ_INT(v + 1));
+  }
+  // Reset only the entries that were used
+  for (UInt i = 1; i <= N; i++) {
+    dom->num[dom->vert[i]] = 0;
+  }
+
+  Obj result = NEW_PREC(2);
+  AssPRec(result, RNamName("idom"), idom);
+  AssPRec(result, RNamName("preorder"), preorder);
+  return result;
+}
+
+// The argument <roots> must be a list of vertices of the digraph <D>. Returns
+// the list of dominator trees of <D> with respect to each of the <roots>, in
+// the format of DominatorTree.
+Obj FuncDIGRAPH_DOMINATOR_TREES(Obj self, Obj D, Obj roots) {
+  UInt const nr   = LEN_LIST(roots);
+  Dom*       dom  = new_dom(D);
+  Obj        list = NEW_PLIST(T_PLIST, nr);
+  SET_LEN_PLIST(list, nr);
+  for (UInt i = 1; i <= nr; i++) {
+    UInt const root = INT_INTOBJ(ELM_LIST(roots, i)) - 1;
+    DIGRAPHS_ASSERT(root < dom->out->nr_vertices);
+    SET_ELM_PLIST(list, i, dominator_tree(dom, root));
+    CHANGED_BAG(list);
+  }
+  free_dom(dom);
+  return list;
+}
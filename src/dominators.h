@@ -0,0 +1,19 @@
+/********************************************************************************
+**
+*A  dominators.h           dominator trees
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_DOMINATORS_H_
+#define DIGRAPHS_SRC_DOMINATORS_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_DOMINATOR_TREES(Obj self, Obj D, Obj roots);
+
+#endif  // DIGRAPHS_SRC_DOMINATORS_H_
@@ -0,0 +1,542 @@
+/********************************************************************************
+**
+*A  generate.c             generating digraphs up to isomorphism
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "generate.h"
+
+// C headers
+#include <stdbool.h>  // for bool, false, true
+#include <stdint.h>   // for uint32_t, uint64_t
+#include <string.h>   // for memcmp, memcpy, memset, strcmp
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt, ElmPRec, NEW_STRING, . . .
+
+// Digraphs headers
+#include "bliss-includes.h"  // for bliss_digraphs_new, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+
+// This file contains a generator of digraphs up to isomorphism, using the
+// canonical construction path method from:
+//
+//   B. D. McKay, Isomorph-free exhaustive generation, J. Algorithms 26(2),
+//   1998.
+//
+// The digraphs with k + 1 vertices are obtained from those with k vertices by
+// adding the vertex k, in every possible way. Such a digraph is only accepted
+// if the vertex k is in the same orbit of its automorphism group as the vertex
+// with the largest canonical label (amongst the sinks, for acyclic digraphs),
+// and so every isomorphism class has a unique parent. Two children of the same
+// parent are isomorphic if and only if the ways in which the vertex k was
+// added are in the same orbit of the automorphism group of the parent, and so
+// the canonical forms of the children of a parent with non-trivial
+// automorphisms are stored, and any repeats are discarded.
+//
+// The canonical labellings and automorphisms are computed by bliss. The
+// adjacency of the digraph is stored as bit masks, and so at most
+// GENERATE_MAXVERTS vertices are supported.
+
+typedef uint32_t Row;  // bit w is set if and only if w is a neighbour
+
+enum kind_enum { GRAPHS, DIGRAPHS, TOURNAMENTS, DAGS };
+
+// A set of canonical forms, which is emptied in constant time by changing its
+// timestamp. The form in position i is FORMS(set)[i * width], ...,
+// FORMS(set)[i * width + width - 1], and this position is occupied if and only
+// if STAMPS(set)[i] equals now.
+//
+// The forms and stamps are stored in GAP strings, rather than memory allocated
+// with malloc, so that they are reclaimed by the garbage collector if the
+// filter or hook raises an error. Since a garbage collection can move these
+// strings, pointers into them are not kept across calls to GAP.
+struct form_set_struct {
+  UInt capacity;  // a power of 2
+  UInt size;
+  UInt width;
+  Obj  forms;
+  Obj  stamps;
+  UInt now;
+};
+
+typedef struct form_set_struct FormSet;
+
+#define FORMS(set) ((Row*) CHARS_STRING((set)->forms))
+#define STAMPS(set) ((UInt*) CHARS_STRING((set)->stamps))
+
+struct gen_struct {
+  enum kind_enum kind;
+  UInt           n;
+  UInt           min_deg;
+  UInt           max_deg;
+  UInt           min_edges;
+  UInt           max_edges;
+  // future[k] is the largest number of edges that can be added with the
+  // vertices k, ..., n - 1
+  UInt future[GENERATE_MAXVERTS + 1];
+  // Only the <res>th, <res + mod>th, . . . digraphs with <split> vertices are
+  // extended, counting from 0 in the order they are found
+  UInt res;
+  UInt mod;
+  UInt split;
+  UInt nr_split;
+  Obj  filter;  // Fail or a function
+  Obj  hook;
+  bool strings;
+  UInt nr_found;
+  // The current digraph, with vertices 0, ..., k - 1 for some k
+  Row  out[GENERATE_MAXVERTS];
+  Row  in[GENERATE_MAXVERTS];
+  UInt nr_edges;
+  // has_auts[k] is true if the digraph induced on 0, ..., k - 1 has
+  // non-trivial automorphisms
+  bool    has_auts[GENERATE_MAXVERTS + 1];
+  FormSet sets[GENERATE_MAXVERTS + 1];
+  // Used in is_canonical
+  UInt orbits[GENERATE_MAXVERTS];
+  UInt nr_gens;
+  UInt k;
+  Row  form[GENERATE_MAXVERTS];
+};
+
+typedef struct gen_struct Gen;
+
+static inline UInt popcount(Row x) {
+#if defined(__GNUC__)
+  return __builtin_popcount(x);
+#else
+  UInt result = 0;
+  while (x != 0) {
+    x &= x - 1;
+    result++;
+  }
+  return result;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sets of canonical forms
+////////////////////////////////////////////////////////////////////////////////
+
+static void alloc_form_set(FormSet* const set, UInt const capacity) {
+  set->capacity = capacity;
+  set->forms    = NEW_STRING(capacity * set->width * sizeof(Row));
+  set->stamps   = NEW_STRING(capacity * sizeof(UInt));
+  memset(STAMPS(set), 0, capacity * sizeof(UInt));
+  set->now = 1;
+}
+
+static void init_form_set(FormSet* const set, UInt const width) {
+  set->size  = 0;
+  set->width = width;
+  alloc_form_set(set, 64);
+}
+
+static void clear_form_set(FormSet* const set) {
+  set->size = 0;
+  if (++set->now == 0) {
+    memset(STAMPS(set), 0, set->capacity * sizeof(UInt));
+    set->now = 1;
+  }
+}
+
+static UInt hash_form(Row const* const form, UInt const width) {
+  UInt h = 0;
+  for (UInt i = 0; i < width; i++) {
+    h = (h ^ form[i]) * 0x9E3779B1;
+  }
+  return h ^ (h >> 16);
+}
+
+// Returns the position of <form> in <set>, or of the empty position where it
+// should be inserted.
+static UInt find_form(FormSet const* const set, Row const* const form) {
+  UInt const        width  = set->width;
+  Row const* const  forms  = FORMS(set);
+  UInt const* const stamps = STAMPS(set);
+  UInt              i      = hash_form(form, width) & (set->capacity - 1);
+  while (stamps[i] == set->now
+         && memcmp(forms + i * width, form, width * sizeof(Row)) != 0) {
+    i = (i + 1) & (set->capacity - 1);
+  }
+  return i;
+}
+
+static void grow_form_set(FormSet* const set) {
+  UInt const width    = set->width;
+  UInt const capacity = set->capacity;
+  Obj const  old      = set->forms;
+  Obj const  old_st   = set->stamps;
+  UInt const now      = set->now;
+
+  alloc_form_set(set, 2 * capacity);
+  // The old strings can have moved when the new ones were allocated
+  Row const* const  forms  = (Row const*) CHARS_STRING(old);
+  UInt const* const stamps = (UInt const*) CHARS_STRING(old_st);
+  for (UInt i = 0; i < capacity; i++) {
+    if (stamps[i] == now) {
+      UInt const j = find_form(set, forms + i * width);
+      memcpy(FORMS(set) + j * width, forms + i * width, width * sizeof(Row));
+      STAMPS(set)[j] = set->now;
+    }
+  }
+}
+
+// Returns true if <form> was not already in <set>, and adds it.
+static bool add_form(FormSet* const set, Row const* const form) {
+  UInt const i = find_form(set, form);
+  if (STAMPS(set)[i] == set->now) {
+    return false;
+  }
+  memcpy(FORMS(set) + i * set->width, form, set->width * sizeof(Row));
+  STAMPS(set)[i] = set->now;
+  if (2 * ++set->size > set->capacity) {
+    grow_form_set(set);
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Canonical labelling
+////////////////////////////////////////////////////////////////////////////////
+
+static UInt find_orbit(Gen* const g, UInt v) {
+  while (g->orbits[v] != v) {
+    g->orbits[v] = g->orbits[g->orbits[v]];
+    v            = g->orbits[v];
+  }
+  return v;
+}
+
+static void
+aut_hook(void* user_param, unsigned int N, unsigned int const* aut) {
+  Gen* const g = (Gen*) user_param;
+  g->nr_gens++;
+  for (UInt v = 0; v < g->k; v++) {
+    UInt const x = find_orbit(g, v);
+    UInt const y = find_orbit(g, aut[v]);
+    if (x < y) {
+      g->orbits[y] = x;
+    } else if (y < x) {
+      g->orbits[x] = y;
+    }
+  }
+}
+
+// Returns a bliss graph with the same automorphisms as the digraph induced on
+// 0, ..., k - 1. A digraph is encoded as an undirected graph in the same way
+// as in buildBlissDigraph, i.e. the vertices k + v and 2k + v have colours 1
+// and 2, the vertex 2k + v is adjacent to v and k + v, and the edge [u, w]
+// becomes the edge {u, k + w}.
+static BlissGraph* new_bliss_graph(Gen const* const g, UInt const k) {
+  BlissGraph* graph = bliss_digraphs_new(k);
+  if (g->kind == GRAPHS) {
+    for (UInt u = 0; u < k; u++) {
+      for (UInt w = u + 1; w < k; w++) {
+        if (g->out[u] & ((Row) 1 << w)) {
+          bliss_digraphs_add_edge(graph, u, w);
+        }
+      }
+    }
+    return graph;
+  }
+  for (UInt v = 0; v < k; v++) {
+    bliss_digraphs_add_vertex(graph, 1);
+  }
+  for (UInt v = 0; v < k; v++) {
+    bliss_digraphs_add_vertex(graph, 2);
+    bliss_digraphs_add_edge(graph, v, 2 * k + v);
+    bliss_digraphs_add_edge(graph, k + v, 2 * k + v);
+  }
+  for (UInt u = 0; u < k; u++) {
+    for (UInt w = 0; w < k; w++) {
+      if (g->out[u] & ((Row) 1 << w)) {
+        bliss_digraphs_add_edge(graph, u, k + w);
+      }
+    }
+  }
+  return graph;
+}
+
+// Returns true if the vertex k - 1 of the digraph induced on 0, ..., k - 1 is
+// in the same orbit as the vertex that would be removed from its canonical
+// form, in which case the canonical form is stored in g->form. This also sets
+// g->has_auts[k].
+static bool is_canonical(Gen* const g, UInt const k) {
+  DIGRAPHS_ASSERT(k > 0);
+  BlissGraph* graph = new_bliss_graph(g, k);
+  for (UInt v = 0; v < k; v++) {
+    g->orbits[v] = v;
+  }
+  g->nr_gens = 0;
+  g->k       = k;
+  unsigned int const* lab =
+      bliss_digraphs_find_canonical_labeling(graph, aut_hook, g, NULL);
+  g->has_auts[k] = (g->nr_gens > 0);
+
+  // Acyclic digraphs are extended by adding sinks, and so only a sink can be
+  // removed.
+  UInt w = k;
+  for (UInt v = 0; v < k; v++) {
+    if ((g->kind != DAGS || g->out[v] == 0) && (w == k || lab[v] > lab[w])) {
+      w = v;
+    }
+  }
+  DIGRAPHS_ASSERT(w < k);
+  bool const result = (find_orbit(g, w) == find_orbit(g, k - 1));
+
+  if (result) {
+    // The vertices 0, ..., k - 1 are not necessarily given the canonical
+    // labels 0, ..., k - 1, but their relative order is what matters.
+    UInt rank[GENERATE_MAXVERTS];
+    for (UInt v = 0; v < k; v++) {
+      rank[v] = 0;
+      for (UInt u = 0; u < k; u++) {
+        rank[v] += (lab[u] < lab[v]);
+      }
+      g->form[v] = 0;
+    }
+    for (UInt u = 0; u < k; u++) {
+      for (UInt v = 0; v < k; v++) {
+        if (g->out[u] & ((Row) 1 << v)) {
+          g->form[rank[u]] |= (Row) 1 << rank[v];
+        }
+      }
+    }
+  }
+  bliss_digraphs_release(graph);
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The search
+////////////////////////////////////////////////////////////////////////////////
+
+// Add the vertex k, with out-neighbours <out> and in-neighbours <in>, and
+// return false if the resulting digraph, and every digraph obtained from it
+// by adding vertices, violates the bounds on the degrees or edges.
+static bool
+add_vertex(Gen* const g, UInt const k, Row const out, Row const in) {
+  Row const bit = (Row) 1 << k;
+  g->out[k]     = out;
+  g->in[k]      = in;
+  for (UInt v = 0; v < k; v++) {
+    if (out & ((Row) 1 << v)) {
+      g->in[v] |= bit;
+    }
+    if (in & ((Row) 1 << v)) {
+      g->out[v] |= bit;
+    }
+  }
+  // If the digraph is a graph, then <out> and <in> are equal, and so every
+  // edge is counted twice, as by DigraphNrEdges.
+  g->nr_edges += popcount(out) + popcount(in);
+
+  if (g->nr_edges > g->max_edges
+      || g->nr_edges + g->future[k + 1] < g->min_edges) {
+    return false;
+  }
+  UInt const rest = g->n - k - 1;
+  for (UInt v = 0; v <= k; v++) {
+    UInt const d_out = popcount(g->out[v]);
+    UInt const d_in  = popcount(g->in[v]);
+    if (d_out > g->max_deg || d_in > g->max_deg || d_out + rest < g->min_deg
+        || d_in + rest < g->min_deg) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void remove_vertex(Gen* const g, UInt const k) {
+  Row const mask = ~((Row) 1 << k);
+  g->nr_edges -= popcount(g->out[k]) + popcount(g->in[k]);
+  for (UInt v = 0; v < k; v++) {
+    g->out[v] &= mask;
+    g->in[v] &= mask;
+  }
+  g->out[k] = 0;
+  g->in[k]  = 0;
+}
+
+// Returns the list of out-neighbours of the digraph induced on 0, ..., k - 1.
+static Obj out_neighbours(Gen const* const g, UInt const k) {
+  Obj out = NEW_PLIST(k == 0 ? T_PLIST_EMPTY : T_PLIST_TAB, k);
+  SET_LEN_PLIST(out, k);
+  for (UInt u = 0; u < k; u++) {
+    UInt const len = popcount(g->out[u]);
+    Obj nbs = NEW_PLIST(len == 0 ? T_PLIST_EMPTY : T_PLIST_CYC_SSORT, len);
+    SET_LEN_PLIST(nbs, len);
+    UInt i = 1;
+    for (UInt w = 0; w < k; w++) {
+      if (g->out[u] & ((Row) 1 << w)) {
+        SET_ELM_PLIST(nbs, i++, INTOBJ_INT(w + 1));
+      }
+    }
+    SET_ELM_PLIST(out, u + 1, nbs);
+    CHANGED_BAG(out);
+  }
+  return out;
+}
+
+// Returns the graph6 string of the current digraph if it is a graph, and its
+// digraph6 string otherwise, as produced by Graph6String and Digraph6String.
+static Obj graph6_string(Gen const* const g) {
+  // At most 2 + ceil(32 * 32 / 6) characters are required
+  char       str[2 + (GENERATE_MAXVERTS * GENERATE_MAXVERTS + 5) / 6 + 1];
+  UInt const n   = g->n;
+  UInt       len = 0, nr_bits = 0, block = 0;
+  if (g->kind != GRAPHS) {
+    str[len++] = '&';
+  }
+  str[len++] = (char) (n + 63);
+  for (UInt i = 0; i < n; i++) {
+    // The upper triangle of the adjacency matrix, column by column, for a
+    // graph, and the whole matrix, row by row, for a digraph
+    for (UInt j = 0; j < n; j++) {
+      bool bit;
+      if (g->kind == GRAPHS) {
+        if (j >= i) {
+          break;
+        }
+        bit = g->out[j] & ((Row) 1 << i);
+      } else {
+        bit = g->out[i] & ((Row) 1 << j);
+      }
+      block = (block << 1) | bit;
+      if (++nr_bits == 6) {
+        str[len++] = (char) (block + 63);
+        nr_bits    = 0;
+        block      = 0;
+      }
+    }
+  }
+  if (nr_bits > 0) {
+    str[len++] = (char) ((block << (6 - nr_bits)) + 63);
+  }
+  str[len] = '\0';
+  return MakeImmString(str);
+}
+
+static void search(Gen* const g, UInt const k) {
+  if (k == g->split && g->mod > 1 && g->nr_split++ % g->mod != g->res) {
+    return;
+  } else if (k == g->n) {
+    CALL_1ARGS(g->hook, g->strings ? graph6_string(g) : out_neighbours(g, k));
+    g->nr_found++;
+    return;
+  }
+
+  FormSet* set = NULL;
+  if (g->has_auts[k]) {
+    set = &g->sets[k];
+    clear_form_set(set);
+  }
+
+  Row const      all = ((Row) 1 << k) - 1;
+  uint64_t const nr =
+      (uint64_t) 1 << (g->kind == DIGRAPHS ? 2 * k : k);
+  for (uint64_t x = 0; x < nr; x++) {
+    Row out = 0, in = 0;
+    switch (g->kind) {
+      case GRAPHS:
+        out = in = (Row) x;
+        break;
+      case DIGRAPHS:
+        out = (Row) x & all;
+        in  = (Row) (x >> k);
+        break;
+      case TOURNAMENTS:
+        out = (Row) x;
+        in  = ~out & all;
+        break;
+      case DAGS:
+        in = (Row) x;
+        break;
+    }
+    if (add_vertex(g, k, out, in) && is_canonical(g, k + 1)
+        && (set == NULL || add_form(set, g->form))
+        && (g->filter == Fail
+            || CALL_1ARGS(g->filter, out_neighbours(g, k + 1)) == True)) {
+      search(g, k + 1);
+    }
+    remove_vertex(g, k);
+  }
+}
+
+// The argument <opts> must be a record with components:
+//
+//   kind:      one of "graphs", "digraphs", "tournaments", or "dags"
+//   min_deg:   the least out- and in-degree of every vertex
+//   max_deg:   the largest out- and in-degree of every vertex
+//   min_edges: the least number of edges
+//   max_edges: the largest number of edges
+//   res, mod:  integers with 0 <= res < mod
+//   filter:    fail, or a function which is called with the out-neighbours of
+//              every digraph that is found, including those with fewer than
+//              <n> vertices, and which returns false if the digraph, and
+//              every digraph obtained from it by adding vertices, should be
+//              discarded
+//   hook:      a function which is called with every digraph with <n>
+//              vertices that is found
+//   strings:   if true, then <hook> is called with the graph6 or digraph6
+//              strings of the digraphs, and otherwise with their
+//              out-neighbours
+//
+// Returns the number of digraphs found, one from every isomorphism class of
+// digraphs with <n> vertices and no loops or multiple edges of the specified
+// kind which satisfy the constraints, split into <mod> roughly equal parts of
+// which only the <res>th is found.
+Obj FuncDIGRAPHS_GENERATE(Obj self, Obj n, Obj opts) {
+  DIGRAPHS_ASSERT(IS_INTOBJ(n));
+  DIGRAPHS_ASSERT(0 <= INT_INTOBJ(n) && INT_INTOBJ(n) <= GENERATE_MAXVERTS);
+  DIGRAPHS_ASSERT(IS_PREC(opts));
+
+  // The search data is kept on the stack, and the sets of canonical forms in
+  // GAP strings, so that nothing is leaked if <filter> or <hook> raises an
+  // error. The strings are reachable from <g>, which the garbage collector
+  // scans since it is on the stack.
+  Gen  data;
+  Gen* g = &data;
+  memset(g, 0, sizeof(Gen));
+  g->n = INT_INTOBJ(n);
+
+  char const* kind = CONST_CSTR_STRING(ElmPRec(opts, RNamName("kind")));
+  if (strcmp(kind, "graphs") == 0) {
+    g->kind = GRAPHS;
+  } else if (strcmp(kind, "digraphs") == 0) {
+    g->kind = DIGRAPHS;
+  } else if (strcmp(kind, "tournaments") == 0) {
+    g->kind = TOURNAMENTS;
+  } else {
+    DIGRAPHS_ASSERT(strcmp(kind, "dags") == 0);
+    g->kind = DAGS;
+  }
+  g->min_deg   = INT_INTOBJ(ElmPRec(opts, RNamName("min_deg")));
+  g->max_deg   = INT_INTOBJ(ElmPRec(opts, RNamName("max_deg")));
+  g->min_edges = INT_INTOBJ(ElmPRec(opts, RNamName("min_edges")));
+  g->max_edges = INT_INTOBJ(ElmPRec(opts, RNamName("max_edges")));
+  g->res       = INT_INTOBJ(ElmPRec(opts, RNamName("res")));
+  g->mod       = INT_INTOBJ(ElmPRec(opts, RNamName("mod")));
+  g->filter    = ElmPRec(opts, RNamName("filter"));
+  g->hook      = ElmPRec(opts, RNamName("hook"));
+  g->strings   = (ElmPRec(opts, RNamName("strings")) == True);
+  g->split     = (g->n > 2 ? g->n - 2 : g->n);
+
+  UInt const per_vertex = (g->kind == GRAPHS || g->kind == DIGRAPHS ? 2 : 1);
+  g->future[g->n]       = 0;
+  for (UInt k = g->n; k > 0; k--) {
+    g->future[k - 1] = g->future[k] + per_vertex * (k - 1);
+  }
+  for (UInt k = 0; k <= g->n; k++) {
+    init_form_set(&g->sets[k], k + 1);
+  }
+
+  search(g, 0);
+  return INTOBJ_INT(g->nr_found);
+}
@@ -0,0 +1,22 @@
+/********************************************************************************
+**
+*A  generate.h             generating digraphs up to isomorphism
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_GENERATE_H_
+#define DIGRAPHS_SRC_GENERATE_H_
+
+// GAP headers
+#include "gap-includes.h"  // for Obj
+
+// The maximum number of vertices of the digraphs which can be generated.
+#define GENERATE_MAXVERTS 32
+
+Obj FuncDIGRAPHS_GENERATE(Obj self, Obj n, Obj opts);
+
+#endif  // DIGRAPHS_SRC_GENERATE_H_
@@ -32,6 +32,7 @@
 #include <stddef.h>   // for NULL
 #include <stdint.h>   // for uint16_t, uint64_t
 #include <stdlib.h>   // for malloc, NULL
+#include <string.h>   // for strcmp
 
 #ifdef DIGRAPHS_ENABLE_STATS
 #include <cstdio>  // for printf
@@ -72,28 +73,28 @@ uint16_t HOMOS_STRUCTURE_SIZE = 0;
 uint16_t UNDEFINED = 65535;
 #endif
 
-// The next line can be used instead of the first line of STORE_MIN to
-// randomise which vertex of minimum degree is used next, but I didn't find any
-// cases where this made things faster.
+// The next position in MAP to fill is the position y with the least value of
+// choice_key(x, y), where x is the number of candidates for MAP[y]. The key is
+// 1 if and only if x is 1, in which case we don't need to look any further.
 
-// if (x < current_x || (x == current_x && (rand() & 1))) {
-
-#define STORE_MIN(current_x, current_y, x, y) \
-  if (x < current_x) {                        \
-    current_x = x;                            \
-    current_y = y;                            \
+#define STORE_MIN(current_x, current_y, x, y)  \
+  {                                            \
+    uint64_t const __key = choice_key(x, y);   \
+    if (__key < current_x) {                   \
+      current_x = __key;                       \
+      current_y = y;                           \
+    }                                          \
   }
 
-// See the comment before STORE_MIN
-
-// if (x < current_x || (x == current_x && (rand() & 1))) {
-
 #define STORE_MIN_BREAK(current_x, current_y, x, y) \
-  if (x < current_x) {                              \
-    current_x = x;                                  \
-    current_y = y;                                  \
-    if (current_x == 1) {                           \
-      break;                                        \
+  {                                                 \
+    uint64_t const __key = choice_key(x, y);        \
+    if (__key < current_x) {                        \
+      current_x = __key;                            \
+      current_y = y;                                \
+      if (current_x == 1) {                         \
+        break;                                      \
+      }                                             \
     }                                               \
   }
 
@@ -144,6 +145,7 @@ extern Obj IsPermGroup;
 extern Obj IsDigraphAutomorphism;
 extern Obj LargestMovedPointPerms;
 extern Obj InfoWarning;
+extern Obj ValueOption;
 
 ////////////////////////////////////////////////////////////////////////////////
 // 3. Global variables
@@ -158,11 +160,29 @@ static void* USER_PARAM;  // a USER_PARAM for the hook
 
 static jmp_buf OUTOFHERE;  // so we can jump out of the deepest
 
+// The heuristics for choosing the next position in MAP to fill, see
+// choice_key.
+typedef enum {
+  HEURISTIC_DOM,       // fewest candidates
+  HEURISTIC_DOM_DEG,   // fewest candidates divided by degree
+  HEURISTIC_DOM_WDEG,  // fewest candidates divided by conflict weight
+  HEURISTIC_RESTARTS   // fewest candidates, random ties, restarts
+} Heuristic;
+
+static Heuristic HEURISTIC = HEURISTIC_DOM;
+
+static uint64_t  FAILURES;       // dead branches since the last restart
+static uint64_t  RESTART_LIMIT;  // restart after this many dead branches
+static uint64_t  RANDOM_STATE;   // state of the random number generator
+static uint32_t* RANDOM_KEYS = NULL;  // for breaking ties randomly
+static uint64_t* WEIGHTS     = NULL;  // (conflict) weights of positions in MAP
+
 static bool ORDERED;  // true if the vertices of the domain/source digraph
                       // should be considered in a different order than they are
                       // given, false otherwise.
 
 static BitArray** BIT_ARRAY_BUFFER = NULL;  // A buffer
+static BitArray** DOMAINS = NULL;           // Values for monos/embeddings
 static BitArray*  IMAGE_RESTRICT;           // Values in MAP must be in this
 static BitArray** MAP_UNDEFINED = NULL;     // UNDEFINED positions in MAP
 static BitArray*  ORB_LOOKUP;               // points in orbit
@@ -307,6 +327,8 @@ Obj  FuncDIGRAPHS_FREE_HOMOS_DATA(Obj self) {
     free(MAP_BUFFER);
     free(ORB);
     free(ORDER);
+    free(RANDOM_KEYS);
+    free(WEIGHTS);
 
     for (uint16_t i = 0; i < HOMOS_STRUCTURE_SIZE * 3; i++) {
       bliss_digraphs_release(BLISS_GRAPH[i]);
@@ -315,6 +337,7 @@ Obj  FuncDIGRAPHS_FREE_HOMOS_DATA(Obj self) {
     for (uint16_t i = 0; i < HOMOS_STRUCTURE_SIZE; i++) {
       free_bit_array(REPS[i]);
       free_bit_array(BIT_ARRAY_BUFFER[i]);
+      free_bit_array(DOMAINS[i]);
       free_bit_array(MAP_UNDEFINED[i]);
       free_perm_coll(STAB_GENS[i]);
     }
@@ -322,6 +345,7 @@ Obj  FuncDIGRAPHS_FREE_HOMOS_DATA(Obj self) {
     free(BLISS_GRAPH);
     free(REPS);
     free(BIT_ARRAY_BUFFER);
+    free(DOMAINS);
     free(MAP_UNDEFINED);
     free(STAB_GENS);
     free_bit_array(VALS);
@@ -463,8 +487,10 @@ static bool compute_stabs_and_orbit_reps(uint16_t const nr_nodes_1,
     // not initialised.
     return false;  // This doesn't really say anything about the stabiliser
   } else if (rep_depth > 0) {
-    point_stabilizer(
-        SCHREIER_SIMS, STAB_GENS[rep_depth - 1], STAB_GENS[rep_depth], pt);
+    // The first rep_depth - 1 base points of SCHREIER_SIMS are the values
+    // which were fixed before pt, and so its level rep_depth - 1 is generated
+    // by STAB_GENS[rep_depth - 1].
+    point_stabilizer(SCHREIER_SIMS, rep_depth - 1, pt, STAB_GENS[rep_depth]);
     if (STAB_GENS[rep_depth]->size == 0) {
       // the stabiliser of pt in STAB_GENS[rep_depth - 1] is trivial
       copy_bit_array(REPS[rep_depth], IMAGE_RESTRICT, nr_nodes_2);
@@ -584,6 +610,110 @@ static void set_automorphisms(Obj aut_grp_obj, PermColl* out) {
   }
 }
 
+// A xorshift generator, so that the searches with HEURISTIC_RESTARTS are
+// reproducible.
+static inline uint32_t next_random(void) {
+  RANDOM_STATE ^= RANDOM_STATE << 13;
+  RANDOM_STATE ^= RANDOM_STATE >> 7;
+  RANDOM_STATE ^= RANDOM_STATE << 17;
+  return (uint32_t) (RANDOM_STATE >> 32);
+}
+
+// Returns the key used by STORE_MIN for the position <i> in MAP with <n>
+// candidates. The key is n if n <= 1, and so such positions are always chosen
+// first, and otherwise it is at least 2.
+static ALWAYS_INLINE uint64_t choice_key(uint16_t const n, uint16_t const i) {
+  if (HEURISTIC == HEURISTIC_DOM || n <= 1) {
+    return n;
+  } else if (HEURISTIC == HEURISTIC_RESTARTS) {
+    return ((uint64_t) n << 32) | RANDOM_KEYS[i];
+  }
+  DIGRAPHS_ASSERT(WEIGHTS[i] > 0);
+  return 2 + ((uint64_t) n << 32) / WEIGHTS[i];
+}
+
+// Called when the candidates for position <i> in MAP are exhausted after the
+// position <pos> was filled, and <count> results have been found so far.
+static ALWAYS_INLINE void record_dead_branch(uint16_t const i,
+                                             uint16_t const pos,
+                                             uint64_t const count) {
+  if (HEURISTIC == HEURISTIC_DOM_WDEG) {
+    WEIGHTS[i]++;
+    WEIGHTS[pos]++;
+  } else if (HEURISTIC == HEURISTIC_RESTARTS && count == 0
+             && ++FAILURES == RESTART_LIMIT) {
+    // Nothing has been found, and so nothing is lost by starting again
+    longjmp(OUTOFHERE, 2);
+  }
+}
+
+// Initialise WEIGHTS, RANDOM_KEYS, and the restart counters for the heuristic
+// HEURISTIC, where <nbs> are the neighbours (or out-neighbours) of the
+// vertices of the first (di)graph and <in_nbs> are its in-neighbours (or NULL
+// for graphs).
+static void init_heuristic(BitArray* const* const nbs,
+                           BitArray* const* const in_nbs,
+                           uint16_t const         nr) {
+  for (uint16_t i = 0; i < nr; i++) {
+    WEIGHTS[i] = size_bit_array(nbs[i], nr) + 1;
+    if (in_nbs != NULL) {
+      WEIGHTS[i] += size_bit_array(in_nbs[i], nr);
+    }
+    RANDOM_KEYS[i] = next_random();
+  }
+  FAILURES      = 0;
+  RESTART_LIMIT = 64;
+}
+
+// Reset MAP, VALS, MAP_UNDEFINED, and CONDITIONS to the state they were in
+// after init_data_from_args, so that another search can be started without
+// recomputing the conditions, the automorphisms, or the orbit reps.
+static void reset_search(uint16_t const nr1, uint16_t const nr2) {
+  for (uint16_t depth = 1; depth < nr1; depth++) {
+    pop_conditions(CONDITIONS, depth);
+  }
+  for (uint16_t i = 0; i < nr1; i++) {
+    MAP[i] = UNDEFINED;
+  }
+  init_bit_array(MAP_UNDEFINED[0], true, nr1);
+  init_bit_array(VALS, false, nr2);
+}
+
+// Reset the search so that it can be restarted, with a new random
+// tie-breaking and twice as many dead branches permitted.
+static void restart_search(uint16_t const nr1, uint16_t const nr2) {
+  reset_search(nr1, nr2);
+  for (uint16_t i = 0; i < nr1; i++) {
+    RANDOM_KEYS[i] = next_random();
+  }
+  FAILURES = 0;
+  RESTART_LIMIT *= 2;
+}
+
+// Returns the <i>-th rank in <hint_obj>, which is fail, a positive integer, or
+// a list of positive integers. The value returned is UNDEFINED if <hint_obj>
+// is fail, and 0 if there are no homomorphisms of that rank, because it
+// exceeds the number of vertices of either digraph, or the number of possible
+// images <nr_image>, or the homomorphisms are <injective> and the rank is not
+// <nr1>.
+static uint16_t get_hint(Obj const      hint_obj,
+                         Int const      i,
+                         uint16_t const nr1,
+                         uint16_t const nr2,
+                         Int const      nr_image,
+                         bool const     injective) {
+  if (hint_obj == Fail) {
+    return UNDEFINED;
+  }
+  Int const hint =
+      INT_INTOBJ(IS_INTOBJ(hint_obj) ? hint_obj : ELM_LIST(hint_obj, i));
+  if (hint > nr1 || hint > nr2 || hint > nr_image
+      || (injective && hint != nr1)) {
+    return 0;
+  }
+  return hint;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 6. The main recursive functions (and helpers)
 ////////////////////////////////////////////////////////////////////////////////
@@ -645,10 +775,18 @@ static void find_graph_homos(uint16_t        depth,
       longjmp(OUTOFHERE, 1);
     }
     return;
+  } else if (hint != UNDEFINED
+             && (uint64_t) (rank + GRAPH1->nr_vertices - depth) < hint) {
+    // Every unassigned position in MAP contributes at most one new value, and
+    // so no extension of MAP has rank equal to hint.
+#ifdef DIGRAPHS_ENABLE_STATS
+    STATS->nr_dead_branches++;
+#endif
+    return;
   }
 
-  uint16_t next = 0;          // the next position to fill
-  uint16_t min  = UNDEFINED;  // the minimum number of candidates for MAP[next]
+  uint16_t next = 0;           // the next position to fill
+  uint64_t min  = UINT64_MAX;  // the least choice_key, see STORE_MIN
   uint16_t i;
 
   BitArray* possible = BIT_ARRAY_BUFFER[depth];
@@ -666,6 +804,7 @@ static void find_graph_homos(uint16_t        depth,
         STATS->nr_dead_branches++;
 #endif
         pop_conditions(CONDITIONS, depth);
+        record_dead_branch(i, pos, *count);
         return;
       }
       STORE_MIN(min, next, n, i);
@@ -750,6 +889,21 @@ static void find_graph_homos(uint16_t        depth,
   pop_conditions(CONDITIONS, depth);
 }
 
+// Returns true if CONDITIONS[i] and DOMAINS[i] have a value in common, i.e. if
+// some value for position i in MAP could still be extended to a monomorphism
+// or embedding.
+static ALWAYS_INLINE bool has_possible_value(uint16_t const i,
+                                             uint16_t const nr_bits) {
+  Block const* const cond = get_conditions(CONDITIONS, i)->blocks;
+  Block const* const dom  = DOMAINS[i]->blocks;
+  for (uint16_t k = 0; k < number_of_blocks(nr_bits); k++) {
+    if (cond[k] & dom[k]) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // Helper for the main recursive monomorphism function.
 static ALWAYS_INLINE uint16_t
 graph_mono_update_conditions(uint16_t const depth,
@@ -798,8 +952,8 @@ static void find_graph_monos(uint16_t        depth,
     return;
   }
 
-  uint16_t next = 0;          // the next position to fill
-  uint16_t min  = UNDEFINED;  // the minimum number of candidates for MAP[next]
+  uint16_t next = 0;           // the next position to fill
+  uint64_t min  = UINT64_MAX;  // the least choice_key, see STORE_MIN
   uint16_t i;
 
   BitArray* possible = BIT_ARRAY_BUFFER[depth];
@@ -812,11 +966,12 @@ static void find_graph_monos(uint16_t        depth,
         possible, GRAPH1->neighbours[pos], GRAPH1->nr_vertices);
     FOR_SET_BITS(possible, GRAPH1->nr_vertices, i) {
       size_t const n = graph_mono_update_conditions(depth, pos, i);
-      if (n == 0) {
+      if (n == 0 || !has_possible_value(i, GRAPH2->nr_vertices)) {
 #ifdef DIGRAPHS_ENABLE_STATS
         STATS->nr_dead_branches++;
 #endif
         pop_conditions(CONDITIONS, depth);
+        record_dead_branch(i, pos, *count);
         return;
       }
       STORE_MIN(min, next, n, i);
@@ -841,6 +996,7 @@ static void find_graph_monos(uint16_t        depth,
   copy_bit_array(
       possible, get_conditions(CONDITIONS, next), GRAPH2->nr_vertices);
   intersect_bit_arrays(possible, REPS[rep_depth], GRAPH2->nr_vertices);
+  intersect_bit_arrays(possible, DOMAINS[next], GRAPH2->nr_vertices);
   complement_bit_arrays(possible, VALS, GRAPH2->nr_vertices);
   FOR_SET_BITS(possible, GRAPH2->nr_vertices, i) {
     MAP[next] = i;
@@ -920,8 +1076,8 @@ static void find_graph_embeddings(uint16_t        depth,
     return;
   }
 
-  uint16_t next = 0;          // the next position to fill
-  uint16_t min  = UNDEFINED;  // the minimum number of candidates for MAP[next]
+  uint16_t next = 0;           // the next position to fill
+  uint64_t min  = UINT64_MAX;  // the least choice_key, see STORE_MIN
   uint16_t i;
 
   BitArray* possible = BIT_ARRAY_BUFFER[depth];
@@ -935,11 +1091,12 @@ static void find_graph_embeddings(uint16_t        depth,
     FOR_SET_BITS(possible, GRAPH1->nr_vertices, i) {
       size_t const n =
           graph_embed_update_conditions(depth, pos, i, &intersect_bit_arrays);
-      if (n == 0) {
+      if (n == 0 || !has_possible_value(i, GRAPH2->nr_vertices)) {
 #ifdef DIGRAPHS_ENABLE_STATS
         STATS->nr_dead_branches++;
 #endif
         pop_conditions(CONDITIONS, depth);
+        record_dead_branch(i, pos, *count);
         return;
       }
       STORE_MIN(min, next, n, i);
@@ -951,11 +1108,12 @@ static void find_graph_embeddings(uint16_t        depth,
     FOR_SET_BITS(possible, GRAPH1->nr_vertices, i) {
       size_t const n =
           graph_embed_update_conditions(depth, pos, i, &complement_bit_arrays);
-      if (n == 0) {
+      if (n == 0 || !has_possible_value(i, GRAPH2->nr_vertices)) {
 #ifdef DIGRAPHS_ENABLE_STATS
         STATS->nr_dead_branches++;
 #endif
         pop_conditions(CONDITIONS, depth);
+        record_dead_branch(i, pos, *count);
         return;
       }
       STORE_MIN(min, next, n, i);
@@ -971,6 +1129,7 @@ static void find_graph_embeddings(uint16_t        depth,
   copy_bit_array(
       possible, get_conditions(CONDITIONS, next), GRAPH2->nr_vertices);
   intersect_bit_arrays(possible, REPS[rep_depth], GRAPH2->nr_vertices);
+  intersect_bit_arrays(possible, DOMAINS[next], GRAPH2->nr_vertices);
   complement_bit_arrays(possible, VALS, GRAPH2->nr_vertices);
 
   FOR_SET_BITS(possible, GRAPH2->nr_vertices, i) {
@@ -1196,10 +1355,18 @@ static void find_digraph_homos(uint16_t        depth,
       longjmp(OUTOFHERE, 1);
     }
     return;
+  } else if (hint != UNDEFINED
+             && (uint64_t) (rank + DIGRAPH1->nr_vertices - depth) < hint) {
+    // Every unassigned position in MAP contributes at most one new value, and
+    // so no extension of MAP has rank equal to hint.
+#ifdef DIGRAPHS_ENABLE_STATS
+    STATS->nr_dead_branches++;
+#endif
+    return;
   }
 
-  uint16_t next = 0;          // the next position to fill
-  uint16_t min  = UNDEFINED;  // the minimum number of candidates for MAP[next]
+  uint16_t next = 0;           // the next position to fill
+  uint64_t min  = UINT64_MAX;  // the least choice_key, see STORE_MIN
   uint16_t i;
 
   if (depth > 0) {  // this is not the first call of the function
@@ -1212,6 +1379,7 @@ static void find_digraph_homos(uint16_t        depth,
         STATS->nr_dead_branches++;
 #endif
         pop_conditions(CONDITIONS, depth);
+        record_dead_branch(i, pos, *count);
         return;
       }
       STORE_MIN(min, next, n, i);
@@ -1344,8 +1512,8 @@ static void find_digraph_monos(uint16_t        depth,
     return;
   }
 
-  uint16_t next = 0;          // the next position to fill
-  uint16_t min  = UNDEFINED;  // the minimum number of candidates for MAP[next]
+  uint16_t next = 0;           // the next position to fill
+  uint64_t min  = UINT64_MAX;  // the least choice_key, see STORE_MIN
   uint16_t i;
 
   if (depth > 0) {  // this is not the first call of the function
@@ -1353,11 +1521,12 @@ static void find_digraph_monos(uint16_t        depth,
         MAP_UNDEFINED[depth], MAP_UNDEFINED[depth - 1], DIGRAPH1->nr_vertices);
     FOR_SET_BITS(MAP_UNDEFINED[depth], DIGRAPH1->nr_vertices, i) {
       size_t const n = digraph_mono_update_conditions(depth, pos, i);
-      if (n == 0) {
+      if (n == 0 || !has_possible_value(i, DIGRAPH2->nr_vertices)) {
 #ifdef DIGRAPHS_ENABLE_STATS
         STATS->nr_dead_branches++;
 #endif
         pop_conditions(CONDITIONS, depth);
+        record_dead_branch(i, pos, *count);
         return;
       }
       STORE_MIN(min, next, n, i);
@@ -1374,6 +1543,7 @@ static void find_digraph_monos(uint16_t        depth,
   copy_bit_array(
       possible, get_conditions(CONDITIONS, next), DIGRAPH2->nr_vertices);
   intersect_bit_arrays(possible, REPS[rep_depth], DIGRAPH2->nr_vertices);
+  intersect_bit_arrays(possible, DOMAINS[next], DIGRAPH2->nr_vertices);
   complement_bit_arrays(possible, VALS, DIGRAPH2->nr_vertices);
   FOR_SET_BITS(possible, DIGRAPH2->nr_vertices, i) {
     MAP[next] = i;
@@ -1467,8 +1637,8 @@ static void find_digraph_embeddings(uint16_t        depth,
     return;
   }
 
-  uint16_t next = 0;          // the next position to fill
-  uint16_t min  = UNDEFINED;  // the minimum number of candidates for MAP[next]
+  uint16_t next = 0;           // the next position to fill
+  uint64_t min  = UINT64_MAX;  // the least choice_key, see STORE_MIN
   uint16_t i;
 
   if (depth > 0) {  // this is not the first call of the function
@@ -1476,11 +1646,12 @@ static void find_digraph_embeddings(uint16_t        depth,
         MAP_UNDEFINED[depth], MAP_UNDEFINED[depth - 1], DIGRAPH1->nr_vertices);
     FOR_SET_BITS(MAP_UNDEFINED[depth], DIGRAPH1->nr_vertices, i) {
       size_t const n = digraph_embed_update_conditions(depth, pos, i);
-      if (n == 0) {
+      if (n == 0 || !has_possible_value(i, DIGRAPH2->nr_vertices)) {
 #ifdef DIGRAPHS_ENABLE_STATS
         STATS->nr_dead_branches++;
 #endif
         pop_conditions(CONDITIONS, depth);
+        record_dead_branch(i, pos, *count);
         return;
       }
       STORE_MIN(min, next, n, i);
@@ -1497,6 +1668,7 @@ static void find_digraph_embeddings(uint16_t        depth,
   copy_bit_array(
       possible, get_conditions(CONDITIONS, next), DIGRAPH2->nr_vertices);
   intersect_bit_arrays(possible, REPS[rep_depth], DIGRAPH2->nr_vertices);
+  intersect_bit_arrays(possible, DOMAINS[next], DIGRAPH2->nr_vertices);
   complement_bit_arrays(possible, VALS, DIGRAPH2->nr_vertices);
 
   FOR_SET_BITS(possible, DIGRAPH2->nr_vertices, i) {
@@ -1631,6 +1803,248 @@ static void init_partial_map_and_find_digraph_homos(Obj partial_map_obj,
 // 7. The GAP-level function (and helpers)
 ////////////////////////////////////////////////////////////////////////////////
 
+// The next few functions compute DOMAINS before the search for monomorphisms
+// or embeddings begins. The (di)graphs are given by their out- and
+// in-neighbours, which coincide for graphs. DOMAINS[i] is the subset of
+// CONDITIONS[i] that contains the image of i under every monomorphism (or
+// embedding). Only information invariant under the automorphisms of the
+// second (di)graph is used, so that the orbit representatives in REPS remain
+// valid. The search uses DOMAINS to discard values, but not to decide which
+// vertex to define next, so that the results are found in the same order with
+// or without DOMAINS.
+
+static int cmp_uint16_desc(void const* a, void const* b) {
+  uint16_t const x = *((uint16_t const*) a);
+  uint16_t const y = *((uint16_t const*) b);
+  return (x < y) - (x > y);
+}
+
+// Returns the number of neighbours of <v> other than <v>.
+static inline uint16_t nr_neighbours_no_loop(BitArray const* const nbs,
+                                             uint16_t const        v,
+                                             uint16_t const        nr) {
+  return size_bit_array(nbs, nr) - (get_bit_array(nbs, v) ? 1 : 0);
+}
+
+// Returns an array containing, for every vertex <v>, the values deg[w] for
+// every w != v in nbs[v], in decreasing order, starting at position
+// offsets[v]. The array <offsets> must be of length nr + 1.
+static uint16_t* neighbour_degree_sequences(BitArray* const* const nbs,
+                                            uint16_t const* const  deg,
+                                            uint16_t const         nr,
+                                            size_t* const          offsets) {
+  offsets[0] = 0;
+  for (uint16_t v = 0; v < nr; v++) {
+    offsets[v + 1] = offsets[v] + deg[v];
+  }
+  uint16_t* seq = safe_malloc((offsets[nr] > 0 ? offsets[nr] : 1)
+                              * sizeof(uint16_t));
+  for (uint16_t v = 0; v < nr; v++) {
+    size_t   pos = offsets[v];
+    uint16_t w;
+    FOR_SET_BITS(nbs[v], nr, w) {
+      if (w != v) {
+        seq[pos++] = deg[w];
+      }
+    }
+    END_FOR_SET_BITS
+    DIGRAPHS_ASSERT(pos == offsets[v + 1]);
+    qsort(seq + offsets[v], deg[v], sizeof(uint16_t), cmp_uint16_desc);
+  }
+  return seq;
+}
+
+// Returns true if the decreasing sequence <seq1> of length <len1> is
+// pointwise at most the decreasing sequence <seq2> of length <len2>, which is
+// the case whenever seq1 is a subsequence of seq2 with every term increased.
+static bool is_dominated(uint16_t const* const seq1,
+                         uint16_t const        len1,
+                         uint16_t const* const seq2,
+                         uint16_t const        len2) {
+  if (len1 > len2) {
+    return false;
+  }
+  for (uint16_t i = 0; i < len1; i++) {
+    if (seq1[i] > seq2[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Removes every value w from DOMAINS[u] such that no value y != w in
+// DOMAINS[x] has the same adjacency to w as x has to u (or, for
+// monomorphisms, at least the edges that x has with u). Returns true if any
+// value was removed.
+static bool revise_injective_domains(BitArray* const* const out1,
+                                     BitArray* const* const out2,
+                                     BitArray* const* const in2,
+                                     uint16_t const         nr2,
+                                     uint16_t const         u,
+                                     uint16_t const         x,
+                                     bool const             induced) {
+  BitArray*       dom_u   = DOMAINS[u];
+  BitArray const* dom_x   = DOMAINS[x];
+  BitArray*       tmp     = BIT_ARRAY_BUFFER[0];
+  bool const      ux      = get_bit_array(out1[u], x);
+  bool const      xu      = get_bit_array(out1[x], u);
+  bool            changed = false;
+  uint16_t        w;
+
+  FOR_SET_BITS(dom_u, nr2, w) {
+    copy_bit_array(tmp, dom_x, nr2);
+    if (ux) {
+      intersect_bit_arrays(tmp, out2[w], nr2);
+    } else if (induced) {
+      complement_bit_arrays(tmp, out2[w], nr2);
+    }
+    if (xu) {
+      intersect_bit_arrays(tmp, in2[w], nr2);
+    } else if (induced) {
+      complement_bit_arrays(tmp, in2[w], nr2);
+    }
+    set_bit_array(tmp, w, false);
+    if (size_bit_array(tmp, nr2) == 0) {
+      set_bit_array(dom_u, w, false);
+      changed = true;
+    }
+  }
+  END_FOR_SET_BITS
+  return changed;
+}
+
+// Initialises DOMAINS from CONDITIONS, and restricts it using the (in- and
+// out-) degrees of the vertices, the degrees of their neighbours, and then arc
+// consistency with respect to the edges of the first (di)graph. The argument
+// <induced> should be true for embeddings and false for monomorphisms. Returns
+// false if some vertex of the first (di)graph has no possible values
+// remaining, and true otherwise.
+static bool init_injective_domains(BitArray* const* const out1,
+                                   BitArray* const* const in1,
+                                   uint16_t const         nr1,
+                                   BitArray* const* const out2,
+                                   BitArray* const* const in2,
+                                   uint16_t const         nr2,
+                                   bool const             directed,
+                                   bool const             induced) {
+  uint16_t* out_deg1 = safe_malloc(nr1 * sizeof(uint16_t));
+  uint16_t* in_deg1  = safe_malloc(nr1 * sizeof(uint16_t));
+  uint16_t* out_deg2 = safe_malloc(nr2 * sizeof(uint16_t));
+  uint16_t* in_deg2  = safe_malloc(nr2 * sizeof(uint16_t));
+  for (uint16_t v = 0; v < nr1; v++) {
+    out_deg1[v] = nr_neighbours_no_loop(out1[v], v, nr1);
+    in_deg1[v]  = nr_neighbours_no_loop(in1[v], v, nr1);
+  }
+  for (uint16_t v = 0; v < nr2; v++) {
+    out_deg2[v] = nr_neighbours_no_loop(out2[v], v, nr2);
+    in_deg2[v]  = nr_neighbours_no_loop(in2[v], v, nr2);
+  }
+
+  size_t*   out_off1 = safe_malloc((nr1 + 1) * sizeof(size_t));
+  size_t*   out_off2 = safe_malloc((nr2 + 1) * sizeof(size_t));
+  uint16_t* out_seq1 =
+      neighbour_degree_sequences(out1, out_deg1, nr1, out_off1);
+  uint16_t* out_seq2 =
+      neighbour_degree_sequences(out2, out_deg2, nr2, out_off2);
+  size_t*   in_off1  = NULL;
+  size_t*   in_off2  = NULL;
+  uint16_t* in_seq1  = NULL;
+  uint16_t* in_seq2  = NULL;
+  if (directed) {
+    in_off1 = safe_malloc((nr1 + 1) * sizeof(size_t));
+    in_off2 = safe_malloc((nr2 + 1) * sizeof(size_t));
+    in_seq1 = neighbour_degree_sequences(in1, in_deg1, nr1, in_off1);
+    in_seq2 = neighbour_degree_sequences(in2, in_deg2, nr2, in_off2);
+  }
+
+  bool     result = true;
+  uint16_t w;
+  for (uint16_t u = 0; u < nr1 && result; u++) {
+    BitArray const* cond = get_conditions(CONDITIONS, u);
+    BitArray*       dom  = DOMAINS[u];
+    init_bit_array(dom, false, nr2);
+    FOR_SET_BITS(cond, nr2, w) {
+      // The (non-)neighbours of u must map injectively to (non-)neighbours of
+      // w, and every neighbour of u must map to a vertex of at least its
+      // degree.
+      bool const keep =
+          out_deg1[u] <= out_deg2[w] && in_deg1[u] <= in_deg2[w]
+          && (!induced
+              || (nr1 - out_deg1[u] <= nr2 - out_deg2[w]
+                  && nr1 - in_deg1[u] <= nr2 - in_deg2[w]))
+          && is_dominated(out_seq1 + out_off1[u],
+                          out_deg1[u],
+                          out_seq2 + out_off2[w],
+                          out_deg2[w])
+          && (!directed
+              || is_dominated(in_seq1 + in_off1[u],
+                              in_deg1[u],
+                              in_seq2 + in_off2[w],
+                              in_deg2[w]));
+      if (keep) {
+        set_bit_array(dom, w, true);
+      }
+    }
+    END_FOR_SET_BITS
+    result = (size_bit_array(dom, nr2) != 0);
+  }
+
+  free(out_deg1);
+  free(in_deg1);
+  free(out_deg2);
+  free(in_deg2);
+  free(out_off1);
+  free(out_off2);
+  free(out_seq1);
+  free(out_seq2);
+  free(in_off1);
+  free(in_off2);
+  free(in_seq1);
+  free(in_seq2);
+
+  if (!result) {
+    return false;
+  }
+
+  // AC-3 with a queue of the vertices whose values have changed, initially
+  // every vertex. The queue never contains more than nr1 vertices.
+  uint16_t* queue  = safe_malloc(nr1 * sizeof(uint16_t));
+  bool*     queued = safe_malloc(nr1 * sizeof(bool));
+  for (uint16_t v = 0; v < nr1; v++) {
+    queue[v]  = v;
+    queued[v] = true;
+  }
+  uint16_t  head = 0, len = nr1;
+  BitArray* nbs  = BIT_ARRAY_BUFFER[1];
+  uint16_t  u;
+
+  while (len > 0 && result) {
+    uint16_t const x = queue[head];
+    head             = (head + 1 == nr1 ? 0 : head + 1);
+    len--;
+    queued[x] = false;
+    copy_bit_array(nbs, out1[x], nr1);
+    union_bit_arrays(nbs, in1[x], nr1);
+    set_bit_array(nbs, x, false);
+    FOR_SET_BITS(nbs, nr1, u) {
+      if (result
+          && revise_injective_domains(out1, out2, in2, nr2, u, x, induced)) {
+        if (size_bit_array(DOMAINS[u], nr2) == 0) {
+          result = false;
+        } else if (!queued[u]) {
+          queue[head + len < nr1 ? head + len : head + len - nr1] = u;
+          queued[u] = true;
+          len++;
+        }
+      }
+    }
+    END_FOR_SET_BITS
+  }
+  free(queue);
+  free(queued);
+  return result;
+}
+
 // Initialises the data structures required by the recursive functions for
 // finding homomorphisms. If true is returned everything was initialised ok, if
 // false is returned, then the arguments already imply that there can be no
@@ -1681,6 +2095,8 @@ static bool init_data_from_args(Obj digraph1_obj,
         (BitArray**) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(BitArray*));
     MAP_UNDEFINED =
         (BitArray**) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(BitArray*));
+    DOMAINS =
+        (BitArray**) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(BitArray*));
     BLISS_GRAPH = (BlissGraph**) safe_calloc(3 * HOMOS_STRUCTURE_SIZE,
                                              sizeof(BlissGraph*));
     MAP     = (uint16_t*) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(uint16_t));
@@ -1691,6 +2107,9 @@ static bool init_data_from_args(Obj digraph1_obj,
         (uint16_t*) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(uint16_t));
     ORB   = (uint16_t*) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(uint16_t));
     ORDER = (uint16_t*) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(uint16_t));
+    RANDOM_KEYS =
+        (uint32_t*) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(uint32_t));
+    WEIGHTS = (uint64_t*) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(uint64_t));
     STAB_GENS =
         (PermColl**) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(PermColl*));
 
@@ -1701,6 +2120,7 @@ static bool init_data_from_args(Obj digraph1_obj,
     for (uint16_t i = 0; i < HOMOS_STRUCTURE_SIZE; i++) {
       REPS[i]             = new_bit_array(HOMOS_STRUCTURE_SIZE);
       BIT_ARRAY_BUFFER[i] = new_bit_array(HOMOS_STRUCTURE_SIZE);
+      DOMAINS[i]          = new_bit_array(HOMOS_STRUCTURE_SIZE);
       MAP_UNDEFINED[i]    = new_bit_array(HOMOS_STRUCTURE_SIZE);
       STAB_GENS[i] = new_perm_coll(HOMOS_STRUCTURE_SIZE, HOMOS_STRUCTURE_SIZE);
     }
@@ -1862,6 +2282,34 @@ static bool init_data_from_args(Obj digraph1_obj,
     colors = NULL;
   }
 
+  // Remove the values that cannot occur in any monomorphism or embedding
+  if (INT_INTOBJ(injective_obj) > 0) {
+    bool const induced = (INT_INTOBJ(injective_obj) == 2);
+    bool       possible;
+    if (is_undirected) {
+      possible = init_injective_domains(GRAPH1->neighbours,
+                                        GRAPH1->neighbours,
+                                        nr1,
+                                        GRAPH2->neighbours,
+                                        GRAPH2->neighbours,
+                                        nr2,
+                                        false,
+                                        induced);
+    } else {
+      possible = init_injective_domains(DIGRAPH1->out_neighbours,
+                                        DIGRAPH1->in_neighbours,
+                                        nr1,
+                                        DIGRAPH2->out_neighbours,
+                                        DIGRAPH2->in_neighbours,
+                                        nr2,
+                                        true,
+                                        induced);
+    }
+    if (!possible) {
+      return false;
+    }
+  }
+
   // Ensure that the sizes of all conditions are known before we start and
   // define the MAP
 
@@ -1897,6 +2345,7 @@ static bool init_data_from_args(Obj digraph1_obj,
   } else {
     set_automorphisms(aut_grp_obj, STAB_GENS[0]);
   }
+  init_stab_chain(SCHREIER_SIMS, STAB_GENS[0]);
 
   compute_stabs_and_orbit_reps(nr1, nr2, 0, 0, UNDEFINED, true);
   return true;
@@ -1913,7 +2362,8 @@ static bool init_data_from_args(Obj digraph1_obj,
 // 4. user_param_obj    GAP variable that can be used in the hook_obj, must be a
 //                      plist if hook_obj is Fail.
 // 5. max_results_obj   the maximum number of homomorphisms to find
-// 6. hint_obj          the rank of any homomorphisms found
+// 6. hint_obj          the rank of any homomorphisms found, or a list of
+//                      ranks, which are searched for in the order given
 // 7. injective_obj     should be 0 for non-injective, 1 for injective, 2 for
 //                      embedding, or (for backwards compatibility, true for
 //                      injective, or false for non-injective).
@@ -1938,6 +2388,9 @@ static bool init_data_from_args(Obj digraph1_obj,
 //                      automorphisms of the graph that will be used in the
 //                      recursive search. If not given, the full automorphism
 //                      group will be used.
+//
+// The value of the option "heuristic" (if any) determines how the next
+// position in MAP to fill is chosen, see choice_key.
 
 Obj FuncHomomorphismDigraphsFinder(Obj self, Obj args) {
   if (LEN_PLIST(args) < 11 || LEN_PLIST(args) > 13) {
@@ -2009,8 +2462,8 @@ Obj FuncHomomorphismDigraphsFinder(Obj self, Obj args) {
               (Int) TNAM_OBJ(max_results_obj),
               0L);
   }
-  if (!IS_INTOBJ(hint_obj) && hint_obj != Fail) {
-    ErrorQuit("the 6th argument <hint> must be an integer "
+  if (!IS_INTOBJ(hint_obj) && !IS_LIST(hint_obj) && hint_obj != Fail) {
+    ErrorQuit("the 6th argument <hint> must be an integer, a list, "
               "or fail, not %s,",
               (Int) TNAM_OBJ(hint_obj),
               0L);
@@ -2019,6 +2472,23 @@ Obj FuncHomomorphismDigraphsFinder(Obj self, Obj args) {
               "not %d,",
               INT_INTOBJ(hint_obj),
               0L);
+  } else if (IS_LIST(hint_obj)) {
+    for (Int i = 1; i <= LEN_LIST(hint_obj); ++i) {
+      if (!ISB_LIST(hint_obj, i)) {
+        ErrorQuit("the 6th argument <hint> must be a dense list,", 0L, 0L);
+      } else if (!IS_INTOBJ(ELM_LIST(hint_obj, i))
+                 || INT_INTOBJ(ELM_LIST(hint_obj, i)) <= 0) {
+        ErrorQuit("the 6th argument <hint> must only contain positive "
+                  "integers, but found %s in position %d,",
+                  (Int) TNAM_OBJ(ELM_LIST(hint_obj, i)),
+                  i);
+      } else if (INT_INTOBJ(
+                     POS_LIST(hint_obj, ELM_LIST(hint_obj, i), INTOBJ_INT(0)))
+                 < i) {
+        ErrorQuit(
+            "in the 6th argument <hint> position %d is a duplicate,", i, 0L);
+      }
+    }
   }
 
   if (!IS_INTOBJ(injective_obj) && injective_obj != True
@@ -2219,17 +2689,39 @@ Obj FuncHomomorphismDigraphsFinder(Obj self, Obj args) {
     }
   }
 
+  Obj heuristic_obj = CALL_1ARGS(ValueOption, MakeImmString("heuristic"));
+  if (heuristic_obj == Fail) {
+    HEURISTIC = HEURISTIC_DOM;
+  } else if (!IS_STRING_REP(heuristic_obj)) {
+    ErrorQuit("the option <heuristic> must be a string, not %s,",
+              (Int) TNAM_OBJ(heuristic_obj),
+              0L);
+  } else if (strcmp(CONST_CSTR_STRING(heuristic_obj), "dom") == 0) {
+    HEURISTIC = HEURISTIC_DOM;
+  } else if (strcmp(CONST_CSTR_STRING(heuristic_obj), "dom/deg") == 0) {
+    HEURISTIC = HEURISTIC_DOM_DEG;
+  } else if (strcmp(CONST_CSTR_STRING(heuristic_obj), "dom/wdeg") == 0) {
+    HEURISTIC = HEURISTIC_DOM_WDEG;
+  } else if (strcmp(CONST_CSTR_STRING(heuristic_obj), "restarts") == 0) {
+    HEURISTIC = HEURISTIC_RESTARTS;
+  } else {
+    ErrorQuit("the option <heuristic> must be one of \"dom\", \"dom/deg\", "
+              "\"dom/wdeg\", or \"restarts\", not \"%s\",",
+              (Int) CONST_CSTR_STRING(heuristic_obj),
+              0L);
+  }
+
+  uint16_t const nr1       = DigraphNrVertices(digraph1_obj);
+  uint16_t const nr2       = DigraphNrVertices(digraph2_obj);
+  bool const     injective = INT_INTOBJ(injective_obj) > 0;
+  // The number of ranks in <hint_obj>, which are searched for in turn.
+  Int const nr_hints = (IS_LIST(hint_obj) ? LEN_LIST(hint_obj) : 1);
+
   // Some conditions that immediately rule out there being any homomorphisms.
-  if (((INT_INTOBJ(injective_obj) == 1 || INT_INTOBJ(injective_obj) == 2)
-       && ((hint_obj != Fail
-            && INT_INTOBJ(hint_obj) != DigraphNrVertices(digraph1_obj))
-           || DigraphNrVertices(digraph1_obj)
-                  > DigraphNrVertices(digraph2_obj)))
-      || (hint_obj != Fail
-          && (INT_INTOBJ(hint_obj) > DigraphNrVertices(digraph1_obj)
-              || INT_INTOBJ(hint_obj) > DigraphNrVertices(digraph2_obj)))
-      || LEN_LIST(image_obj) == 0
-      || (hint_obj != Fail && INT_INTOBJ(hint_obj) > LEN_LIST(image_obj))) {
+  if ((injective && nr1 > nr2) || LEN_LIST(image_obj) == 0 || nr_hints == 0
+      || (!IS_LIST(hint_obj)
+          && get_hint(hint_obj, 1, nr1, nr2, LEN_LIST(image_obj), injective)
+                 == 0)) {
     // Can't print stats here because they are not initialised, also why would
     // we want to, nothing has actually happened yet!
     return user_param_obj;
@@ -2261,19 +2753,49 @@ Obj FuncHomomorphismDigraphsFinder(Obj self, Obj args) {
   uint64_t max_results =
       (max_results_obj == Infinity ? SMALLINTLIMIT
                                    : INT_INTOBJ(max_results_obj));
-  uint16_t hint  = (IS_INTOBJ(hint_obj) ? INT_INTOBJ(hint_obj) : UNDEFINED);
   uint64_t count = 0;
+  bool     is_undirected =
+      (CALL_1ARGS(IsSymmetricDigraph, digraph1_obj) == True
+       && CALL_1ARGS(IsSymmetricDigraph, digraph2_obj) == True);
 
-  // go!
-  if (setjmp(OUTOFHERE) == 0) {
-    if (CALL_1ARGS(IsSymmetricDigraph, digraph1_obj) == True
-        && CALL_1ARGS(IsSymmetricDigraph, digraph2_obj) == True) {
-      init_partial_map_and_find_graph_homos(
-          partial_map_obj, max_results, hint, &count, injective_obj);
-    } else {
-      init_partial_map_and_find_digraph_homos(
-          partial_map_obj, max_results, hint, &count, injective_obj);
-    }
+  RANDOM_STATE = 0x9E3779B97F4A7C15;
+  if (is_undirected) {
+    init_heuristic(GRAPH1->neighbours, NULL, nr1);
+  } else {
+    init_heuristic(DIGRAPH1->out_neighbours, DIGRAPH1->in_neighbours, nr1);
+  }
+
+  // go! Every rank in <hint_obj> is searched for in turn, starting from the
+  // state left by init_data_from_args, and so the conditions, the
+  // automorphisms, the orbit reps, and the heuristic weights are shared by all
+  // of the ranks. The results for each rank are passed to the hook before the
+  // next rank is started, and so if <max_results> is reached, then the later
+  // ranks are never searched.
+  volatile Int k = 1;  // the position in <hint_obj> of the current rank
+  switch (setjmp(OUTOFHERE)) {
+    case 2:
+      // record_dead_branch asked for a restart
+      restart_search(nr1, nr2);
+      count = 0;
+      // fall through
+    case 0:
+      for (; k <= nr_hints; k++) {
+        uint16_t const hint =
+            get_hint(hint_obj, k, nr1, nr2, LEN_LIST(image_obj), injective);
+        if (hint == 0) {
+          continue;
+        } else if (is_undirected) {
+          init_partial_map_and_find_graph_homos(
+              partial_map_obj, max_results, hint, &count, injective_obj);
+        } else {
+          init_partial_map_and_find_digraph_homos(
+              partial_map_obj, max_results, hint, &count, injective_obj);
+        }
+        reset_search(nr1, nr2);
+      }
+      break;
+    default:
+      break;
   }
 #ifdef DIGRAPHS_ENABLE_STATS
   print_stats(STATS);
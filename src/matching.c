@@ -0,0 +1,463 @@
+/********************************************************************************
+**
+*A  matching.c             maximal and maximum matchings
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "matching.h"
+
+// C headers
+#include <stdbool.h>  // for false, true, bool
+#include <stdlib.h>   // for free
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt, NEW_PLIST, . . .
+
+// Digraphs headers
+#include "csr.h"             // for CSR, new_csr_out_neighbours, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+// Throughout this file the vertices are indexed from 1, as at the GAP level,
+// and a matching is represented by a list <mate> where mate[v] is the vertex
+// matched with <v>, or 0 if <v> is not matched. The out-neighbours of the
+// vertex <v> are:
+//
+//   targets[offsets[v - 1]] + 1, ..., targets[offsets[v] - 1] + 1.
+
+#define FIRST_EDGE(csr, v) (csr)->offsets[(v) - 1]
+#define LAST_EDGE(csr, v) (csr)->offsets[(v)]
+#define TARGET(csr, e) ((csr)->targets[(e)] + 1)
+
+static UInt* new_mate(UInt const n, Obj mate) {
+  UInt* result = safe_calloc(n + 2, sizeof(UInt));
+  for (UInt v = 1; v <= n; v++) {
+    result[v] = INT_INTOBJ(ELM_LIST(mate, v));
+  }
+  return result;
+}
+
+static Obj mate_to_plist(UInt const n, UInt const* const mate) {
+  Obj result = NEW_PLIST(n == 0 ? T_PLIST_EMPTY : T_PLIST_CYC, n);
+  SET_LEN_PLIST(result, n);
+  for (UInt v = 1; v <= n; v++) {
+    SET_ELM_PLIST(result, v, INTOBJ_INT(mate[v]));
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Maximal matchings
+////////////////////////////////////////////////////////////////////////////////
+
+// Returns the <mate> list of a maximal matching of <D> found by the greedy
+// algorithm, which matches every vertex <v> that is not yet matched with its
+// first out-neighbour that is not yet matched, if any.
+Obj FuncDIGRAPH_MAXIMAL_MATCHING(Obj self, Obj D) {
+  CSR*       out  = new_csr_out_neighbours(D);
+  UInt const n    = out->nr_vertices;
+  UInt*      mate = safe_calloc(n + 1, sizeof(UInt));
+  for (UInt v = 1; v <= n; v++) {
+    if (mate[v] == 0) {
+      for (UInt e = FIRST_EDGE(out, v); e < LAST_EDGE(out, v); e++) {
+        UInt const u = TARGET(out, e);
+        if (mate[u] == 0) {
+          mate[u] = v;
+          mate[v] = u;
+          break;
+        }
+      }
+    }
+  }
+  Obj result = mate_to_plist(n, mate);
+  free(mate);
+  free_csr(out);
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Maximum matchings in bipartite digraphs
+////////////////////////////////////////////////////////////////////////////////
+
+// This is the Hopcroft-Karp algorithm, with complexity O(m * sqrt(n)). The
+// vertex <nil> = n + 1 is matched with every vertex that is not matched, and
+// is also used as the infinite distance.
+
+struct hopcroft_karp_struct {
+  CSR const*  out;
+  UInt        nil;
+  UInt const* U;
+  UInt        nr_U;
+  UInt*       mate;
+  UInt*       dist;
+  UInt*       queue;
+  UInt*       stack;
+  UInt*       next;
+};
+
+typedef struct hopcroft_karp_struct HopcroftKarp;
+
+// Computes the distances from the unmatched vertices in <U> along alternating
+// paths, and returns true if there is an augmenting path.
+static bool hk_bfs(HopcroftKarp* const hk) {
+  UInt* const dist = hk->dist;
+  UInt* const mate = hk->mate;
+  UInt const  nil  = hk->nil;
+  UInt        len  = 0;
+  for (UInt i = 0; i < hk->nr_U; i++) {
+    UInt const v = hk->U[i];
+    if (mate[v] == nil) {
+      dist[v]          = 0;
+      hk->queue[len++] = v;
+    } else {
+      dist[v] = nil;
+    }
+  }
+  dist[nil] = nil;
+
+  for (UInt q = 0; q < len; q++) {
+    UInt const u = hk->queue[q];
+    if (dist[u] < dist[nil]) {
+      for (UInt e = FIRST_EDGE(hk->out, u); e < LAST_EDGE(hk->out, u); e++) {
+        UInt const w = mate[TARGET(hk->out, e)];
+        if (dist[w] == nil) {
+          dist[w]          = dist[u] + 1;
+          hk->queue[len++] = w;
+        }
+      }
+    }
+  }
+  return dist[nil] != nil;
+}
+
+// Searches for an augmenting path starting at the vertex <root> along which
+// the distances increase by 1, and if one is found, then the matching is
+// augmented along it.
+static void hk_dfs(HopcroftKarp* const hk, UInt const root) {
+  CSR const* const out   = hk->out;
+  UInt* const      dist  = hk->dist;
+  UInt* const      mate  = hk->mate;
+  UInt* const      stack = hk->stack;
+  UInt* const      next  = hk->next;
+  UInt             top   = 0;
+  bool             found = false;
+
+  stack[top++] = root;
+  next[root]   = FIRST_EDGE(out, root);
+  while (top > 0) {
+    UInt const u = stack[top - 1];
+    if (found) {
+      // The edge just considered from <u> is on the augmenting path.
+      UInt const v = TARGET(out, next[u] - 1);
+      mate[v]      = u;
+      mate[u]      = v;
+      top--;
+    } else if (next[u] < LAST_EDGE(out, u)) {
+      UInt const w = mate[TARGET(out, next[u]++)];
+      if (dist[w] == dist[u] + 1) {
+        if (w == hk->nil) {
+          found = true;
+        } else {
+          stack[top++] = w;
+          next[w]      = FIRST_EDGE(out, w);
+        }
+      }
+    } else {
+      dist[u] = hk->nil;
+      top--;
+    }
+  }
+}
+
+static void hopcroft_karp(CSR const* const out,
+                          UInt* const      mate,
+                          UInt const*      U,
+                          UInt const       nr_U) {
+  UInt const   n = out->nr_vertices;
+  HopcroftKarp hk;
+  hk.out   = out;
+  hk.nil   = n + 1;
+  hk.U     = U;
+  hk.nr_U  = nr_U;
+  hk.mate  = mate;
+  hk.dist  = safe_malloc((n + 2) * sizeof(UInt));
+  hk.queue = safe_malloc((n + 2) * sizeof(UInt));
+  hk.stack = safe_malloc((n + 2) * sizeof(UInt));
+  hk.next  = safe_malloc((n + 2) * sizeof(UInt));
+
+  for (UInt v = 1; v <= n; v++) {
+    hk.dist[v] = hk.nil;
+    if (mate[v] == 0) {
+      mate[v] = hk.nil;
+    }
+  }
+
+  while (hk_bfs(&hk)) {
+    for (UInt i = 0; i < nr_U; i++) {
+      if (mate[U[i]] == hk.nil) {
+        hk_dfs(&hk, U[i]);
+      }
+    }
+  }
+
+  for (UInt v = 1; v <= n; v++) {
+    if (mate[v] == hk.nil) {
+      mate[v] = 0;
+    }
+  }
+  free(hk.dist);
+  free(hk.queue);
+  free(hk.stack);
+  free(hk.next);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Maximum matchings in general digraphs
+////////////////////////////////////////////////////////////////////////////////
+
+// This is Edmonds' blossom algorithm, with complexity O(m * n * alpha(n)),
+// where alpha is the inverse Ackermann function. A breadth-first search for an
+// augmenting path is performed from every unmatched vertex in turn. A search
+// that fails from a vertex also fails for every larger matching, and so there
+// is at most one search from every vertex. The vertices in the search forest
+// are either even (the root, and the mates of odd vertices) or odd, and an
+// edge between two even vertices closes a blossom. The blossoms are contracted
+// using a union-find structure, where base[find(v)] is the base of the blossom
+// containing <v>, and so every contraction, and the search for the base of the
+// new blossom, takes time proportional to the number of vertices that it
+// merges. The searches only reset the vertices that they touch.
+//
+// For an odd vertex <v>, pred[v] is the even vertex from which <v> was
+// reached. When a blossom is contracted, pred is also set for the even
+// vertices on its cycle, so that the augmenting path can be recovered by
+// following pred and mate alternately, as in:
+//
+//   J. Edmonds, Paths, trees, and flowers, Canad. J. Math. 17 (1965).
+
+struct edmonds_struct {
+  CSR const* out;
+  UInt*      mate;
+  UInt*      pred;
+  bool*      even;
+  UInt*      uf;     // the union-find forest
+  UInt*      size;   // the sizes of the trees in <uf>
+  UInt*      base;   // base[r] is the base of the blossom with root <r>
+  UInt*      stamp;  // used to find the base of a new blossom
+  UInt       now;
+  UInt*      queue;
+  UInt       nr_queue;
+  UInt*      touched;
+  UInt       nr_touched;
+};
+
+typedef struct edmonds_struct Edmonds;
+
+static UInt uf_find(UInt* const uf, UInt x) {
+  UInt root = x;
+  while (uf[root] != root) {
+    root = uf[root];
+  }
+  while (uf[x] != root) {
+    UInt const next = uf[x];
+    uf[x]           = root;
+    x               = next;
+  }
+  return root;
+}
+
+static inline UInt blossom_base(Edmonds* const ed, UInt const v) {
+  return ed->base[uf_find(ed->uf, v)];
+}
+
+// Merge the blossom containing <v> into the blossom with base <b>.
+static void merge_blossom(Edmonds* const ed, UInt const v, UInt const b) {
+  UInt x = uf_find(ed->uf, v);
+  UInt y = uf_find(ed->uf, b);
+  if (x == y) {
+    return;
+  } else if (ed->size[x] > ed->size[y]) {
+    UInt const tmp = x;
+    x              = y;
+    y              = tmp;
+  }
+  ed->uf[x] = y;
+  ed->size[y] += ed->size[x];
+  ed->base[y] = b;
+}
+
+static inline void make_even(Edmonds* const ed, UInt const v) {
+  ed->even[v]                    = true;
+  ed->queue[ed->nr_queue++]      = v;
+  ed->touched[ed->nr_touched++] = v;
+}
+
+static inline void set_pred(Edmonds* const ed, UInt const v, UInt const u) {
+  if (ed->pred[v] == 0) {
+    ed->touched[ed->nr_touched++] = v;
+  }
+  ed->pred[v] = u;
+}
+
+// Returns the base of the smallest blossom containing the even vertices <a>
+// and <b>, which are in the same tree of the search forest. The paths from
+// <a> and <b> towards the root are followed alternately, so that the time
+// taken is proportional to the length of the cycle of the new blossom.
+static UInt new_base(Edmonds* const ed, UInt a, UInt b) {
+  ed->now++;
+  while (true) {
+    if (a != 0) {
+      a = blossom_base(ed, a);
+      if (ed->stamp[a] == ed->now) {
+        return a;
+      }
+      ed->stamp[a] = ed->now;
+      a            = (ed->mate[a] == 0 ? 0 : ed->pred[ed->mate[a]]);
+    }
+    UInt const tmp = a;
+    a              = b;
+    b              = tmp;
+  }
+}
+
+// Contract the part of the new blossom with base <b> on the path from <v> to
+// <b>, where <child> is the vertex adjacent to <v> in the blossom.
+static void
+contract(Edmonds* const ed, UInt v, UInt const b, UInt child) {
+  while (blossom_base(ed, v) != b) {
+    UInt const w = ed->mate[v];
+    set_pred(ed, v, child);
+    child = w;
+    merge_blossom(ed, v, b);
+    merge_blossom(ed, w, b);
+    if (!ed->even[w]) {
+      // <w> is an odd vertex, and it becomes even in the new blossom
+      make_even(ed, w);
+    }
+    v = ed->pred[w];
+  }
+}
+
+// Returns true if an augmenting path starting at the unmatched vertex <root>
+// is found, in which case the matching is augmented along it.
+static bool edmonds_bfs(Edmonds* const ed, UInt const root) {
+  CSR const* const out   = ed->out;
+  UInt* const      mate  = ed->mate;
+  UInt             found = 0;
+
+  ed->nr_queue   = 0;
+  ed->nr_touched = 0;
+  make_even(ed, root);
+
+  for (UInt q = 0; q < ed->nr_queue && found == 0; q++) {
+    UInt const v = ed->queue[q];
+    for (UInt e = FIRST_EDGE(out, v); e < LAST_EDGE(out, v); e++) {
+      UInt const x = TARGET(out, e);
+      if (mate[v] == x || blossom_base(ed, v) == blossom_base(ed, x)) {
+        continue;
+      } else if (ed->even[x]) {
+        // The edge [v, x] closes a blossom
+        UInt const b = new_base(ed, v, x);
+        contract(ed, v, b, x);
+        contract(ed, x, b, v);
+      } else if (ed->pred[x] == 0) {
+        set_pred(ed, x, v);
+        if (mate[x] == 0) {
+          found = x;
+          break;
+        }
+        make_even(ed, mate[x]);
+      }
+    }
+  }
+
+  // Augment the matching along the path from <found> to <root>
+  for (UInt x = found; x != 0;) {
+    UInt const y = ed->pred[x];
+    UInt const w = mate[y];
+    mate[y]      = x;
+    mate[x]      = y;
+    x            = w;
+  }
+
+  for (UInt i = 0; i < ed->nr_touched; i++) {
+    UInt const v = ed->touched[i];
+    ed->pred[v]  = 0;
+    ed->even[v]  = false;
+    ed->uf[v]    = v;
+    ed->size[v]  = 1;
+    ed->base[v]  = v;
+  }
+  return found != 0;
+}
+
+static void edmonds(CSR const* const out, UInt* const mate) {
+  UInt const n = out->nr_vertices;
+  Edmonds    ed;
+  ed.out     = out;
+  ed.mate    = mate;
+  ed.pred    = safe_calloc(n + 1, sizeof(UInt));
+  ed.even    = safe_calloc(n + 1, sizeof(bool));
+  ed.uf      = safe_malloc((n + 1) * sizeof(UInt));
+  ed.size    = safe_malloc((n + 1) * sizeof(UInt));
+  ed.base    = safe_malloc((n + 1) * sizeof(UInt));
+  ed.stamp   = safe_calloc(n + 1, sizeof(UInt));
+  ed.now     = 0;
+  ed.queue   = safe_malloc((n + 1) * sizeof(UInt));
+  ed.touched = safe_malloc((2 * n + 2) * sizeof(UInt));
+  for (UInt v = 0; v <= n; v++) {
+    ed.uf[v]   = v;
+    ed.size[v] = 1;
+    ed.base[v] = v;
+  }
+
+  for (UInt u = 1; u <= n; u++) {
+    if (mate[u] == 0) {
+      edmonds_bfs(&ed, u);
+    }
+  }
+
+  free(ed.pred);
+  free(ed.even);
+  free(ed.uf);
+  free(ed.size);
+  free(ed.base);
+  free(ed.stamp);
+  free(ed.queue);
+  free(ed.touched);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GAP level function
+////////////////////////////////////////////////////////////////////////////////
+
+// The argument <D> must be a symmetric digraph without loops, <mate> the
+// <mate> list of a matching of <D>, used as the starting point of the
+// algorithm, and <U> either one of the two bicomponents of <D>, if <D> is
+// bipartite, or fail. Returns the <mate> list of a maximum matching of <D>.
+Obj FuncDIGRAPH_MAXIMUM_MATCHING(Obj self, Obj D, Obj mate, Obj U) {
+  CSR*       out = new_csr_out_neighbours(D);
+  UInt const n   = out->nr_vertices;
+  DIGRAPHS_ASSERT((UInt) LEN_LIST(mate) == n);
+  UInt* m = new_mate(n, mate);
+
+  if (U == Fail) {
+    edmonds(out, m);
+  } else {
+    UInt const nr_U = LEN_LIST(U);
+    UInt*      u    = safe_malloc((nr_U + 1) * sizeof(UInt));
+    for (UInt i = 0; i < nr_U; i++) {
+      u[i] = INT_INTOBJ(ELM_LIST(U, i + 1));
+    }
+    hopcroft_karp(out, m, u, nr_U);
+    free(u);
+  }
+
+  Obj result = mate_to_plist(n, m);
+  free(m);
+  free_csr(out);
+  return result;
+}
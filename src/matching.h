@@ -0,0 +1,20 @@
+/********************************************************************************
+**
+*A  matching.h             maximal and maximum matchings
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_MATCHING_H_
+#define DIGRAPHS_SRC_MATCHING_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_MAXIMAL_MATCHING(Obj self, Obj D);
+Obj FuncDIGRAPH_MAXIMUM_MATCHING(Obj self, Obj D, Obj mate, Obj U);
+
+#endif  // DIGRAPHS_SRC_MATCHING_H_
@@ -0,0 +1,437 @@
+/********************************************************************************
+**
+*A  mcs.c                  maximum common induced subdigraphs
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "mcs.h"
+
+// C headers
+#include <limits.h>   // for CHAR_BIT
+#include <stdbool.h>  // for false, true, bool
+#include <stdlib.h>   // for free
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, Int, ELM_PLIST, . . .
+
+// Digraphs headers
+#include "csr.h"             // for CSR, new_csr_out_neighbours, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+// This file contains an implementation of the McSplit algorithm:
+//
+//   C. McCreesh, P. Prosser, and J. Trimble, A Partitioning Algorithm for
+//   Maximum Common Subgraph Problems, IJCAI 2017.
+//
+// for finding a largest partial isomorphism between two digraphs without
+// multiple edges, i.e. a largest common induced subdigraph. Rather than
+// searching for a clique in the modular product of the digraphs, which has
+// |V1| * |V2| vertices, the search keeps, for every partial isomorphism, the
+// unmatched vertices of both digraphs partitioned into pairs of classes
+// ("bidomains"). Two unmatched vertices belong to the same bidomain if and
+// only if they have the same loop status and the same adjacency to every pair
+// of matched vertices, and so a vertex can only ever be matched to a vertex in
+// its bidomain. The sum over all bidomains of the smaller of the two sides
+// gives the upper bound used to prune the search.
+//
+// The branches of the search are explored one at a time, since each is pruned
+// using the largest partial isomorphism found in the branches before it. This
+// also determines which partial isomorphism is returned if there are several
+// of the largest size.
+//
+// The adjacency of each digraph is stored as one bit set of out-neighbours
+// per vertex, and all vertices are 0-based internally.
+
+#define WORD_BITS (sizeof(UInt) * CHAR_BIT)
+#define NR_WORDS(nr_bits) (((nr_bits) + WORD_BITS - 1) / WORD_BITS)
+#define MASK(bit) ((UInt) 1 << ((bit) % WORD_BITS))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) < (b) ? (b) : (a))
+
+// The adjacency label of an edge or non-edge, i.e. whether there is an edge in
+// either direction between two vertices.
+#define NR_LABELS 4
+
+////////////////////////////////////////////////////////////////////////////////
+// Data structures
+////////////////////////////////////////////////////////////////////////////////
+
+// A bidomain consists of the vertices
+//
+//   left[l], ..., left[l + left_len - 1]
+//
+// of the first digraph, and the vertices
+//
+//   right[r], ..., right[r + right_len - 1]
+//
+// of the second digraph.
+typedef struct {
+  UInt l;
+  UInt r;
+  UInt left_len;
+  UInt right_len;
+} Bidomain;
+
+// The vertices of each digraph are relabelled in decreasing order of (in- plus
+// out-) degree, ties being broken by the smallest vertex, since the search
+// always branches on the least vertex of a bidomain. The vertex <v> here is
+// the vertex vertex[v] of the original digraph.
+typedef struct {
+  UInt  nr_vertices;
+  UInt  nr_words;
+  UInt* adj;     // nr_vertices rows of nr_words words
+  UInt* vertex;  // length nr_vertices
+} AdjacencyBitSets;
+
+typedef struct {
+  AdjacencyBitSets g1;
+  AdjacencyBitSets g2;
+  UInt*            left;
+  UInt*            right;
+  // The bidomains of the partial isomorphisms of size k are stored in
+  // bidomains + k * g1.nr_vertices, and there are at most g1.nr_vertices of
+  // them, since every bidomain contains at least one vertex on the left.
+  Bidomain* bidomains;
+  UInt*     current1;
+  UInt*     current2;
+  UInt*     best1;
+  UInt*     best2;
+  UInt      best_size;
+} MCSData;
+
+static void init_adjacency_bit_sets(AdjacencyBitSets* const g,
+                                    CSR const* const        csr) {
+  UInt const n   = csr->nr_vertices;
+  g->nr_vertices = n;
+  g->nr_words    = NR_WORDS(n);
+  g->adj = safe_calloc((n * g->nr_words > 0 ? n * g->nr_words : 1),
+                       sizeof(UInt));
+  g->vertex = safe_malloc((n > 0 ? n : 1) * sizeof(UInt));
+
+  // Counting sort of the vertices by decreasing degree
+  UInt* degree = safe_calloc(n > 0 ? n : 1, sizeof(UInt));
+  UInt* count  = safe_calloc(2 * csr->nr_edges + 2, sizeof(UInt));
+  for (UInt v = 0; v < n; v++) {
+    degree[v] += degree_csr(csr, v);
+    for (UInt e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+      degree[csr->targets[e]]++;
+    }
+  }
+  for (UInt v = 0; v < n; v++) {
+    count[2 * csr->nr_edges - degree[v] + 1]++;
+  }
+  for (UInt d = 1; d <= 2 * csr->nr_edges + 1; d++) {
+    count[d] += count[d - 1];
+  }
+  // <degree> is reused to store the new label of every vertex
+  for (UInt v = 0; v < n; v++) {
+    UInt const pos = count[2 * csr->nr_edges - degree[v]]++;
+    g->vertex[pos] = v;
+    degree[v]      = pos;
+  }
+  for (UInt v = 0; v < n; v++) {
+    UInt* const row = g->adj + degree[v] * g->nr_words;
+    for (UInt e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+      UInt const w = degree[csr->targets[e]];
+      row[w / WORD_BITS] |= MASK(w);
+    }
+  }
+  free(degree);
+  free(count);
+}
+
+static inline bool is_adjacent(AdjacencyBitSets const* const g,
+                               UInt const                    u,
+                               UInt const                    v) {
+  DIGRAPHS_ASSERT(u < g->nr_vertices && v < g->nr_vertices);
+  return (g->adj[u * g->nr_words + v / WORD_BITS] & MASK(v)) != 0;
+}
+
+static inline UInt label(AdjacencyBitSets const* const g,
+                         UInt const                    u,
+                         UInt const                    v) {
+  return (is_adjacent(g, u, v) ? 1 : 0) | (is_adjacent(g, v, u) ? 2 : 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The search
+////////////////////////////////////////////////////////////////////////////////
+
+// Moves the vertices <x> among vert[start], ..., vert[start + len - 1] with
+// label(g, v, x) == lab to the start of this range, and returns their number.
+static UInt partition(UInt* const                   vert,
+                      UInt const                    start,
+                      UInt const                    len,
+                      AdjacencyBitSets const* const g,
+                      UInt const                    v,
+                      UInt const                    lab) {
+  UInt i = 0;
+  for (UInt j = 0; j < len; j++) {
+    if (label(g, v, vert[start + j]) == lab) {
+      UInt const tmp    = vert[start + i];
+      vert[start + i]   = vert[start + j];
+      vert[start + j]   = tmp;
+      i++;
+    }
+  }
+  return i;
+}
+
+// Writes the bidomains resulting from matching <v> to <w> into <out>, and
+// returns their number. The vertices <v> and <w> must already have been
+// removed from the bidomains in <in>.
+static UInt filter_bidomains(MCSData* const        data,
+                             Bidomain const* const in,
+                             UInt const            nr_in,
+                             Bidomain* const       out,
+                             UInt const            v,
+                             UInt const            w) {
+  UInt nr_out = 0;
+  for (UInt i = 0; i < nr_in; i++) {
+    UInt l         = in[i].l;
+    UInt r         = in[i].r;
+    UInt left_len  = in[i].left_len;
+    UInt right_len = in[i].right_len;
+    for (UInt lab = 0; lab < NR_LABELS && left_len > 0 && right_len > 0;
+         lab++) {
+      UInt const new_left_len
+          = partition(data->left, l, left_len, &data->g1, v, lab);
+      UInt const new_right_len
+          = partition(data->right, r, right_len, &data->g2, w, lab);
+      if (new_left_len > 0 && new_right_len > 0) {
+        out[nr_out].l         = l;
+        out[nr_out].r         = r;
+        out[nr_out].left_len  = new_left_len;
+        out[nr_out].right_len = new_right_len;
+        nr_out++;
+      }
+      l += new_left_len;
+      r += new_right_len;
+      left_len -= new_left_len;
+      right_len -= new_right_len;
+    }
+  }
+  DIGRAPHS_ASSERT(nr_out <= data->g1.nr_vertices);
+  return nr_out;
+}
+
+static UInt min_vertex(UInt const* const vert,
+                       UInt const        start,
+                       UInt const        len) {
+  DIGRAPHS_ASSERT(len > 0);
+  UInt result = vert[start];
+  for (UInt i = 1; i < len; i++) {
+    if (vert[start + i] < result) {
+      result = vert[start + i];
+    }
+  }
+  return result;
+}
+
+// Returns the index of the bidomain whose larger side is smallest, ties are
+// broken by the smallest vertex on the left.
+static UInt select_bidomain(MCSData const* const  data,
+                            Bidomain const* const domains,
+                            UInt const            nr_domains) {
+  DIGRAPHS_ASSERT(nr_domains > 0);
+  UInt best      = 0;
+  UInt best_size = MAX(domains[0].left_len, domains[0].right_len);
+  UInt best_min  = min_vertex(data->left, domains[0].l, domains[0].left_len);
+  for (UInt i = 1; i < nr_domains; i++) {
+    UInt const size = MAX(domains[i].left_len, domains[i].right_len);
+    if (size <= best_size) {
+      UInt const min
+          = min_vertex(data->left, domains[i].l, domains[i].left_len);
+      if (size < best_size || min < best_min) {
+        best      = i;
+        best_size = size;
+        best_min  = min;
+      }
+    }
+  }
+  return best;
+}
+
+static void solve(MCSData* const  data,
+                  Bidomain* const domains,
+                  UInt            nr_domains,
+                  UInt const      depth) {
+  Bidomain* const next = domains + data->g1.nr_vertices;
+  // Every iteration of this loop either returns or removes one vertex on the
+  // left from the bidomains without matching it.
+  while (true) {
+    if (depth > data->best_size) {
+      for (UInt i = 0; i < depth; i++) {
+        data->best1[i] = data->current1[i];
+        data->best2[i] = data->current2[i];
+      }
+      data->best_size = depth;
+    }
+    UInt bound = depth;
+    for (UInt i = 0; i < nr_domains; i++) {
+      bound += MIN(domains[i].left_len, domains[i].right_len);
+    }
+    if (bound <= data->best_size) {
+      return;
+    }
+
+    UInt const      i  = select_bidomain(data, domains, nr_domains);
+    Bidomain* const bd = domains + i;
+
+    // Remove the least vertex <v> in <bd> from the left, by swapping it to the
+    // end of the bidomain.
+    UInt const v = min_vertex(data->left, bd->l, bd->left_len);
+    UInt       j = bd->l;
+    while (data->left[j] != v) {
+      j++;
+    }
+    bd->left_len--;
+    data->left[j]                     = data->left[bd->l + bd->left_len];
+    data->left[bd->l + bd->left_len] = v;
+
+    // Match <v> to every vertex <w> in <bd> on the right, in increasing order.
+    bd->right_len--;
+    Int w = -1;
+    for (UInt k = 0; k <= bd->right_len; k++) {
+      UInt pos = 0;
+      Int  min = -1;
+      for (UInt m = 0; m <= bd->right_len; m++) {
+        Int const x = (Int) data->right[bd->r + m];
+        if (x > w && (min == -1 || x < min)) {
+          min = x;
+          pos = m;
+        }
+      }
+      w                                  = min;
+      data->right[bd->r + pos]           = data->right[bd->r + bd->right_len];
+      data->right[bd->r + bd->right_len] = (UInt) w;
+
+      UInt const nr_next
+          = filter_bidomains(data, domains, nr_domains, next, v, (UInt) w);
+      data->current1[depth] = v;
+      data->current2[depth] = (UInt) w;
+      solve(data, next, nr_next, depth + 1);
+    }
+    bd->right_len++;
+
+    // Leave <v> unmatched.
+    if (bd->left_len == 0) {
+      *bd = domains[--nr_domains];
+    }
+  }
+}
+
+// Finds a largest partial isomorphism from data->g1 to data->g2, which is
+// stored in data->best1, data->best2, and data->best_size. The adjacency bit
+// sets must already have been initialised.
+static void maximum_common_induced_subdigraph(MCSData* const data) {
+  UInt const n1   = data->g1.nr_vertices;
+  UInt const n2   = data->g2.nr_vertices;
+  UInt const nmin = MIN(n1, n2);
+
+  data->left      = safe_malloc((n1 > 0 ? n1 : 1) * sizeof(UInt));
+  data->right     = safe_malloc((n2 > 0 ? n2 : 1) * sizeof(UInt));
+  data->bidomains = safe_malloc((nmin + 1) * MAX(n1, 1) * sizeof(Bidomain));
+  data->current1  = safe_malloc((nmin > 0 ? nmin : 1) * sizeof(UInt));
+  data->current2  = safe_malloc((nmin > 0 ? nmin : 1) * sizeof(UInt));
+  data->best1     = safe_malloc((nmin > 0 ? nmin : 1) * sizeof(UInt));
+  data->best2     = safe_malloc((nmin > 0 ? nmin : 1) * sizeof(UInt));
+  data->best_size = 0;
+
+  // The initial bidomains: the vertices without loops and those with loops.
+  UInt nr_domains = 0;
+  UInt l = 0, r = 0;
+  for (UInt loop = 0; loop < 2; loop++) {
+    UInt const l_start = l, r_start = r;
+    for (UInt v = 0; v < n1; v++) {
+      if (is_adjacent(&data->g1, v, v) == (loop == 1)) {
+        data->left[l++] = v;
+      }
+    }
+    for (UInt w = 0; w < n2; w++) {
+      if (is_adjacent(&data->g2, w, w) == (loop == 1)) {
+        data->right[r++] = w;
+      }
+    }
+    if (l > l_start && r > r_start) {
+      data->bidomains[nr_domains].l         = l_start;
+      data->bidomains[nr_domains].r         = r_start;
+      data->bidomains[nr_domains].left_len  = l - l_start;
+      data->bidomains[nr_domains].right_len = r - r_start;
+      nr_domains++;
+    }
+  }
+  solve(data, data->bidomains, nr_domains, 0);
+}
+
+static void free_mcs_data(MCSData* const data) {
+  free(data->g1.adj);
+  free(data->g1.vertex);
+  free(data->g2.adj);
+  free(data->g2.vertex);
+  free(data->left);
+  free(data->right);
+  free(data->bidomains);
+  free(data->current1);
+  free(data->current2);
+  free(data->best1);
+  free(data->best2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GAP level function
+////////////////////////////////////////////////////////////////////////////////
+
+// Returns a pair of lists [X, Y] where the map X[i] -> Y[i] is a partial
+// isomorphism from <D1> to <D2> of largest size, and X is sorted. The
+// arguments <D1> and <D2> must be digraphs without multiple edges.
+Obj FuncDIGRAPH_MAXIMUM_COMMON_INDUCED_SUBDIGRAPH(Obj self, Obj D1, Obj D2) {
+  MCSData data;
+  CSR*    csr = new_csr_out_neighbours(D1);
+  init_adjacency_bit_sets(&data.g1, csr);
+  free_csr(csr);
+  csr = new_csr_out_neighbours(D2);
+  init_adjacency_bit_sets(&data.g2, csr);
+  free_csr(csr);
+  maximum_common_induced_subdigraph(&data);
+
+  UInt const n1 = data.g1.nr_vertices;
+  UInt const n2 = data.g2.nr_vertices;
+
+  // Sort the best partial isomorphism found by the vertices of <D1>, using
+  // <data.left> as a lookup table, and undo the relabelling.
+  for (UInt v = 0; v < n1; v++) {
+    data.left[v] = n2;
+  }
+  for (UInt i = 0; i < data.best_size; i++) {
+    data.left[data.g1.vertex[data.best1[i]]] = data.g2.vertex[data.best2[i]];
+  }
+  UInt const tnum = (data.best_size == 0 ? T_PLIST_EMPTY : T_PLIST_CYC);
+  Obj        X    = NEW_PLIST_IMM(tnum, data.best_size);
+  Obj        Y    = NEW_PLIST_IMM(tnum, data.best_size);
+  UInt k = 0;
+  for (UInt v = 0; v < n1; v++) {
+    if (data.left[v] != n2) {
+      k++;
+      SET_ELM_PLIST(X, k, INTOBJ_INT(v + 1));
+      SET_ELM_PLIST(Y, k, INTOBJ_INT(data.left[v] + 1));
+    }
+  }
+  DIGRAPHS_ASSERT(k == data.best_size);
+  SET_LEN_PLIST(X, k);
+  SET_LEN_PLIST(Y, k);
+
+  Obj result = NEW_PLIST_IMM(T_PLIST, 2);
+  SET_ELM_PLIST(result, 1, X);
+  SET_ELM_PLIST(result, 2, Y);
+  SET_LEN_PLIST(result, 2);
+  CHANGED_BAG(result);
+
+  free_mcs_data(&data);
+  return result;
+}
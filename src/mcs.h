@@ -0,0 +1,19 @@
+/********************************************************************************
+**
+*A  mcs.h                  maximum common induced subdigraphs
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_MCS_H_
+#define DIGRAPHS_SRC_MCS_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_MAXIMUM_COMMON_INDUCED_SUBDIGRAPH(Obj self, Obj D1, Obj D2);
+
+#endif  // DIGRAPHS_SRC_MCS_H_
@@ -0,0 +1,233 @@
+/********************************************************************************
+**
+*A  orbits.c               orbits and Schreier vectors
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "orbits.h"
+
+// C headers
+#include <stdlib.h>  // for free
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt4, NEW_PLIST, . . .
+
+// Digraphs headers
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+// This file contains functions for computing the orbits of a permutation
+// group, given by generators, on the points [1 .. n], together with a
+// Schreier vector, and for tracing and evaluating the words in the generators
+// given by a Schreier vector. The orbits, and the Schreier vector, are the
+// same as those computed by the GAP level implementation that these functions
+// replaced. In particular, the Schreier vector <sch> is a list of length <n>,
+// where sch[i] = -j if <i> is the representative of the j-th orbit (the least
+// point in the orbit), and otherwise sch[i] = k where gens[k] maps the point
+// before <i> in the Schreier tree to <i>.
+
+// Returns an array of length LEN_LIST(gens) * n whose entry k * n + i is the
+// image of the point <i> under the (k + 1)-th generator, where the points are
+// indexed from 0.
+static UInt4* new_images(Obj gens, UInt const n) {
+  UInt const   nr     = LEN_LIST(gens);
+  UInt4* const images = safe_malloc((nr * n > 0 ? nr * n : 1) * sizeof(UInt4));
+
+  for (UInt k = 0; k < nr; k++) {
+    Obj        p   = ELM_LIST(gens, k + 1);
+    UInt4*     x   = images + k * n;
+    UInt const deg = IS_PERM2(p) ? DEG_PERM2(p) : DEG_PERM4(p);
+    DIGRAPHS_ASSERT(IS_PERM(p));
+    if (IS_PERM2(p)) {
+      UInt2 const* const ptr = CONST_ADDR_PERM2(p);
+      for (UInt i = 0; i < n; i++) {
+        x[i] = (i < deg ? ptr[i] : i);
+      }
+    } else {
+      UInt4 const* const ptr = CONST_ADDR_PERM4(p);
+      for (UInt i = 0; i < n; i++) {
+        x[i] = (i < deg ? ptr[i] : i);
+      }
+    }
+    for (UInt i = 0; i < n; i++) {
+      if (x[i] >= n) {
+        free(images);
+        ErrorQuit("the 1st argument <gens> must consist of permutations of "
+                  "[1 .. %d],",
+                  (Int) n,
+                  0L);
+      }
+    }
+  }
+  return images;
+}
+
+// Returns the preimage of the point <x> (indexed from 0) under the
+// permutation <p>, by following the cycle of <p> containing <x>.
+static UInt preimage(Obj p, UInt const x) {
+  UInt y = x;
+  if (IS_PERM2(p)) {
+    UInt2 const* const ptr = CONST_ADDR_PERM2(p);
+    if (x >= DEG_PERM2(p)) {
+      return x;
+    }
+    while (ptr[y] != x) {
+      y = ptr[y];
+    }
+  } else {
+    UInt4 const* const ptr = CONST_ADDR_PERM4(p);
+    if (x >= DEG_PERM4(p)) {
+      return x;
+    }
+    while (ptr[y] != x) {
+      y = ptr[y];
+    }
+  }
+  return y;
+}
+
+Obj FuncDIGRAPH_ORBITS(Obj self, Obj gens, Obj N) {
+  DIGRAPHS_ASSERT(IS_LIST(gens));
+  DIGRAPHS_ASSERT(IS_INTOBJ(N) && INT_INTOBJ(N) >= 0);
+
+  UInt const   n      = INT_INTOBJ(N);
+  UInt const   nr     = LEN_LIST(gens);
+  UInt4* const images = new_images(gens, n);
+  Int* const   sch    = safe_calloc(n + 1, sizeof(Int));
+  UInt* const  lookup = safe_malloc((n + 1) * sizeof(UInt));
+  // The points of the orbits, in the order they are found, and the position
+  // in <pts> of the first point of every orbit.
+  UInt4* const pts     = safe_malloc((n + 1) * sizeof(UInt4));
+  UInt* const  starts  = safe_malloc((n + 1) * sizeof(UInt));
+  UInt         nr_orbs = 0, len = 0;
+
+  for (UInt i = 0; i < n; i++) {
+    if (sch[i] == 0) {  // new orbit
+      starts[nr_orbs++] = len;
+      pts[len++]        = i;
+      sch[i]            = -((Int) nr_orbs);
+      lookup[i]         = nr_orbs;
+      for (UInt j = starts[nr_orbs - 1]; j < len; j++) {
+        for (UInt k = 0; k < nr; k++) {
+          UInt4 const l = images[k * n + pts[j]];
+          if (sch[l] == 0) {  // new point in the orbit
+            pts[len++] = l;
+            sch[l]     = k + 1;
+            lookup[l]  = nr_orbs;
+          }
+        }
+      }
+    }
+  }
+  DIGRAPHS_ASSERT(len == n);
+  starts[nr_orbs] = n;
+  free(images);
+
+  Obj orbs = NEW_PLIST(nr_orbs == 0 ? T_PLIST_EMPTY : T_PLIST_TAB, nr_orbs);
+  SET_LEN_PLIST(orbs, nr_orbs);
+  for (UInt j = 0; j < nr_orbs; j++) {
+    UInt const size = starts[j + 1] - starts[j];
+    Obj        o    = NEW_PLIST(T_PLIST_CYC, size);
+    SET_LEN_PLIST(o, size);
+    for (UInt i = 0; i < size; i++) {
+      SET_ELM_PLIST(o, i + 1, INTOBJ_INT(pts[starts[j] + i] + 1));
+    }
+    SET_ELM_PLIST(orbs, j + 1, o);
+    CHANGED_BAG(orbs);
+  }
+
+  Obj schreier = NEW_PLIST(n == 0 ? T_PLIST_EMPTY : T_PLIST_CYC, n);
+  SET_LEN_PLIST(schreier, n);
+  Obj orbnum = NEW_PLIST(n == 0 ? T_PLIST_EMPTY : T_PLIST_CYC, n);
+  SET_LEN_PLIST(orbnum, n);
+  for (UInt i = 0; i < n; i++) {
+    SET_ELM_PLIST(schreier, i + 1, INTOBJ_INT(sch[i]));
+    SET_ELM_PLIST(orbnum, i + 1, INTOBJ_INT(lookup[i]));
+  }
+  free(sch);
+  free(lookup);
+  free(pts);
+  free(starts);
+
+  Obj out = NEW_PREC(3);
+  AssPRec(out, RNamName("orbits"), orbs);
+  AssPRec(out, RNamName("schreier"), schreier);
+  AssPRec(out, RNamName("lookup"), orbnum);
+  return out;
+}
+
+Obj FuncDIGRAPH_TRACE_SCHREIER_VECTOR(Obj self, Obj gens, Obj sch, Obj r) {
+  DIGRAPHS_ASSERT(IS_LIST(gens));
+  DIGRAPHS_ASSERT(IS_LIST(sch));
+  DIGRAPHS_ASSERT(IS_INTOBJ(r) && 0 < INT_INTOBJ(r)
+                  && INT_INTOBJ(r) <= LEN_LIST(sch));
+
+  // The length of the word is less than the length of the orbit of <r>
+  UInt* const word = safe_malloc(LEN_LIST(sch) * sizeof(UInt));
+  UInt        len  = 0;
+  UInt        x    = INT_INTOBJ(r) - 1;
+  Int         w    = INT_INTOBJ(ELM_LIST(sch, x + 1));
+
+  while (w > 0) {
+    word[len++] = w;
+    x           = preimage(ELM_LIST(gens, w), x);
+    w           = INT_INTOBJ(ELM_LIST(sch, x + 1));
+  }
+
+  Obj out_word = NEW_PLIST(len == 0 ? T_PLIST_EMPTY : T_PLIST_CYC, len);
+  SET_LEN_PLIST(out_word, len);
+  for (UInt i = 0; i < len; i++) {
+    SET_ELM_PLIST(out_word, i + 1, INTOBJ_INT(word[len - i - 1]));
+  }
+  free(word);
+
+  Obj out = NEW_PREC(2);
+  AssPRec(out, RNamName("word"), out_word);
+  AssPRec(out, RNamName("representative"), INTOBJ_INT(-w));
+  return out;
+}
+
+Obj FuncDIGRAPH_EVALUATE_WORD(Obj self, Obj gens, Obj word) {
+  DIGRAPHS_ASSERT(IS_LIST(gens));
+  DIGRAPHS_ASSERT(IS_LIST(word));
+
+  UInt const len = LEN_LIST(word);
+  UInt       deg = 0;
+  for (UInt i = 1; i <= len; i++) {
+    Obj p = ELM_LIST(gens, INT_INTOBJ(ELM_LIST(word, i)));
+    DIGRAPHS_ASSERT(IS_PERM(p));
+    UInt const d = IS_PERM2(p) ? DEG_PERM2(p) : DEG_PERM4(p);
+    deg          = (d > deg ? d : deg);
+  }
+  if (deg == 0) {
+    return IdentityPerm;
+  }
+
+  // Apply the generators in the word to every point in turn
+  Obj          out = NEW_PERM4(deg);
+  UInt4* const ptr = ADDR_PERM4(out);
+  for (UInt i = 0; i < deg; i++) {
+    ptr[i] = i;
+  }
+  for (UInt i = 1; i <= len; i++) {
+    Obj p = ELM_LIST(gens, INT_INTOBJ(ELM_LIST(word, i)));
+    if (IS_PERM2(p)) {
+      UInt const         d = DEG_PERM2(p);
+      UInt2 const* const x = CONST_ADDR_PERM2(p);
+      for (UInt j = 0; j < deg; j++) {
+        ptr[j] = (ptr[j] < d ? x[ptr[j]] : ptr[j]);
+      }
+    } else {
+      UInt const         d = DEG_PERM4(p);
+      UInt4 const* const x = CONST_ADDR_PERM4(p);
+      for (UInt j = 0; j < deg; j++) {
+        ptr[j] = (ptr[j] < d ? x[ptr[j]] : ptr[j]);
+      }
+    }
+  }
+  return out;
+}
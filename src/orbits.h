@@ -0,0 +1,21 @@
+/********************************************************************************
+**
+*A  orbits.h               orbits and Schreier vectors
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_ORBITS_H_
+#define DIGRAPHS_SRC_ORBITS_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_ORBITS(Obj self, Obj gens, Obj N);
+Obj FuncDIGRAPH_TRACE_SCHREIER_VECTOR(Obj self, Obj gens, Obj sch, Obj r);
+Obj FuncDIGRAPH_EVALUATE_WORD(Obj self, Obj gens, Obj word);
+
+#endif  // DIGRAPHS_SRC_ORBITS_H_
@@ -0,0 +1,315 @@
+/********************************************************************************
+**
+*A  products.c             graph products
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "products.h"
+
+// C headers
+#include <stdbool.h>  // for false, true, bool
+#include <stdlib.h>   // for free
+#include <string.h>   // for strcmp
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt, NEW_PLIST, . . .
+
+// Digraphs headers
+#include "csr.h"             // for CSR, new_csr_out_neighbours, . . .
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+
+// This file contains the strong, conormal, homomorphic, lexicographic, and
+// modular products of two digraphs <D1> and <D2> without multiple edges, with
+// <m> and <n> vertices, respectively. The vertex [u, v] of the product
+// (indexed from 0) is u * n + v, and the out-neighbours of every vertex of the
+// product are computed directly from the out-neighbours of <u> in <D1> and of
+// <v> in <D2>. Every list of out-neighbours is computed twice: once to find
+// its length, and once to fill it in, so that no memory is required other
+// than the lists themselves. Each pass over a list takes time proportional to
+// its length, and so the time taken is linear in the size of the product.
+//
+// The out-neighbours of each vertex are the same, and in the same order, as
+// those computed by the original GAP level implementation: sorted for every
+// product except the modular product.
+
+enum product_kind {
+  PRODUCT_STRONG,
+  PRODUCT_CONORMAL,
+  PRODUCT_HOMOMORPHIC,
+  PRODUCT_LEXICOGRAPHIC,
+  PRODUCT_MODULAR
+};
+
+struct product_struct {
+  enum product_kind kind;
+  UInt              n;
+  CSR*              out1;
+  CSR*              out2;
+  CSR*              sorted1;  // out1 with every row sorted
+  CSR*              sorted2;  // out2 with every row sorted
+  // The list of out-neighbours being filled in, or 0 if the length of the list
+  // is being computed.
+  Obj  list;
+  UInt len;
+};
+
+typedef struct product_struct Product;
+
+static inline void emit(Product* const p, UInt const w, UInt const x) {
+  p->len++;
+  if (p->list != 0) {
+    SET_ELM_PLIST(p->list, p->len, INTOBJ_INT(w * p->n + x + 1));
+  }
+}
+
+static bool has_loop(CSR const* const csr, UInt const v) {
+  for (UInt e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+    if (csr->targets[e] == v) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Emit [w, x] for all vertices <x> of <D2>.
+static void emit_all(Product* const p, UInt const w) {
+  for (UInt x = 0; x < p->n; x++) {
+    emit(p, w, x);
+  }
+}
+
+// Emit [w, x] for all out-neighbours <x> of <v> in <D2>, in increasing order,
+// and also for <x> = <v> if <with_v> is true.
+static void emit_row(Product* const p,
+                     UInt const     w,
+                     UInt const     v,
+                     bool const     with_v) {
+  CSR const* const s  = p->sorted2;
+  bool             vv = with_v;
+  for (UInt e = s->offsets[v]; e < s->offsets[v + 1]; e++) {
+    UInt const x = s->targets[e];
+    if (vv && v <= x) {
+      if (v < x) {
+        emit(p, w, v);
+      }
+      vv = false;
+    }
+    emit(p, w, x);
+  }
+  if (vv) {
+    emit(p, w, v);
+  }
+}
+
+// Emit [w, x] for all vertices <x> of <D2> which are not out-neighbours of <v>
+// in <D2>, in increasing order, except <x> = <v> if <without_v> is true.
+static void emit_non_row(Product* const p,
+                         UInt const     w,
+                         UInt const     v,
+                         bool const     without_v) {
+  CSR const* const s = p->sorted2;
+  UInt             e = s->offsets[v];
+  for (UInt x = 0; x < p->n; x++) {
+    if (e < s->offsets[v + 1] && s->targets[e] == x) {
+      e++;
+    } else if (!without_v || x != v) {
+      emit(p, w, x);
+    }
+  }
+}
+
+static void strong_row(Product* const p, UInt const u, UInt const v) {
+  // The out-neighbours of [u, v] are [u, x], [w, x], and [w, v] for all
+  // out-neighbours <w> of <u> and <x> of <v>.
+  CSR const* const s    = p->sorted1;
+  bool             do_u = true;
+  for (UInt e = s->offsets[u]; e < s->offsets[u + 1]; e++) {
+    UInt const w = s->targets[e];
+    if (do_u && u <= w) {
+      if (u < w) {
+        emit_row(p, u, v, false);
+      }
+      do_u = false;
+    }
+    emit_row(p, w, v, true);
+  }
+  if (do_u) {
+    emit_row(p, u, v, false);
+  }
+}
+
+static void conormal_row(Product* const p, UInt const u, UInt const v) {
+  // The out-neighbours of [u, v] are [w, x] where <w> is an out-neighbour of
+  // <u>, or <x> is an out-neighbour of <v>.
+  CSR const* const s = p->sorted1;
+  UInt             e = s->offsets[u];
+  if (p->sorted2->offsets[v] == p->sorted2->offsets[v + 1]) {
+    for (; e < s->offsets[u + 1]; e++) {
+      emit_all(p, s->targets[e]);
+    }
+    return;
+  }
+  for (UInt w = 0; w < s->nr_vertices; w++) {
+    if (e < s->offsets[u + 1] && s->targets[e] == w) {
+      e++;
+      emit_all(p, w);
+    } else {
+      emit_row(p, w, v, false);
+    }
+  }
+}
+
+static void homomorphic_row(Product* const p, UInt const u, UInt const v) {
+  // The out-neighbours of [u, v] are [u, x] for all <x>, and [w, x] for all
+  // out-neighbours <w> of <u> and non-out-neighbours <x> of <v>.
+  CSR const* const s    = p->sorted1;
+  bool             do_u = true;
+  for (UInt e = s->offsets[u]; e < s->offsets[u + 1]; e++) {
+    UInt const w = s->targets[e];
+    if (do_u && u <= w) {
+      emit_all(p, u);
+      do_u = false;
+      if (u == w) {
+        continue;
+      }
+    }
+    emit_non_row(p, w, v, false);
+  }
+  if (do_u) {
+    emit_all(p, u);
+  }
+}
+
+static void lexicographic_row(Product* const p, UInt const u, UInt const v) {
+  // The out-neighbours of [u, v] are [w, x] for all out-neighbours <w> of <u>
+  // and all <x>, and [u, x] for all out-neighbours <x> of <v>.
+  CSR const* const s    = p->sorted1;
+  bool             do_u = true;
+  for (UInt e = s->offsets[u]; e < s->offsets[u + 1]; e++) {
+    UInt const w = s->targets[e];
+    if (do_u && u <= w) {
+      if (u < w) {
+        emit_row(p, u, v, false);
+      }
+      do_u = false;
+    }
+    emit_all(p, w);
+  }
+  if (do_u) {
+    emit_row(p, u, v, false);
+  }
+}
+
+static void modular_row(Product* const p, UInt const u, UInt const v) {
+  // The out-neighbours of [u, v] are [w, x] where either [u, w] and [v, x] are
+  // both edges, or both non-edges, and u = w if and only if v = x. The edges
+  // are in the order of the out-neighbours of <D1> and <D2>, and the
+  // non-edges are sorted.
+  CSR const* const out1 = p->out1;
+  CSR const* const out2 = p->out2;
+  for (UInt e = out1->offsets[u]; e < out1->offsets[u + 1]; e++) {
+    UInt const w = out1->targets[e];
+    for (UInt f = out2->offsets[v]; f < out2->offsets[v + 1]; f++) {
+      UInt const x = out2->targets[f];
+      if ((u == w) == (v == x)) {
+        emit(p, w, x);
+      }
+    }
+  }
+  CSR const* const s = p->sorted1;
+  UInt             e = s->offsets[u];
+  for (UInt w = 0; w < s->nr_vertices; w++) {
+    if (e < s->offsets[u + 1] && s->targets[e] == w) {
+      e++;
+    } else if (w == u) {
+      // x = v is the only possibility here, and [v, v] is a non-edge if and
+      // only if <v> has no loop
+      if (!has_loop(p->out2, v)) {
+        emit(p, u, v);
+      }
+    } else {
+      emit_non_row(p, w, v, true);
+    }
+  }
+}
+
+static void product_row(Product* const p, UInt const u, UInt const v) {
+  switch (p->kind) {
+    case PRODUCT_STRONG:
+      strong_row(p, u, v);
+      break;
+    case PRODUCT_CONORMAL:
+      conormal_row(p, u, v);
+      break;
+    case PRODUCT_HOMOMORPHIC:
+      homomorphic_row(p, u, v);
+      break;
+    case PRODUCT_LEXICOGRAPHIC:
+      lexicographic_row(p, u, v);
+      break;
+    case PRODUCT_MODULAR:
+      modular_row(p, u, v);
+      break;
+  }
+}
+
+// The arguments <D1> and <D2> must be digraphs without multiple edges, and
+// <product> one of the strings "strong", "conormal", "homomorphic",
+// "lexicographic", or "modular". Returns the out-neighbours of the
+// corresponding product of <D1> and <D2>.
+Obj FuncDIGRAPH_PRODUCT(Obj self, Obj D1, Obj D2, Obj product) {
+  Product p;
+  DIGRAPHS_ASSERT(IS_STRING_REP(product));
+  char const* const name = CONST_CSTR_STRING(product);
+  if (strcmp(name, "strong") == 0) {
+    p.kind = PRODUCT_STRONG;
+  } else if (strcmp(name, "conormal") == 0) {
+    p.kind = PRODUCT_CONORMAL;
+  } else if (strcmp(name, "homomorphic") == 0) {
+    p.kind = PRODUCT_HOMOMORPHIC;
+  } else if (strcmp(name, "lexicographic") == 0) {
+    p.kind = PRODUCT_LEXICOGRAPHIC;
+  } else if (strcmp(name, "modular") == 0) {
+    p.kind = PRODUCT_MODULAR;
+  } else {
+    ErrorQuit("the 3rd argument <product> must be one of \"strong\", "
+              "\"conormal\", \"homomorphic\", \"lexicographic\", or "
+              "\"modular\", not \"%s\",",
+              (Int) name,
+              0L);
+  }
+
+  p.out1    = new_csr_out_neighbours(D1);
+  p.out2    = new_csr_out_neighbours(D2);
+  p.sorted1 = new_csr_sorted(p.out1);
+  p.sorted2 = new_csr_sorted(p.out2);
+
+  UInt const m = p.out1->nr_vertices;
+  p.n          = p.out2->nr_vertices;
+
+  Obj out = NEW_PLIST(m * p.n == 0 ? T_PLIST_EMPTY : T_PLIST_TAB, m * p.n);
+  SET_LEN_PLIST(out, m * p.n);
+  for (UInt u = 0; u < m; u++) {
+    for (UInt v = 0; v < p.n; v++) {
+      p.list = 0;
+      p.len  = 0;
+      product_row(&p, u, v);
+      p.list = NEW_PLIST(p.len == 0 ? T_PLIST_EMPTY : T_PLIST_CYC, p.len);
+      SET_LEN_PLIST(p.list, p.len);
+      p.len = 0;
+      product_row(&p, u, v);
+      SET_ELM_PLIST(out, u * p.n + v + 1, p.list);
+      CHANGED_BAG(out);
+    }
+  }
+
+  free_csr(p.out1);
+  free_csr(p.out2);
+  free_csr(p.sorted1);
+  free_csr(p.sorted2);
+  return out;
+}
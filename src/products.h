@@ -0,0 +1,19 @@
+/********************************************************************************
+**
+*A  products.h             graph products
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_PRODUCTS_H_
+#define DIGRAPHS_SRC_PRODUCTS_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_PRODUCT(Obj self, Obj D1, Obj D2, Obj product);
+
+#endif  // DIGRAPHS_SRC_PRODUCTS_H_
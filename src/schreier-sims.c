@@ -30,6 +30,8 @@ uint16_t PERM_DEGREE = 0;
 SchreierSims* new_schreier_sims(void) {
   SchreierSims* ss = safe_malloc(sizeof(SchreierSims));
   ss->tmp_perm     = new_perm(HOMOS_STRUCTURE_SIZE);
+  ss->conj         = new_perm(HOMOS_STRUCTURE_SIZE);
+  ss->conj_inv     = new_perm(HOMOS_STRUCTURE_SIZE);
   ss->strong_gens =
       (PermColl**) safe_calloc(HOMOS_STRUCTURE_SIZE, sizeof(PermColl*));
   for (uint16_t i = 0; i < HOMOS_STRUCTURE_SIZE; ++i) {
@@ -71,6 +73,8 @@ static void init_ss(SchreierSims* ss, uint16_t degree) {
 
 void free_schreier_sims(SchreierSims* ss) {
   free(ss->tmp_perm);
+  free(ss->conj);
+  free(ss->conj_inv);
   for (uint16_t i = 0; i < HOMOS_STRUCTURE_SIZE; ++i) {
     free_perm_coll(ss->strong_gens[i]);
   }
@@ -120,13 +124,23 @@ static inline Perm get_inversal_ss(SchreierSims const* const ss,
   return ss->inversal[i * HOMOS_STRUCTURE_SIZE + j];
 }
 
+// Reset the orbit of the base point at the given depth to consist of the base
+// point only.
+static inline void reset_orbit_ss(SchreierSims* ss, uint16_t const depth) {
+  uint16_t const pt = ss->base[depth];
+  memset((void*) (ss->orb_lookup + depth * ss->degree),
+         false,
+         ss->degree * sizeof(bool));
+  ss->size_orbits[depth]                  = 1;
+  ss->orbits[depth * ss->degree]          = pt;
+  ss->orb_lookup[depth * ss->degree + pt] = true;
+  id_perm(get_transversal_ss(ss, depth, pt), ss->degree);
+  id_perm(get_inversal_ss(ss, depth, pt), ss->degree);
+}
+
 static inline void add_base_point_ss(SchreierSims* ss, uint16_t const pt) {
-  ss->base[ss->size_base]                         = pt;
-  ss->size_orbits[ss->size_base]                  = 1;
-  ss->orbits[ss->size_base * ss->degree]          = pt;
-  ss->orb_lookup[ss->size_base * ss->degree + pt] = true;
-  id_perm(get_transversal_ss(ss, ss->size_base, pt), ss->degree);
-  id_perm(get_inversal_ss(ss, ss->size_base, pt), ss->degree);
+  ss->base[ss->size_base] = pt;
+  reset_orbit_ss(ss, ss->size_base);
   ss->size_base++;
 }
 
@@ -218,8 +232,10 @@ static bool perm_fixes_all_base_points(SchreierSims* ss, Perm const x) {
   return true;
 }
 
-static void run_ss(SchreierSims* ss) {
-  uint16_t depth = 0;
+// Complete the levels of the stabiliser chain from <depth> onwards, where
+// ss->strong_gens[depth] generates the stabiliser of the first <depth> base
+// points, and the levels before <depth> are already complete.
+static void run_ss(SchreierSims* ss, uint16_t const depth) {
   for (uint16_t j = 0; j < ss->strong_gens[depth]->size; j++) {
     Perm x = get_strong_gen_ss(ss, depth, j);
     if (perm_fixes_all_base_points(ss, x)) {
@@ -293,13 +309,90 @@ static void run_ss(SchreierSims* ss) {
   }
 }
 
-void point_stabilizer(SchreierSims*  ss,
-                      PermColl*      src,
-                      PermColl*      dst,
-                      uint16_t const pt) {
-  init_ss(ss, src->degree);
-  copy_perm_coll(ss->strong_gens[0], src);
+void init_stab_chain(SchreierSims* ss, PermColl const* gens) {
+  init_ss(ss, gens->degree);
+  copy_perm_coll(ss->strong_gens[0], gens);
+  run_ss(ss, 0);
+}
+
+// Replace the base point at <depth> by an element <pt> of its orbit, by
+// conjugating the levels from <depth> onwards by the transversal element <u>
+// mapping the old base point to <pt>. Since <u> belongs to the stabiliser of
+// the first <depth> base points, these base points and the levels before
+// <depth> are not changed.
+static void conjugate_ss(SchreierSims*  ss,
+                         uint16_t const depth,
+                         uint16_t const pt) {
+  uint16_t const deg = ss->degree;
+  copy_perm(ss->conj, get_transversal_ss(ss, depth, pt), deg);
+  copy_perm(ss->conj_inv, get_inversal_ss(ss, depth, pt), deg);
+
+  // The orbit at <depth> is unchanged, and the transversal element for <x> is
+  // now u ^ -1 * t_x, which maps <pt> to <x>.
+  for (uint16_t i = 0; i < ss->size_orbits[depth]; i++) {
+    uint16_t const x = ss->orbits[depth * deg + i];
+    prod_perms(
+        ss->tmp_perm, ss->conj_inv, get_transversal_ss(ss, depth, x), deg);
+    copy_perm(get_transversal_ss(ss, depth, x), ss->tmp_perm, deg);
+    prod_perms(get_inversal_ss(ss, depth, x),
+               get_inversal_ss(ss, depth, x),
+               ss->conj,
+               deg);
+  }
+  ss->base[depth] = pt;
+
+  // The strong generators and base points of the deeper levels are conjugated
+  // by <u>, and their orbits are recomputed.
+  for (uint16_t i = depth + 1; i <= ss->size_base && i < deg; i++) {
+    for (uint16_t j = 0; j < ss->strong_gens[i]->size; j++) {
+      Perm x = get_strong_gen_ss(ss, i, j);
+      prod_perms(ss->tmp_perm, ss->conj_inv, x, deg);
+      prod_perms(x, ss->tmp_perm, ss->conj, deg);
+    }
+    if (i < ss->size_base) {
+      ss->base[i] = ss->conj[ss->base[i]];
+      reset_orbit_ss(ss, i);
+      orbit_ss(ss, i, ss->base[i]);
+    }
+  }
+}
+
+// Recompute the levels of the stabiliser chain from <depth> onwards, so that
+// <pt> is the base point at <depth>.
+static void rebuild_ss(SchreierSims*  ss,
+                       uint16_t const depth,
+                       uint16_t const pt) {
+  for (uint16_t i = depth + 1; i < ss->degree; i++) {
+    clear_perm_coll(ss->strong_gens[i]);
+  }
+  memset((void*) (ss->orb_lookup + depth * ss->degree),
+         false,
+         (ss->degree - depth) * ss->degree * sizeof(bool));
+  memset((void*) (ss->size_orbits + depth),
+         0,
+         (ss->degree - depth) * sizeof(uint16_t));
+  ss->size_base = depth;
   add_base_point_ss(ss, pt);
-  run_ss(ss);
-  copy_perm_coll(dst, ss->strong_gens[1]);
+  run_ss(ss, depth);
+}
+
+void point_stabilizer(SchreierSims*  ss,
+                      uint16_t const depth,
+                      uint16_t const pt,
+                      PermColl*      dst) {
+  DIGRAPHS_ASSERT(depth < ss->degree);
+  DIGRAPHS_ASSERT(pt < ss->degree);
+  if (depth >= ss->size_base) {
+    // the stabiliser of the first <depth> base points is trivial
+    clear_perm_coll(dst);
+    dst->degree = ss->degree;
+    return;
+  } else if (ss->base[depth] != pt) {
+    if (ss->orb_lookup[depth * ss->degree + pt]) {
+      conjugate_ss(ss, depth, pt);
+    } else {
+      rebuild_ss(ss, depth, pt);
+    }
+  }
+  copy_perm_coll(dst, ss->strong_gens[depth + 1]);
 }
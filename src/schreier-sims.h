@@ -34,6 +34,8 @@ struct schreier_sims_struct {
   uint16_t*  size_orbits;
   uint16_t*  base;
   Perm       tmp_perm;
+  Perm       conj;      // used when changing the base by conjugation
+  Perm       conj_inv;  // the inverse of conj
   uint16_t   size_base;
 };
 
@@ -42,11 +44,22 @@ typedef struct schreier_sims_struct SchreierSims;
 SchreierSims* new_schreier_sims(void);
 void          free_schreier_sims(SchreierSims* ss);
 
-// Store the stabiliser of pt in the group generated by src, in dst, use ss to
-// hold the stabiliser chain.
+// Compute a base and strong generating set for the group generated by <gens>,
+// and store it in <ss>. The stabiliser chain in <ss> is then changed in place
+// by point_stabilizer.
+void init_stab_chain(SchreierSims* ss, PermColl const* gens);
+
+// Store generators for the stabiliser of <pt> in the stabiliser of the first
+// <depth> base points of the stabiliser chain in <ss>, in dst. Afterwards <pt>
+// is the base point at <depth>, and the first <depth> base points are not
+// changed, so that fixing the images of the vertices in a search one at a time
+// and then backtracking only requires changing the chain from <depth>
+// onwards. If <pt> is in the orbit of the existing base point at <depth>, then
+// the chain is conjugated using the existing transversals, and otherwise the
+// chain is recomputed from <depth> onwards.
 void point_stabilizer(SchreierSims*  ss,
-                      PermColl*      src,
-                      PermColl*      dst,
-                      uint16_t const pt);
+                      uint16_t const depth,
+                      uint16_t const pt,
+                      PermColl*      dst);
 
 #endif  // DIGRAPHS_SRC_SCHREIER_SIMS_H_
@@ -0,0 +1,688 @@
+/********************************************************************************
+**
+*A  stab-chain.c           randomised Schreier-Sims
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#include "stab-chain.h"
+
+// C headers
+#include <stdbool.h>  // for false, true, bool
+#include <stdint.h>   // for uint64_t
+#include <stdlib.h>   // for free
+#include <string.h>   // for memcpy
+
+// GAP headers
+#include "gap-includes.h"  // for Obj, UInt4, NEW_PERM4, . . .
+
+// Digraphs headers
+#include "digraphs-debug.h"  // for DIGRAPHS_ASSERT
+#include "safemalloc.h"      // for safe_malloc, safe_calloc
+
+// This file contains a randomised Schreier-Sims algorithm for permutation
+// groups of degree up to 2 ^ 32 - 1, given by generators. Random elements of
+// the group, produced by the product replacement algorithm, are sifted
+// through the stabiliser chain found so far, and any non-trivial residue is
+// added to the strong generators. Since a random element of the group sifts
+// through an incomplete stabiliser chain with probability at most 1 / 2, the
+// chain is correct with probability at least 1 - 2 ^ -K once K consecutive
+// random elements have sifted. If the order of the group is known, then the
+// chain is complete exactly when the product of the lengths of its basic
+// orbits equals the order; otherwise the chain can be verified
+// deterministically by sifting every Schreier generator.
+//
+// The transversals are stored as Schreier vectors, so that the memory
+// required is proportional to the degree times the length of the base, and
+// the points are indexed from 0. A sift traces the coset representatives on
+// the images of the base points only, and applies the resulting word to the
+// whole permutation once at the end. The cost of this is the degree times the
+// length of the word, and so whenever a Schreier tree becomes deeper than
+// twice the logarithm of the length of its orbit, it is made shallower by
+// adding a coset representative of a deepest point as a further label of the
+// tree, and rebuilding the tree by breadth-first search, as described in
+// Section 4.4 of:
+//
+//   A. Seress, Permutation Group Algorithms, Cambridge University Press
+//   (2003).
+//
+// These extra labels belong to the group of the level, but are not strong
+// generators, and so they are not returned, and do not give rise to Schreier
+// generators in the verification.
+
+// The number of random elements used to initialise the product replacement
+#define NR_WARM_UP 50
+// The minimum number of elements in the product replacement pool
+#define MIN_POOL_SIZE 10
+
+struct stab_chain_struct {
+  UInt    degree;
+  UInt    nr_base;
+  UInt4*  base;
+  // schreier[l][pt] is 0 if <pt> is not in the orbit of base[l], -1 if
+  // pt = base[l], and otherwise k + 1 where gens[k] maps the point before
+  // <pt> in the Schreier tree to <pt>.
+  Int4**  schreier;
+  UInt4** orbit;  // the orbit of base[l]
+  UInt*   orbit_len;
+  UInt    nr_gens;
+  UInt    capacity;
+  UInt4** gens;  // the strong generators, and the extra tree labels
+  UInt4** invs;  // their inverses
+  // gens[k] fixes base[0], . . ., base[depth[k] - 1], and is a generator of
+  // the levels 0, . . ., depth[k] of the chain
+  UInt*  depth;
+  bool*  is_label;  // is_label[k] is true if gens[k] is only a tree label
+  UInt4* tmp1;
+  UInt4* tmp2;
+  // The labels of the tree edges traversed by the current sift
+  UInt*  word;
+  UInt   nr_word;
+  UInt   word_capacity;
+  UInt4* img;   // the images of the base points during a sift
+  UInt4* dist;  // the depths of the points in a Schreier tree
+  // The product replacement pool, and its accumulator
+  UInt4**  pool;
+  UInt     nr_pool;
+  UInt4*   acc;
+  uint64_t random_state;
+};
+
+typedef struct stab_chain_struct StabChain;
+
+static UInt4* new_perm4(UInt const degree) {
+  return safe_malloc((degree > 0 ? degree : 1) * sizeof(UInt4));
+}
+
+static void id_perm4(UInt4* const x, UInt const degree) {
+  for (UInt i = 0; i < degree; i++) {
+    x[i] = i;
+  }
+}
+
+static bool is_id_perm4(UInt4 const* const x, UInt const degree) {
+  for (UInt i = 0; i < degree; i++) {
+    if (x[i] != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void copy_perm4_from_gap(UInt4* const x, Obj p, UInt const degree) {
+  DIGRAPHS_ASSERT(IS_PERM(p));
+  if (IS_PERM2(p)) {
+    UInt const         deg = DEG_PERM2(p);
+    UInt2 const* const ptr = CONST_ADDR_PERM2(p);
+    for (UInt i = 0; i < degree; i++) {
+      x[i] = (i < deg ? ptr[i] : i);
+    }
+  } else {
+    UInt const         deg = DEG_PERM4(p);
+    UInt4 const* const ptr = CONST_ADDR_PERM4(p);
+    for (UInt i = 0; i < degree; i++) {
+      x[i] = (i < deg ? ptr[i] : i);
+    }
+  }
+}
+
+static void init_stab_chain(StabChain* const c, UInt const degree) {
+  c->degree        = degree;
+  c->nr_base       = 0;
+  c->base          = safe_malloc((degree + 1) * sizeof(UInt4));
+  c->schreier      = safe_calloc(degree + 1, sizeof(Int4*));
+  c->orbit         = safe_calloc(degree + 1, sizeof(UInt4*));
+  c->orbit_len     = safe_calloc(degree + 1, sizeof(UInt));
+  c->nr_gens       = 0;
+  c->capacity      = 16;
+  c->gens          = safe_malloc(c->capacity * sizeof(UInt4*));
+  c->invs          = safe_malloc(c->capacity * sizeof(UInt4*));
+  c->depth         = safe_malloc(c->capacity * sizeof(UInt));
+  c->is_label      = safe_malloc(c->capacity * sizeof(bool));
+  c->tmp1          = new_perm4(degree);
+  c->tmp2          = new_perm4(degree);
+  c->nr_word       = 0;
+  c->word_capacity = 16;
+  c->word          = safe_malloc(c->word_capacity * sizeof(UInt));
+  c->img           = new_perm4(degree + 1);
+  c->dist          = new_perm4(degree);
+  c->pool          = NULL;
+  c->nr_pool       = 0;
+  c->acc           = new_perm4(degree);
+  c->random_state  = 0x9E3779B97F4A7C15;
+}
+
+static void free_stab_chain(StabChain* const c) {
+  for (UInt l = 0; l < c->nr_base; l++) {
+    free(c->schreier[l]);
+    free(c->orbit[l]);
+  }
+  for (UInt k = 0; k < c->nr_gens; k++) {
+    free(c->gens[k]);
+    free(c->invs[k]);
+  }
+  for (UInt i = 0; i < c->nr_pool; i++) {
+    free(c->pool[i]);
+  }
+  free(c->base);
+  free(c->schreier);
+  free(c->orbit);
+  free(c->orbit_len);
+  free(c->gens);
+  free(c->invs);
+  free(c->depth);
+  free(c->is_label);
+  free(c->tmp1);
+  free(c->tmp2);
+  free(c->word);
+  free(c->img);
+  free(c->dist);
+  free(c->pool);
+  free(c->acc);
+}
+
+static void add_base_point(StabChain* const c, UInt4 const pt) {
+  DIGRAPHS_ASSERT(c->nr_base < c->degree);
+  UInt const l       = c->nr_base++;
+  c->base[l]         = pt;
+  c->schreier[l]     = safe_calloc(c->degree, sizeof(Int4));
+  c->orbit[l]        = safe_malloc(c->degree * sizeof(UInt4));
+  c->orbit[l][0]     = pt;
+  c->orbit_len[l]    = 1;
+  c->schreier[l][pt] = -1;
+}
+
+// Add the images of the points in the orbit at level <l> under the new
+// generator gens[k], and close the orbit under all of the generators of the
+// level.
+static void extend_orbit(StabChain* const c, UInt const l, UInt const k) {
+  Int4* const  sv  = c->schreier[l];
+  UInt4* const orb = c->orbit[l];
+  UInt const   old = c->orbit_len[l];
+  for (UInt i = 0; i < old; i++) {
+    UInt4 const img = c->gens[k][orb[i]];
+    if (sv[img] == 0) {
+      sv[img]                = k + 1;
+      orb[c->orbit_len[l]++] = img;
+    }
+  }
+  for (UInt i = old; i < c->orbit_len[l]; i++) {
+    UInt4 const pt = orb[i];
+    for (UInt j = 0; j < c->nr_gens; j++) {
+      if (c->depth[j] >= l) {
+        UInt4 const img = c->gens[j][pt];
+        if (sv[img] == 0) {
+          sv[img]                = j + 1;
+          orb[c->orbit_len[l]++] = img;
+        }
+      }
+    }
+  }
+}
+
+static void push_word(StabChain* const c, UInt const k) {
+  if (c->nr_word == c->word_capacity) {
+    UInt const cap  = 2 * c->word_capacity;
+    UInt*      word = safe_malloc(cap * sizeof(UInt));
+    memcpy(word, c->word, c->nr_word * sizeof(UInt));
+    free(c->word);
+    c->word          = word;
+    c->word_capacity = cap;
+  }
+  c->word[c->nr_word++] = k;
+}
+
+// Put the labels of the edges of the Schreier tree of level <l> on the path
+// from <pt> to base[l] into c->word, beginning with the label of the edge
+// into <pt>.
+static void trace_word(StabChain* const c, UInt const l, UInt4 pt) {
+  Int4 const* const sv = c->schreier[l];
+  c->nr_word           = 0;
+  while (sv[pt] > 0) {
+    push_word(c, sv[pt] - 1);
+    pt = c->invs[sv[pt] - 1][pt];
+  }
+}
+
+// Replace <x> by <x> * u, where u is the product of the generators in c->word
+// in reverse order, so that if c->word was found by trace_word(c, l, pt), then
+// u maps base[l] to <pt>.
+static void apply_word(StabChain const* const c, UInt4* const x) {
+  for (UInt t = c->nr_word; t-- > 0;) {
+    UInt4 const* const gen = c->gens[c->word[t]];
+    for (UInt i = 0; i < c->degree; i++) {
+      x[i] = gen[x[i]];
+    }
+  }
+}
+
+// Sift <g> through the levels of the chain from <l> onwards, replacing <g> by
+// the residue. Returns the level at which the sift failed, or the length of
+// the base if it did not fail.
+static UInt sift(StabChain* const c, UInt4* const g, UInt l) {
+  UInt const   n   = c->degree;
+  UInt4* const img = c->img;
+  for (UInt j = l; j < c->nr_base; j++) {
+    img[j] = g[c->base[j]];
+  }
+  c->nr_word = 0;
+  for (; l < c->nr_base; l++) {
+    Int4 const* const sv = c->schreier[l];
+    if (sv[img[l]] == 0) {
+      break;
+    }
+    while (sv[img[l]] > 0) {
+      UInt const         k   = sv[img[l]] - 1;
+      UInt4 const* const inv = c->invs[k];
+      push_word(c, k);
+      for (UInt j = l; j < c->nr_base; j++) {
+        img[j] = inv[img[j]];
+      }
+    }
+  }
+  for (UInt t = 0; t < c->nr_word; t++) {
+    UInt4 const* const inv = c->invs[c->word[t]];
+    for (UInt i = 0; i < n; i++) {
+      g[i] = inv[g[i]];
+    }
+  }
+  return l;
+}
+
+// Append a copy of <g>, which must fix base[0], . . ., base[l - 1], to
+// c->gens, and return its index.
+static UInt
+new_gen(StabChain* const c, UInt4 const* const g, UInt l, bool is_label) {
+  UInt const n = c->degree;
+  if (c->nr_gens == c->capacity) {
+    UInt const cap    = 2 * c->capacity;
+    UInt4**    gens   = safe_malloc(cap * sizeof(UInt4*));
+    UInt4**    invs   = safe_malloc(cap * sizeof(UInt4*));
+    UInt*      depth  = safe_malloc(cap * sizeof(UInt));
+    bool*      labels = safe_malloc(cap * sizeof(bool));
+    memcpy(gens, c->gens, c->nr_gens * sizeof(UInt4*));
+    memcpy(invs, c->invs, c->nr_gens * sizeof(UInt4*));
+    memcpy(depth, c->depth, c->nr_gens * sizeof(UInt));
+    memcpy(labels, c->is_label, c->nr_gens * sizeof(bool));
+    free(c->gens);
+    free(c->invs);
+    free(c->depth);
+    free(c->is_label);
+    c->gens     = gens;
+    c->invs     = invs;
+    c->depth    = depth;
+    c->is_label = labels;
+    c->capacity = cap;
+  }
+  UInt const k   = c->nr_gens++;
+  c->gens[k]     = new_perm4(n);
+  c->invs[k]     = new_perm4(n);
+  c->depth[k]    = l;
+  c->is_label[k] = is_label;
+  memcpy(c->gens[k], g, n * sizeof(UInt4));
+  for (UInt i = 0; i < n; i++) {
+    c->invs[k][g[i]] = i;
+  }
+  return k;
+}
+
+// Rebuild the Schreier tree of level <l> by breadth-first search, so that
+// every point is as close to base[l] as the labels of the level allow.
+static void rebuild_schreier_tree(StabChain* const c, UInt const l) {
+  Int4* const  sv  = c->schreier[l];
+  UInt4* const orb = c->orbit[l];
+  UInt const   len = c->orbit_len[l];
+  for (UInt i = 1; i < len; i++) {
+    sv[orb[i]] = 0;
+  }
+  UInt nr = 1;
+  for (UInt i = 0; i < nr; i++) {
+    UInt4 const pt = orb[i];
+    // The strong generators are tried before the labels, so that as many
+    // edges as possible are labelled by strong generators, and give trivial
+    // Schreier generators that verify can skip.
+    for (UInt pass = 0; pass < 2; pass++) {
+      for (UInt j = 0; j < c->nr_gens; j++) {
+        if (c->depth[j] >= l && c->is_label[j] == (pass == 1)) {
+          UInt4 const img = c->gens[j][pt];
+          if (sv[img] == 0) {
+            sv[img]   = j + 1;
+            orb[nr++] = img;
+          }
+        }
+      }
+    }
+  }
+  DIGRAPHS_ASSERT(nr == len);
+}
+
+// Make the Schreier tree of level <l> shallower if its depth is more than
+// twice the number of bits of the length of its orbit. Each round adds the
+// coset representative of a deepest point as a label, which puts this point
+// at depth 1, and rebuilds the tree.
+//
+// If the level has a single strong generator, then the tree is a path, and
+// every Schreier generator of the level but one is trivial, so few sifts pass
+// through the level, and the tree is left as it is. Labels would make almost
+// every Schreier generator of such a level non-trivial.
+static void shorten_schreier_tree(StabChain* const c, UInt const l) {
+  UInt nr_strong = 0;
+  for (UInt k = 0; k < c->nr_gens; k++) {
+    nr_strong += (c->depth[k] >= l && !c->is_label[k]);
+  }
+  if (nr_strong < 2) {
+    return;
+  }
+  Int4 const* const  sv   = c->schreier[l];
+  UInt4 const* const orb  = c->orbit[l];
+  UInt4* const       dist = c->dist;
+  UInt const         len  = c->orbit_len[l];
+  UInt               bits = 0;
+  while (((UInt) 1 << bits) <= len) {
+    bits++;
+  }
+  for (UInt round = 0; round < bits; round++) {
+    // Every point in the orbit comes after its parent in the tree
+    UInt4 deepest = orb[0];
+    dist[orb[0]]  = 0;
+    for (UInt i = 1; i < len; i++) {
+      UInt4 const pt = orb[i];
+      dist[pt]       = dist[c->invs[sv[pt] - 1][pt]] + 1;
+      if (dist[pt] > dist[deepest]) {
+        deepest = pt;
+      }
+    }
+    if (dist[deepest] <= 2 * bits) {
+      return;
+    }
+    // tmp1 = the coset representative of <deepest>
+    trace_word(c, l, deepest);
+    UInt4* const u = c->tmp1;
+    id_perm4(u, c->degree);
+    apply_word(c, u);
+    new_gen(c, u, l, true);
+    rebuild_schreier_tree(c, l);
+  }
+}
+
+// Add the non-trivial residue <g> of a sift which failed at level <l> to the
+// strong generators.
+static void add_strong_gen(StabChain* const c, UInt4 const* const g, UInt l) {
+  if (l == c->nr_base) {
+    // <g> fixes every base point, and so the first point it moves is a new
+    // base point.
+    UInt4 pt = 0;
+    while (g[pt] == pt) {
+      pt++;
+    }
+    add_base_point(c, pt);
+  }
+  UInt const k = new_gen(c, g, l, false);
+  for (UInt i = 0; i <= l; i++) {
+    extend_orbit(c, i, k);
+    shorten_schreier_tree(c, i);
+  }
+}
+
+// Sift <g>, and add its residue to the strong generators if it is
+// non-trivial. Returns the level at which the sift failed, or the length of
+// the base if it did not fail and the residue is trivial.
+static UInt sift_and_add(StabChain* const c, UInt4* const g, UInt const l) {
+  UInt const j = sift(c, g, l);
+  if (j < c->nr_base || !is_id_perm4(g, c->degree)) {
+    add_strong_gen(c, g, j);
+    return j;
+  }
+  return c->nr_base;
+}
+
+static inline UInt next_random(StabChain* const c) {
+  c->random_state ^= c->random_state << 13;
+  c->random_state ^= c->random_state >> 7;
+  c->random_state ^= c->random_state << 17;
+  return (UInt) (c->random_state >> 32);
+}
+
+// Replace a random element of the pool by its product with another, and
+// multiply the accumulator by the result, as in:
+//
+//   C. R. Leedham-Green, and L. H. Soicher, Collection from the left and
+//   other strategies, J. Symbolic Comput. 9 (1990).
+static UInt4 const* random_element(StabChain* const c) {
+  UInt const n = c->degree;
+  UInt const i = next_random(c) % c->nr_pool;
+  UInt       j = next_random(c) % (c->nr_pool - 1);
+  if (j >= i) {
+    j++;
+  }
+  UInt4* const x = c->pool[i];
+  UInt4* const y = c->pool[j];
+  if (next_random(c) & 1) {
+    for (UInt v = 0; v < n; v++) {
+      x[v] = y[x[v]];
+    }
+  } else {
+    for (UInt v = 0; v < n; v++) {
+      c->tmp1[v] = x[y[v]];
+    }
+    memcpy(x, c->tmp1, n * sizeof(UInt4));
+  }
+  for (UInt v = 0; v < n; v++) {
+    c->acc[v] = x[c->acc[v]];
+  }
+  return c->acc;
+}
+
+static void init_random_elements(StabChain* const c, Obj gens) {
+  UInt const nr = LEN_LIST(gens);
+  c->nr_pool    = (nr < MIN_POOL_SIZE ? MIN_POOL_SIZE : nr);
+  c->pool       = safe_malloc(c->nr_pool * sizeof(UInt4*));
+  for (UInt i = 0; i < c->nr_pool; i++) {
+    c->pool[i] = new_perm4(c->degree);
+    copy_perm4_from_gap(c->pool[i], ELM_LIST(gens, (i % nr) + 1), c->degree);
+  }
+  id_perm4(c->acc, c->degree);
+  for (UInt i = 0; i < NR_WARM_UP; i++) {
+    random_element(c);
+  }
+}
+
+// Returns true if the product of the lengths of the basic orbits is <size>.
+static bool has_size(StabChain const* const c, Obj size) {
+  Obj order = INTOBJ_INT(1);
+  for (UInt l = 0; l < c->nr_base; l++) {
+    order = PROD(order, INTOBJ_INT(c->orbit_len[l]));
+  }
+  return EQ(order, size);
+}
+
+// Sift the Schreier generator u_pt * gens[k] * u_(pt ^ gens[k]) ^ -1 of
+// level <l>, where u_pt maps base[l] to <pt>, and add its residue to the
+// strong generators if it is non-trivial. Returns the level at which the sift
+// failed, or the length of the base.
+static UInt
+sift_schreier_gen(StabChain* const c, UInt const l, UInt4 const pt, UInt k) {
+  // h = u_pt * gens[k]
+  trace_word(c, l, pt);
+  UInt4* const h = c->tmp1;
+  id_perm4(h, c->degree);
+  apply_word(c, h);
+  for (UInt i = 0; i < c->degree; i++) {
+    h[i] = c->gens[k][h[i]];
+  }
+  return sift_and_add(c, h, l);
+}
+
+// Verify that the chain is complete by sifting every Schreier generator of
+// every level, from the last level to the first, and adding any non-trivial
+// residues to the strong generators.
+static void verify(StabChain* const c) {
+  Int l = (Int) c->nr_base - 1;
+  while (l >= 0) {
+    bool changed = false;
+    for (UInt i = 0; i < c->orbit_len[l] && !changed; i++) {
+      UInt4 const pt = c->orbit[l][i];
+      for (UInt k = 0; k < c->nr_gens && !changed; k++) {
+        if (c->depth[k] < (UInt) l || c->is_label[k]
+            || c->schreier[l][c->gens[k][pt]] == (Int4) k + 1) {
+          // gens[k] is not a strong generator of the level, or the Schreier
+          // generator is trivial, since gens[k] is the label of the edge from
+          // <pt> in the Schreier tree
+          continue;
+        }
+        UInt const j = sift_schreier_gen(c, l, pt, k);
+        if (j < c->nr_base) {
+          // the levels l + 1, . . ., j changed and must be verified again
+          l       = j;
+          changed = true;
+        }
+      }
+    }
+    if (!changed) {
+      l--;
+    }
+  }
+}
+
+// Returns the number of consecutive random elements which must sift through
+// the chain for it to be correct with probability at least <random> / 1000.
+static UInt nr_random_sifts(Int const random) {
+  if (random >= 1000) {
+    return 10;
+  }
+  UInt K = 1;
+  while (((UInt) (1000 - random) << K) < 1000) {
+    K++;
+  }
+  return K;
+}
+
+// The argument <gens> must be a list of permutations of [1 .. <degree>],
+// <base> a list of points in [1 .. <degree>], <random> an integer in the
+// range [0 .. 1000], and <size> the order of the group generated by <gens>,
+// or fail if it is not known.
+//
+// Returns a record with components:
+//
+//   * base: a base of the group generated by <gens> beginning with <base>;
+//   * orbits: the basic orbits, so that orbits[i] is the orbit of base[i]
+//     under the stabiliser of base[1], . . ., base[i - 1];
+//   * generators: the strong generators, so that generators[i] generates the
+//     stabiliser of base[1], . . ., base[i - 1], and generators[i] is empty
+//     for i = Length(base) + 1.
+//
+// If <size> is an integer, or <random> is 1000, then the result is always
+// correct, otherwise it is correct with probability at least
+// <random> / 1000.
+Obj FuncDIGRAPH_STAB_CHAIN(Obj self,
+                           Obj gens,
+                           Obj degree,
+                           Obj base,
+                           Obj random,
+                           Obj size) {
+  DIGRAPHS_ASSERT(IS_LIST(gens));
+  DIGRAPHS_ASSERT(IS_INTOBJ(degree) && INT_INTOBJ(degree) >= 0);
+  DIGRAPHS_ASSERT(IS_LIST(base));
+  DIGRAPHS_ASSERT(IS_INTOBJ(random));
+
+  UInt const n = INT_INTOBJ(degree);
+  StabChain  c;
+  init_stab_chain(&c, n);
+
+  for (Int i = 1; i <= LEN_LIST(base); i++) {
+    DIGRAPHS_ASSERT(IS_INTOBJ(ELM_LIST(base, i)));
+    UInt4 const pt  = INT_INTOBJ(ELM_LIST(base, i)) - 1;
+    bool        dup = false;
+    for (UInt l = 0; l < c.nr_base && !dup; l++) {
+      dup = (c.base[l] == pt);
+    }
+    if (!dup) {
+      add_base_point(&c, pt);
+    }
+  }
+
+  UInt const nr = LEN_LIST(gens);
+  for (UInt i = 1; i <= nr; i++) {
+    copy_perm4_from_gap(c.tmp1, ELM_LIST(gens, i), n);
+    sift_and_add(&c, c.tmp1, 0);
+  }
+
+  if (c.nr_gens > 0 && (size == Fail || !has_size(&c, size))) {
+    init_random_elements(&c, gens);
+    UInt const K     = nr_random_sifts(INT_INTOBJ(random));
+    UInt       nr_ok = 0;
+    while (size == Fail ? nr_ok < K : !has_size(&c, size)) {
+      memcpy(c.tmp2, random_element(&c), n * sizeof(UInt4));
+      UInt const j = sift_and_add(&c, c.tmp2, 0);
+      if (j < c.nr_base) {
+        nr_ok = 0;
+      } else {
+        nr_ok++;
+      }
+    }
+    if (size == Fail && INT_INTOBJ(random) >= 1000) {
+      verify(&c);
+    }
+  }
+
+  // Convert the strong generators into GAP permutations, the entries of
+  // <perms> corresponding to tree labels are left unbound.
+  Obj perms = NEW_PLIST(c.nr_gens == 0 ? T_PLIST_EMPTY : T_PLIST, c.nr_gens);
+  SET_LEN_PLIST(perms, c.nr_gens);
+  for (UInt k = 0; k < c.nr_gens; k++) {
+    if (c.is_label[k]) {
+      continue;
+    }
+    Obj    p   = NEW_PERM4(n);
+    UInt4* ptr = ADDR_PERM4(p);
+    memcpy(ptr, c.gens[k], n * sizeof(UInt4));
+    SET_ELM_PLIST(perms, k + 1, p);
+    CHANGED_BAG(perms);
+  }
+
+  Obj base_out = NEW_PLIST(c.nr_base == 0 ? T_PLIST_EMPTY : T_PLIST_CYC,
+                           c.nr_base);
+  SET_LEN_PLIST(base_out, c.nr_base);
+  Obj orbits = NEW_PLIST(c.nr_base == 0 ? T_PLIST_EMPTY : T_PLIST_TAB,
+                         c.nr_base);
+  SET_LEN_PLIST(orbits, c.nr_base);
+  Obj generators = NEW_PLIST(T_PLIST_TAB, c.nr_base + 1);
+  SET_LEN_PLIST(generators, c.nr_base + 1);
+
+  for (UInt l = 0; l <= c.nr_base; l++) {
+    if (l < c.nr_base) {
+      SET_ELM_PLIST(base_out, l + 1, INTOBJ_INT(c.base[l] + 1));
+      Obj orb = NEW_PLIST(T_PLIST_CYC, c.orbit_len[l]);
+      SET_LEN_PLIST(orb, c.orbit_len[l]);
+      for (UInt i = 0; i < c.orbit_len[l]; i++) {
+        SET_ELM_PLIST(orb, i + 1, INTOBJ_INT(c.orbit[l][i] + 1));
+      }
+      SET_ELM_PLIST(orbits, l + 1, orb);
+      CHANGED_BAG(orbits);
+    }
+    UInt len = 0;
+    for (UInt k = 0; k < c.nr_gens; k++) {
+      len += (c.depth[k] >= l && !c.is_label[k]);
+    }
+    Obj level = NEW_PLIST(len == 0 ? T_PLIST_EMPTY : T_PLIST, len);
+    SET_LEN_PLIST(level, len);
+    len = 0;
+    for (UInt k = 0; k < c.nr_gens; k++) {
+      if (c.depth[k] >= l && !c.is_label[k]) {
+        SET_ELM_PLIST(level, ++len, ELM_PLIST(perms, k + 1));
+      }
+    }
+    SET_ELM_PLIST(generators, l + 1, level);
+    CHANGED_BAG(generators);
+  }
+  free_stab_chain(&c);
+
+  Obj out = NEW_PREC(3);
+  AssPRec(out, RNamName("base"), base_out);
+  AssPRec(out, RNamName("orbits"), orbits);
+  AssPRec(out, RNamName("generators"), generators);
+  return out;
+}
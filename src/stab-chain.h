@@ -0,0 +1,24 @@
+/********************************************************************************
+**
+*A  stab-chain.h           randomised Schreier-Sims
+**
+**  Copyright (C) 2025 - J. D. Mitchell
+**
+**  This file is free software, see the digraphs/LICENSE.
+**
+********************************************************************************/
+
+#ifndef DIGRAPHS_SRC_STAB_CHAIN_H_
+#define DIGRAPHS_SRC_STAB_CHAIN_H_
+
+// GAP headers
+#include "gap-includes.h"
+
+Obj FuncDIGRAPH_STAB_CHAIN(Obj self,
+                           Obj gens,
+                           Obj degree,
+                           Obj base,
+                           Obj random,
+                           Obj size);
+
+#endif  // DIGRAPHS_SRC_STAB_CHAIN_H_
@@ -114,17 +114,17 @@ gap> ListTransformation(t);
 gap> gr := Digraph([[2], [1, 3], [2]]);
 <immutable digraph with 3 vertices, 4 edges>
 gap> Set(GeneratorsOfEndomorphismMonoid(gr));
-[ Transformation( [ 1, 2, 1 ] ), IdentityTransformation, 
-  Transformation( [ 2, 1, 2 ] ), Transformation( [ 3, 2, 1 ] ) ]
+[ Transformation( [ 1, 2, 1 ] ), Transformation( [ 2, 1, 2 ] ), 
+  Transformation( [ 3, 2, 1 ] ) ]
 gap> gr := DigraphCopy(gr);
 <immutable digraph with 3 vertices, 4 edges>
 gap> Set(GeneratorsOfEndomorphismMonoid(gr));
-[ Transformation( [ 1, 2, 1 ] ), IdentityTransformation, 
-  Transformation( [ 2, 1, 2 ] ), Transformation( [ 3, 2, 1 ] ) ]
+[ Transformation( [ 1, 2, 1 ] ), Transformation( [ 2, 1, 2 ] ), 
+  Transformation( [ 3, 2, 1 ] ) ]
 gap> gr := DigraphCopy(gr);;
 gap> Set(GeneratorsOfEndomorphismMonoid(gr, infinity));
-[ Transformation( [ 1, 2, 1 ] ), IdentityTransformation, 
-  Transformation( [ 2, 1, 2 ] ), Transformation( [ 3, 2, 1 ] ) ]
+[ Transformation( [ 1, 2, 1 ] ), Transformation( [ 2, 1, 2 ] ), 
+  Transformation( [ 3, 2, 1 ] ) ]
 gap> gr := DigraphCopy(gr);;
 gap> GeneratorsOfEndomorphismMonoid(gr, 1);
 [ Transformation( [ 3, 2, 1 ] ) ]
@@ -135,14 +135,14 @@ gap> HasGeneratorsOfEndomorphismMonoidAttr(gr);
 false
 gap> GeneratorsOfEndomorphismMonoid(gr, 3);
 [ Transformation( [ 3, 2, 1 ] ), Transformation( [ 2, 1, 2 ] ), 
-  IdentityTransformation ]
+  Transformation( [ 1, 2, 1 ] ) ]
 gap> HasGeneratorsOfEndomorphismMonoidAttr(gr);
 false
 gap> GeneratorsOfEndomorphismMonoid(gr, 4);
 [ Transformation( [ 3, 2, 1 ] ), Transformation( [ 2, 1, 2 ] ), 
-  IdentityTransformation, Transformation( [ 1, 2, 1 ] ) ]
+  Transformation( [ 1, 2, 1 ] ) ]
 gap> HasGeneratorsOfEndomorphismMonoidAttr(gr);
-false
+true
 
 #  GeneratorsOfEndomorphismMonoid 4
 # Complete digraph
@@ -166,32 +166,32 @@ gap> gr := Digraph(List([1 .. 5], x -> [1 .. 5]));
 gap> gens := GeneratorsOfEndomorphismMonoid(gr);
 [ Transformation( [ 1, 2, 3, 5, 4 ] ), Transformation( [ 1, 2, 4, 3 ] ), 
   Transformation( [ 1, 3, 2 ] ), Transformation( [ 2, 1 ] ), 
-  IdentityTransformation, Transformation( [ 1, 2, 3, 4, 1 ] ), 
-  Transformation( [ 1, 2, 3, 4, 2 ] ), Transformation( [ 1, 2, 3, 4, 3 ] ), 
-  Transformation( [ 1, 2, 3, 4, 4 ] ), Transformation( [ 1, 2, 3, 1, 4 ] ), 
+  Transformation( [ 1, 2, 3, 4, 1 ] ), Transformation( [ 1, 2, 3, 4, 2 ] ), 
+  Transformation( [ 1, 2, 3, 4, 3 ] ), Transformation( [ 1, 2, 3, 4, 4 ] ), 
+  Transformation( [ 1, 2, 3, 1, 4 ] ), Transformation( [ 1, 2, 3, 2, 4 ] ), 
+  Transformation( [ 1, 2, 3, 3, 4 ] ), Transformation( [ 1, 2, 1, 3, 4 ] ), 
+  Transformation( [ 1, 2, 2, 3, 4 ] ), Transformation( [ 1, 1, 2, 3, 4 ] ), 
   Transformation( [ 1, 2, 3, 1, 1 ] ), Transformation( [ 1, 2, 3, 1, 2 ] ), 
-  Transformation( [ 1, 2, 3, 1, 3 ] ), Transformation( [ 1, 2, 3, 2, 4 ] ), 
-  Transformation( [ 1, 2, 3, 2, 1 ] ), Transformation( [ 1, 2, 3, 2, 2 ] ), 
-  Transformation( [ 1, 2, 3, 2, 3 ] ), Transformation( [ 1, 2, 3, 3, 4 ] ), 
+  Transformation( [ 1, 2, 3, 1, 3 ] ), Transformation( [ 1, 2, 3, 2, 1 ] ), 
+  Transformation( [ 1, 2, 3, 2, 2 ] ), Transformation( [ 1, 2, 3, 2, 3 ] ), 
   Transformation( [ 1, 2, 3, 3, 1 ] ), Transformation( [ 1, 2, 3, 3, 2 ] ), 
-  Transformation( [ 1, 2, 3, 3, 3 ] ), Transformation( [ 1, 2, 1, 3, 4 ] ), 
-  Transformation( [ 1, 2, 1, 3, 1 ] ), Transformation( [ 1, 2, 1, 3, 2 ] ), 
-  Transformation( [ 1, 2, 1, 3, 3 ] ), Transformation( [ 1, 2, 1, 1, 3 ] ), 
-  Transformation( [ 1, 2, 1, 1, 1 ] ), Transformation( [ 1, 2, 1, 1, 2 ] ), 
-  Transformation( [ 1, 2, 1, 2, 3 ] ), Transformation( [ 1, 2, 1, 2, 1 ] ), 
-  Transformation( [ 1, 2, 1, 2, 2 ] ), Transformation( [ 1, 2, 2, 3, 4 ] ), 
+  Transformation( [ 1, 2, 3, 3, 3 ] ), Transformation( [ 1, 2, 1, 3, 1 ] ), 
+  Transformation( [ 1, 2, 1, 3, 2 ] ), Transformation( [ 1, 2, 1, 3, 3 ] ), 
+  Transformation( [ 1, 2, 1, 1, 3 ] ), Transformation( [ 1, 2, 1, 2, 3 ] ), 
   Transformation( [ 1, 2, 2, 3, 1 ] ), Transformation( [ 1, 2, 2, 3, 2 ] ), 
   Transformation( [ 1, 2, 2, 3, 3 ] ), Transformation( [ 1, 2, 2, 1, 3 ] ), 
-  Transformation( [ 1, 2, 2, 1, 1 ] ), Transformation( [ 1, 2, 2, 1, 2 ] ), 
-  Transformation( [ 1, 2, 2, 2, 3 ] ), Transformation( [ 1, 2, 2, 2, 1 ] ), 
-  Transformation( [ 1, 2, 2, 2, 2 ] ), Transformation( [ 1, 1, 2, 3, 4 ] ), 
-  Transformation( [ 1, 1, 2, 3, 1 ] ), Transformation( [ 1, 1, 2, 3, 2 ] ), 
-  Transformation( [ 1, 1, 2, 3, 3 ] ), Transformation( [ 1, 1, 2, 1, 3 ] ), 
-  Transformation( [ 1, 1, 2, 1, 1 ] ), Transformation( [ 1, 1, 2, 1, 2 ] ), 
-  Transformation( [ 1, 1, 2, 2, 3 ] ), Transformation( [ 1, 1, 2, 2, 1 ] ), 
-  Transformation( [ 1, 1, 2, 2, 2 ] ), Transformation( [ 1, 1, 1, 2, 3 ] ), 
-  Transformation( [ 1, 1, 1, 2, 1 ] ), Transformation( [ 1, 1, 1, 2, 2 ] ), 
-  Transformation( [ 1, 1, 1, 1, 2 ] ), Transformation( [ 1, 1, 1, 1, 1 ] ) ]
+  Transformation( [ 1, 2, 2, 2, 3 ] ), Transformation( [ 1, 1, 2, 3, 1 ] ), 
+  Transformation( [ 1, 1, 2, 3, 2 ] ), Transformation( [ 1, 1, 2, 3, 3 ] ), 
+  Transformation( [ 1, 1, 2, 1, 3 ] ), Transformation( [ 1, 1, 2, 2, 3 ] ), 
+  Transformation( [ 1, 1, 1, 2, 3 ] ), Transformation( [ 1, 2, 1, 1, 1 ] ), 
+  Transformation( [ 1, 2, 1, 1, 2 ] ), Transformation( [ 1, 2, 1, 2, 1 ] ), 
+  Transformation( [ 1, 2, 1, 2, 2 ] ), Transformation( [ 1, 2, 2, 1, 1 ] ), 
+  Transformation( [ 1, 2, 2, 1, 2 ] ), Transformation( [ 1, 2, 2, 2, 1 ] ), 
+  Transformation( [ 1, 2, 2, 2, 2 ] ), Transformation( [ 1, 1, 2, 1, 1 ] ), 
+  Transformation( [ 1, 1, 2, 1, 2 ] ), Transformation( [ 1, 1, 2, 2, 1 ] ), 
+  Transformation( [ 1, 1, 2, 2, 2 ] ), Transformation( [ 1, 1, 1, 2, 1 ] ), 
+  Transformation( [ 1, 1, 1, 2, 2 ] ), Transformation( [ 1, 1, 1, 1, 2 ] ), 
+  Transformation( [ 1, 1, 1, 1, 1 ] ) ]
 
 #  GeneratorsOfEndomorphismMonoid 5
 # Empty digraph
@@ -249,7 +249,7 @@ gap> gr := CycleDigraph(20);
 gap> gens := [];;
 gap> gens := Concatenation(gens, GeneratorsOfEndomorphismMonoid(gr));
 [ Transformation( [ 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17,
-      18, 19, 20, 1 ] ), IdentityTransformation ]
+      18, 19, 20, 1 ] ) ]
 gap> ForAll(gens, x -> AsPermutation(x) in AutomorphismGroup(gr));
 true
 
@@ -524,6 +524,28 @@ gap> DIGRAPH_ConnectivityDataForVertex(gr, 2);;
 gap> DigraphShortestDistances(gr);
 [ [ 0, 1, 1 ], [ 1, 0, 1 ], [ 1, 1, 0 ] ]
 
+#  DigraphShortestDistances, using the digraph group
+gap> gr := Digraph([[2], [3], [1], [5, 2], [6, 3], [4, 1]]);;
+gap> SetDigraphGroup(gr, Group((1, 2, 3)(4, 5, 6)));
+gap> DIGRAPHS_RepresentativeDistances(gr);
+[ [ 0, 1, 2, fail, fail, fail ], [ 3, 1, 2, 0, 1, 2 ] ]
+gap> DigraphShortestDistance(gr, 6, 3);
+3
+gap> DigraphShortestDistance(gr, 2, 4);
+fail
+gap> DigraphShortestDistances(gr)[5];
+[ 2, 3, 1, 2, 0, 1 ]
+gap> DigraphShortestDistances(gr) = DIGRAPH_SHORTEST_DIST(gr);
+true
+gap> DigraphDiameter(gr);
+fail
+gap> gr := CycleDigraph(7);;
+gap> SetDigraphGroup(gr, Group((1, 2, 3, 4, 5, 6, 7)));
+gap> DigraphDiameter(gr);
+6
+gap> DigraphShortestDistances(gr) = DIGRAPH_SHORTEST_DIST(gr);
+true
+
 #  OutNeighbours and InNeighbours
 gap> gr := Digraph(rec(DigraphNrVertices := 10,
 >                      DigraphSource := [1, 1, 5, 5, 7, 10],
@@ -1070,6 +1092,12 @@ gap> DigraphAllUndirectedSimpleCircuits(g);
   [ 2, 4, 10, 9, 5, 7, 8 ], [ 4, 3, 9, 5, 6, 10 ], 
   [ 4, 3, 9, 5, 7, 8, 6, 10 ], [ 4, 3, 9, 10 ], [ 5, 6, 8, 7 ], 
   [ 9, 5, 6, 10 ], [ 9, 5, 7, 8, 6, 10 ] ]
+gap> D := PetersenGraph();;
+gap> Collected(List(DigraphAllChordlessCycles(D), Length));
+[ [ 5, 12 ], [ 6, 10 ] ]
+gap> D := DigraphDisjointUnion(CycleGraph(1000), CompleteDigraph(4));;
+gap> List(DigraphAllChordlessCycles(D), Length);
+[ 3, 3, 3, 3, 1000 ]
 
 # FacialCycles
 gap> g := Digraph([]);;
@@ -1134,6 +1162,71 @@ gap> gr := Digraph([[2, 6, 10], [3], [4], [5], [1],
 gap> DigraphLongestSimpleCircuit(gr);
 [ 1, 10, 11, 12, 13, 14 ]
 
+#  SimpleCircuitsFinder
+gap> gr := Digraph([[3, 6, 7], [3, 6, 8], [1, 2, 3, 6, 7, 8],
+> [2, 3, 4, 8], [2, 3, 4, 5, 6, 7], [1, 3, 4, 5, 7], [2, 3, 6, 8],
+> [1, 2, 3, 8]]);;
+gap> SimpleCircuitsFinder(gr, function(count, c)
+>   count[Length(c)] := count[Length(c)] + 1;
+> end, List([1 .. 8], x -> 0), infinity, 1, infinity);
+[ 4, 9, 19, 37, 60, 68, 48, 14 ]
+gap> Length(SimpleCircuitsFinder(gr, fail, [], infinity, 3, 4));
+56
+gap> SimpleCircuitsFinder(gr, fail, [], infinity, 3, 4)
+> = Filtered(DigraphAllSimpleCircuits(gr), c -> Length(c) in [3, 4]);
+true
+gap> SimpleCircuitsFinder(gr, fail, [], 10, 1, infinity)
+> = DigraphAllSimpleCircuits(gr){[1 .. 10]};
+true
+gap> SimpleCircuitsFinder(gr, fail, [], infinity, 1, 1);
+[ [ 3 ], [ 4 ], [ 5 ], [ 8 ] ]
+gap> SimpleCircuitsFinder(gr, fail, [], infinity, 5, 4);
+[  ]
+gap> SimpleCircuitsFinder(gr, function(long, c)
+>   if Length(c) = 8 then
+>     Add(long, c);
+>     return true;
+>   fi;
+> end, [], infinity, 1, infinity);
+[ [ 1, 3, 7, 2, 6, 5, 4, 8 ] ]
+gap> SimpleCircuitsFinder(CompleteDigraph(5), fail, [], 2, 5, 5);
+[ [ 1, 2, 3, 4, 5 ], [ 1, 2, 3, 5, 4 ] ]
+gap> SimpleCircuitsFinder(Digraph([[3], [1], [1, 4], [1, 1]]),
+> fail, [], infinity, 1, infinity);
+[ [ 1, 3 ], [ 1, 3, 4 ] ]
+gap> SimpleCircuitsFinder(Digraph([[1, 1, 2], [1]]),
+> fail, [], infinity, 1, infinity);
+[ [ 1 ], [ 1, 2 ] ]
+gap> SimpleCircuitsFinder(EmptyDigraph(0), fail, [], infinity, 1, infinity);
+[  ]
+gap> SimpleCircuitsFinder(CycleDigraph(IsMutableDigraph, 4),
+> fail, [], infinity, 1, infinity);
+[ [ 1, 2, 3, 4 ] ]
+gap> SimpleCircuitsFinder(gr, fail, [], infinity, 1, infinity)
+> = DigraphAllSimpleCircuits(gr);
+true
+gap> SimpleCircuitsFinder(1, fail, [], infinity, 1, infinity);
+Error, the 1st argument <D> must be a digraph,
+gap> SimpleCircuitsFinder(gr, x -> x, [], infinity, 1, infinity);
+Error, the 2nd argument <hook> must be fail, or a function with 2 arguments,
+gap> SimpleCircuitsFinder(gr, fail, 1, infinity, 1, infinity);
+Error, when the 2nd argument <hook> is fail, the 3rd argument <user_param> mus\
+t be a mutable list,
+gap> SimpleCircuitsFinder(gr, fail, [], 0, 1, infinity);
+Error, the 4th argument <limit> must be infinity, or a positive integer,
+gap> SimpleCircuitsFinder(gr, fail, [], infinity, 0, infinity);
+Error, the 5th argument <min> must be a positive integer,
+gap> SimpleCircuitsFinder(gr, fail, [], infinity, 1, -1);
+Error, the 6th argument <max> must be infinity, or a positive integer,
+gap> SimpleCircuitsFinder(gr, function(x, c)
+>   Error("stop");
+> end, [], infinity, 1, infinity);
+Error, stop
+gap> SimpleCircuitsFinder(CycleDigraph(3), function(x, c)
+>   Add(x, Length(DigraphAllSimpleCircuits(CompleteDigraph(3))));
+> end, [], infinity, 1, infinity);
+[ 5 ]
+
 #  AsTransformation
 gap> gr := Digraph([[2], [1, 3], [4], [3]]);;
 gap> AsTransformation(gr);
@@ -1597,7 +1690,7 @@ gap> DigraphColouring(Digraph([[4, 8], [6, 10], [9], [2, 3, 9], [],
 fail
 gap> DigraphColouring(Digraph([[4, 8], [6, 10], [9], [2, 3, 9], [],
 > [3], [4], [6], [], [5, 7]]), 3);
-Transformation( [ 2, 2, 3, 1, 2, 1, 2, 3, 2, 1 ] )
+Transformation( [ 2, 2, 2, 1, 2, 1, 2, 3, 3, 1 ] )
 gap> ChromaticNumber(DigraphDisjointUnion(CompleteDigraph(1),
 > Digraph([[2], [4], [1, 2], [3]])));
 3
@@ -1614,9 +1707,9 @@ gap> gr := DigraphFromDigraph6String(Concatenation(
 gap> ChromaticNumber(gr);
 3
 gap> DigraphColouring(gr, 3);
-Transformation( [ 1, 2, 1, 2, 3, 2, 1, 1, 1, 2, 2, 1, 2, 3, 3, 1, 1, 1, 2, 1,
-  2, 2, 3, 3, 3, 1, 1, 2, 3, 3, 3, 2, 3, 2, 3, 2, 3, 1, 2, 1, 3, 1, 2, 3,
-  3 ] )
+Transformation( [ 1, 2, 2, 1, 2, 1, 3, 1, 1, 2, 2, 2, 1, 2, 1, 2, 1, 1, 3, 3,
+  3, 2, 3, 3, 2, 2, 1, 3, 1, 3, 3, 3, 2, 1, 3, 1, 3, 1, 1, 2, 2, 3, 3, 3,
+  2 ] )
 gap> DigraphColouring(gr, 2);
 fail
 gap> DigraphGreedyColouring(gr);
@@ -2048,6 +2141,61 @@ gap> ArticulationPoints(D);
 gap> Bridges(D);
 [ [ 2, 3 ], [ 1, 2 ] ]
 
+gap> D := Digraph([[2], [3, 4], [], []]);
+<immutable digraph with 4 vertices, 3 edges>
+gap> ArticulationPoints(D);
+[ 2 ]
+gap> Bridges(D);
+[ [ 2, 3 ], [ 2, 4 ], [ 1, 2 ] ]
+gap> D := ChainDigraph(IsMutableDigraph, 100000);
+<mutable digraph with 100000 vertices, 99999 edges>
+gap> Length(Bridges(D));
+99999
+gap> Length(ArticulationPoints(D));
+99998
+gap> DigraphAddEdge(D, 100000, 1);
+<mutable digraph with 100000 vertices, 100000 edges>
+gap> IsBridgelessDigraph(D);
+true
+gap> IsBiconnectedDigraph(D);
+true
+
+# BiconnectedComponents
+gap> BiconnectedComponents(Digraph([[2, 7], [3, 5], [4], [2], [6], [1], []]));
+[ [ 1, 2, 5, 6 ], [ 1, 7 ], [ 2, 3, 4 ] ]
+gap> BiconnectedComponents(ChainDigraph(4));
+[ [ 1, 2 ], [ 2, 3 ], [ 3, 4 ] ]
+gap> BiconnectedComponents(NullDigraph(0));
+[  ]
+gap> BiconnectedComponents(Digraph([[1, 1]]));
+[ [ 1 ] ]
+gap> D := Digraph([[2], [1], [4], [3], [5]]);
+<immutable digraph with 5 vertices, 5 edges>
+gap> BiconnectedComponents(D);
+[ [ 1, 2 ], [ 3, 4 ], [ 5 ] ]
+gap> ArticulationPoints(D);
+[  ]
+gap> D := Digraph([[1, 1, 2, 2], [2, 2, 3, 3], [1, 1, 1]]);
+<immutable multidigraph with 3 vertices, 11 edges>
+gap> BiconnectedComponents(D);
+[ [ 1, 2, 3 ] ]
+gap> D := DigraphDisjointUnion(CycleDigraph(IsMutableDigraph, 3),
+>                              ChainDigraph(3));
+<mutable digraph with 6 vertices, 5 edges>
+gap> DigraphAddEdge(D, 3, 4);
+<mutable digraph with 6 vertices, 6 edges>
+gap> BiconnectedComponents(D);
+[ [ 1, 2, 3 ], [ 3, 4 ], [ 4, 5 ], [ 5, 6 ] ]
+gap> ArticulationPoints(D);
+[ 5, 4, 3 ]
+gap> D := DigraphFromGraph6String("FlCX?");;
+gap> Union(BiconnectedComponents(D)) = DigraphVertices(D);
+true
+gap> Set(Filtered(DigraphVertices(D),
+>                 v -> Number(BiconnectedComponents(D), b -> v in b) > 1))
+> = Set(ArticulationPoints(D));
+true
+
 # StrongOrientation
 gap> filename := Concatenation(DIGRAPHS_Dir(), "/data/graph5.g6.gz");;
 gap> D := ReadDigraphs(filename);;
@@ -2826,6 +2974,16 @@ gap> D := DigraphFromGraph6String("Cr");
 gap> SetDigraphVertexLabels(D, [[1, 1], [2, 1], [1, 2], [2, 2]]);
 gap> IsMaximumMatching(D, DigraphMaximumMatching(D));
 true
+gap> D := DigraphSymmetricClosure(CycleDigraph(10001));;
+gap> M := DigraphMaximumMatching(D);; Length(M);
+5000
+gap> IsMaximumMatching(D, M);
+true
+gap> D := CompleteBipartiteDigraph(200, 300);;
+gap> M := DigraphMaximumMatching(D);; Length(M);
+200
+gap> IsMaximumMatching(D, M);
+true
 
 # DigraphNrLoops
 gap> D := EmptyDigraph(5);
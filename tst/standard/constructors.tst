@@ -152,6 +152,30 @@ gap> gr2 := LineDigraph(gr);
 <immutable digraph with 7 vertices, 12 edges>
 gap> OutNeighbours(gr2);
 [ [ 3 ], [ 7 ], [ 4, 5, 6 ], [ 1, 2 ], [ 3 ], [ 7 ], [ 4, 5, 6 ] ]
+gap> IsDigraphWithAdjacencyFunction(gr2);
+true
+gap> DigraphAdjacencyFunction(gr2)(1, 3);
+true
+gap> DigraphAdjacencyFunction(gr2)(1, 2);
+false
+gap> D := Digraph(IsMutableDigraph, [[1, 2], [1]]);
+<mutable digraph with 2 vertices, 3 edges>
+gap> gr2 := LineDigraph(D);
+<mutable digraph with 3 vertices, 4 edges>
+gap> OutNeighbours(gr2);
+[ [ 2 ], [ 3 ], [ 1, 2 ] ]
+gap> gr2 := LineUndirectedDigraph(Digraph([[1, 2], [1, 3], [2]]));
+<immutable digraph with 3 vertices, 4 edges>
+gap> OutNeighbours(gr2);
+[ [ 2 ], [ 1, 3 ], [ 2 ] ]
+gap> IsDigraphWithAdjacencyFunction(gr2);
+true
+gap> DigraphAdjacencyFunction(gr2)(1, 3);
+false
+gap> gr := Digraph(List([1 .. 1000],
+>                       i -> [i mod 1000 + 1, (i + 1) mod 1000 + 1]));;
+gap> LineDigraph(gr);
+<immutable digraph with 2000 vertices, 4000 edges>
 gap> gr := CompleteDigraph(6);;
 gap> gr2 := LineUndirectedDigraph(gr);
 <immutable digraph with 15 vertices, 120 edges>
@@ -177,6 +201,7 @@ gap> LineUndirectedDigraph(gr);
 Error, the argument <D> must be a symmetric digraph,
 
 #  DIGRAPHS_UnbindVariables
+gap> Unbind(D);
 gap> Unbind(adj);
 gap> Unbind(bddigraph);
 gap> Unbind(bdgroup);
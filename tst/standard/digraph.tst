@@ -2059,6 +2059,104 @@ gap> graph := RandomDigraph(IsEulerianDigraph, 10);;
 >     Print("False");
 >   fi;
 
+#  Tracked mutable digraphs
+gap> D := EmptyDigraph(IsMutableDigraph, 4);
+<mutable empty digraph with 4 vertices>
+gap> IsTrackedDigraph(D);
+false
+gap> DigraphEnableTracking(D);
+<mutable empty digraph with 4 vertices>
+gap> IsTrackedDigraph(D);
+true
+gap> DigraphNrStronglyConnectedComponents(D);
+4
+gap> DigraphAddEdges(D, [[1, 2], [2, 3]]);
+<mutable digraph with 4 vertices, 2 edges>
+gap> DigraphNrStronglyConnectedComponents(D);
+4
+gap> DigraphAddEdge(D, 3, 1);
+<mutable digraph with 4 vertices, 3 edges>
+gap> DigraphStronglyConnectedComponents(D);
+rec( comps := [ [ 1, 2, 3 ], [ 4 ] ], id := [ 1, 1, 1, 2 ] )
+gap> DigraphConnectedComponents(D);
+rec( comps := [ [ 1, 2, 3 ], [ 4 ] ], id := [ 1, 1, 1, 2 ] )
+gap> DigraphAddEdge(D, 1, 2);;
+gap> IsMultiDigraph(D);
+true
+gap> InNeighboursOfVertex(D, 2);
+[ 1, 1 ]
+gap> DigraphRemoveAllMultipleEdges(D);;
+gap> IsMultiDigraph(D);
+false
+gap> InDegreeOfVertex(D, 2);
+1
+gap> DigraphReverse(D);;
+gap> InNeighboursOfVertex(D, 1);
+[ 2 ]
+gap> DigraphRemoveEdge(D, 2, 1);;
+gap> DigraphNrStronglyConnectedComponents(D);
+4
+gap> MakeImmutable(D);;
+gap> IsTrackedDigraph(D);
+false
+gap> DigraphEnableTracking(D);
+Error, the argument <D> must be a mutable digraph,
+gap> D := DigraphEnableTracking(ChainDigraph(IsMutableDigraph, 3));
+<mutable digraph with 3 vertices, 2 edges>
+gap> DigraphDisableTracking(D);
+<mutable digraph with 3 vertices, 2 edges>
+gap> IsTrackedDigraph(D);
+false
+gap> test := function(D, G)
+>   local s1, s2;
+>   s1 := DigraphStronglyConnectedComponents(D);
+>   s2 := DigraphStronglyConnectedComponents(G);
+>   return DigraphNrEdges(D) = DigraphNrEdges(G)
+>     and InNeighbours(D) = InNeighbours(G)
+>     and InDegrees(D) = InDegrees(G)
+>     and IsMultiDigraph(D) = IsMultiDigraph(G)
+>     and DigraphConnectedComponents(D) = DigraphConnectedComponents(G)
+>     and IsConnectedDigraph(D) = IsConnectedDigraph(G)
+>     and IsStronglyConnectedDigraph(D) = IsStronglyConnectedDigraph(G)
+>     and DigraphNrStronglyConnectedComponents(D) = Length(s2.comps)
+>     and Set(List(s1.comps, Set)) = Set(List(s2.comps, Set))
+>     and ForAll(DigraphVertices(D), v -> v in s1.comps[s1.id[v]])
+>     and ForAll(DigraphEdges(D), e -> s1.id[e[1]] >= s1.id[e[2]]);
+> end;;
+gap> D := DigraphEnableTracking(EmptyDigraph(IsMutableDigraph, 20));;
+gap> G := EmptyDigraph(IsMutableDigraph, 20);;
+gap> Reset(GlobalMersenneTwister, 2025);;
+gap> fails := [];;
+gap> for i in [1 .. 400] do
+>   x := Random(DigraphVertices(G));
+>   y := Random(DigraphVertices(G));
+>   r := Random([1 .. 10]);
+>   if r = 1 then
+>     DigraphAddVertex(D);
+>     DigraphAddVertex(G);
+>   elif r <= 3 and DigraphNrEdges(G) > 0 then
+>     e := Random(DigraphEdges(G));
+>     DigraphRemoveEdge(D, e);
+>     DigraphRemoveEdge(G, e);
+>   elif r = 4 and DigraphNrEdges(G) > 0 then
+>     e := Random(DigraphEdges(G));
+>     if not IsDigraphEdge(G, e[2], e[1]) then
+>       DigraphReverseEdge(D, e);
+>       DigraphReverseEdge(G, e);
+>     fi;
+>   elif not IsDigraphEdge(G, x, y) then
+>     DigraphAddEdge(D, x, y);
+>     DigraphAddEdge(G, x, y);
+>   fi;
+>   if not test(D, G) then
+>     Add(fails, i);
+>   fi;
+> od;
+gap> fails;
+[  ]
+gap> D = G;
+true
+
 #  DIGRAPHS_UnbindVariables
 gap> Unbind(D);
 gap> Unbind(D1);
@@ -2079,11 +2177,13 @@ gap> Unbind(d);
 gap> Unbind(di);
 gap> Unbind(digraph);
 gap> Unbind(divides);
+gap> Unbind(e);
 gap> Unbind(elms);
 gap> Unbind(eq);
 gap> Unbind(error);
 gap> Unbind(f);
 gap> Unbind(failed);
+gap> Unbind(fails);
 gap> Unbind(foo);
 gap> Unbind(g);
 gap> Unbind(gr);
@@ -39,6 +39,16 @@ Error, the 5th argument <max_results> must be an integer or infinity, not list\
  (string),
 gap> HomomorphismDigraphsFinder(gr1, gr2, fail, "a", 1, 0, 0, 0, 0, 0, 0);
 Error, the 6th argument <hint> must be a positive integer, not 0,
+gap> HomomorphismDigraphsFinder(gr1, gr2, fail, "a", 1, [1, 0], 0, 0, 0, 0,
+> 0);
+Error, the 6th argument <hint> must only contain positive integers, but found \
+integer in position 2,
+gap> HomomorphismDigraphsFinder(gr1, gr2, fail, "a", 1, [2, 2], 0, 0, 0, 0,
+> 0);
+Error, in the 6th argument <hint> position 2 is a duplicate,
+gap> HomomorphismDigraphsFinder(gr1, gr2, fail, "a", 1, [1, , 2], 0, 0, 0, 0,
+> 0);
+Error, the 6th argument <hint> must be a dense list,
 gap> HomomorphismDigraphsFinder(gr1, gr2, fail, "a", 5, 1, "b", 0, 0, 0, 0);
 Error, the 7th argument <injective> must be an integer or true or false, not l\
 ist (string),
@@ -153,6 +163,31 @@ s [1 .. 2], since it contains the integer 3, which is greater than 2,
 gap> HomomorphismDigraphsFinder(gr1, gr1, fail, [], 1, 2, 0, [1, 2],
 > [], [1, fail], [2, 1]);
 Error, the 2nd argument <partition> must be a homogeneous list,
+gap> HomomorphismDigraphsFinder(gr1, gr1, fail, [], 1, 2, 0, [1, 2], [],
+> fail, fail : heuristic := 1);
+Error, the option <heuristic> must be a string, not integer,
+gap> HomomorphismDigraphsFinder(gr1, gr1, fail, [], 1, 2, 0, [1, 2], [],
+> fail, fail : heuristic := "dom/ddeg");
+Error, the option <heuristic> must be one of "dom", "dom/deg", "dom/wdeg", or \
+"restarts", not "dom/ddeg",
+gap> D1 := DigraphSymmetricClosure(CycleDigraph(6));;
+gap> D2 := JohnsonDigraph(5, 2);;
+gap> homos := HomomorphismDigraphsFinder(D1, D2, fail, [], infinity, fail, 0,
+> [1 .. 10], [], fail, fail, fail, Group(()));;
+gap> Length(homos) > 0;
+true
+gap> ForAll(["dom", "dom/deg", "dom/wdeg", "restarts"],
+> h -> Set(HomomorphismDigraphsFinder(D1, D2, fail, [], infinity, fail, 0,
+>          [1 .. 10], [], fail, fail, fail, Group(()) : heuristic := h))
+>      = Set(homos));
+true
+gap> D1 := JohnsonDigraph(6, 2);;
+gap> ForAll(["dom", "dom/deg", "dom/wdeg", "restarts"],
+> h -> DigraphHomomorphism(D1, CompleteDigraph(4) : heuristic := h) = fail);
+true
+gap> DigraphMonomorphism(D1, JohnsonDigraph(7, 2) : heuristic := "restarts")
+> <> fail;
+true
 gap> gr := ChainDigraph(2);
 <immutable chain digraph with 2 vertices>
 gap> GeneratorsOfEndomorphismMonoid();
@@ -359,6 +394,45 @@ gap> D := Digraph([[3], [], [2]]);;
 gap> DigraphGreedyColouring(D, [1 .. 3]);
 Transformation( [ 1, 1, 2 ] )
 
+# DigraphDSATURColouring
+gap> DigraphDSATURColouring(EmptyDigraph(0));
+IdentityTransformation
+gap> DigraphDSATURColouring(Digraph([[1]]));
+fail
+gap> DigraphDSATURColouring(CycleDigraph(5));
+Transformation( [ 1, 2, 1, 2, 3 ] )
+gap> D := Digraph([[7, 8, 9, 10], [6, 8, 9, 10], [6, 7, 9, 10],
+> [6, 7, 8, 10], [6, 7, 8, 9], [], [], [], [], []]);;
+gap> DigraphGreedyColouring(D, [1, 6, 2, 7, 3, 8, 4, 9, 5, 10]);
+Transformation( [ 1, 2, 3, 4, 5, 1, 2, 3, 4, 5 ] )
+gap> DigraphDSATURColouring(D);
+Transformation( [ 1, 1, 1, 1, 1, 2, 2, 2, 2, 2 ] )
+gap> DigraphColouring(CycleDigraph(6), 4);
+Transformation( [ 1, 2, 3, 4, 1, 2 ] )
+gap> DigraphGreedyColouring(EmptyDigraph(3), [1, 1, 2]);
+Error, the 2nd argument <order> must be a permutation of [1 .. 3]
+gap> DigraphGreedyColouring(EmptyDigraph(3), D -> [0, 1, 2]);
+Error, the 2nd argument <order> must be a permutation of [1 .. 3]
+gap> DigraphGreedyColouring(EmptyDigraph(3), D -> [1, 2, 4]);
+Error, the 2nd argument <order> must be a permutation of [1 .. 3]
+gap> DigraphGreedyColouringNC(CycleDigraph(3), [1, 2, 4]);
+Error, the 2nd argument <order> must be a permutation of [1 .. 3]
+gap> DigraphSmallestLastOrder(CycleDigraph(5));
+[ 5, 4, 3, 2, 1 ]
+gap> DIGRAPH_GREEDY_COLOURING(CycleDigraph(3), [1, , 3]);
+Error, List Element: <list>[2] must have an assigned value
+gap> DIGRAPH_GREEDY_COLOURING(CycleDigraph(3), [3, 1, 2]);
+[ 2, 3, 1 ]
+gap> D := Digraph([[2, 2, 3], [1, 4], [3], [], [1]]);;
+gap> DigraphSmallestLastOrder(D);
+[ 3, 1, 2, 5, 4 ]
+gap> DigraphWelshPowellOrder(D);
+[ 1, 2, 3, 4, 5 ]
+gap> D := DigraphAddEdge(CycleDigraph(30), 1, 16);;
+gap> DigraphWelshPowellOrder(D);
+[ 1, 16, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 17, 18, 19, 20, 21, 
+  22, 23, 24, 25, 26, 27, 28, 29, 30 ]
+
 # DigraphWelshPowellOrder
 gap> DigraphGreedyColouring(EmptyDigraph(0), DigraphWelshPowellOrder);
 IdentityTransformation
@@ -896,6 +970,24 @@ gap> HomomorphismDigraphsFinder(gr, gr, fail, [], infinity, fail, 0,
 gap> Length(last);
 100
 
+#  HomomorphismDigraphsFinder: searching for a list of ranks
+gap> gr := Digraph(List([1 .. 3], x -> [1 .. 3]));;
+gap> List(HomomorphismDigraphsFinder(gr, gr, fail, [], infinity, [2, 1], 0,
+> [1 .. 3], [], fail, fail), t -> RankOfTransformation(t, 3));
+[ 2, 2, 2, 1 ]
+gap> List(HomomorphismDigraphsFinder(gr, gr, fail, [], 2, [1, 2], 0,
+> [1 .. 3], [], fail, fail), t -> RankOfTransformation(t, 3));
+[ 1, 2 ]
+gap> HomomorphismDigraphsFinder(gr, gr, fail, [], infinity, [4, 3], 0,
+> [1 .. 3], [], fail, fail);
+[ IdentityTransformation ]
+gap> HomomorphismDigraphsFinder(gr, gr, fail, [], infinity, [2, 3], 1,
+> [1 .. 3], [], fail, fail);
+[ IdentityTransformation ]
+gap> HomomorphismDigraphsFinder(gr, gr, fail, [], infinity, [], 0,
+> [1 .. 3], [], fail, fail);
+[  ]
+
 #  HomomorphismDigraphsFinder: finding monomorphisms
 gap> gr1 := Digraph([[], [1]]);;
 gap> gr1 := DigraphSymmetricClosure(gr1);;
@@ -1044,6 +1136,18 @@ gap> DigraphMonomorphism(gr1, gr2);
 IdentityTransformation
 gap> DigraphMonomorphism(CompleteDigraph(2), Digraph([[2], [1, 3], [2]]));
 IdentityTransformation
+gap> DigraphMonomorphism(CompleteDigraph(5),
+>                        DigraphSymmetricClosure(CycleDigraph(100)));
+fail
+gap> DigraphMonomorphism(DigraphSymmetricClosure(CycleDigraph(4)),
+>                        PetersenGraph());
+fail
+gap> gr1 := CompleteDigraph(4);;
+gap> gr2 := DigraphDisjointUnion(CycleDigraph(50), CompleteDigraph(5));;
+gap> IsDigraphMonomorphism(gr1, gr2, DigraphMonomorphism(gr1, gr2));
+true
+gap> DigraphEmbedding(EmptyDigraph(2), CompleteDigraph(30));
+fail
 
 #  MonomorphismsDigraphs and MonomorphismsDigraphsRepresentatives
 gap> gr1 := ChainDigraph(2);;
@@ -2162,8 +2266,8 @@ gap> DigraphHomomorphism(NullDigraph(1), NullDigraph(513));
 IdentityTransformation
 gap> HomomorphismDigraphsFinder(NullDigraph(1), NullDigraph(510), fail, [], 1,
 > false, 0, 0, 0, 0, 0);
-Error, the 6th argument <hint> must be an integer or fail, not boolean or fail\
-,
+Error, the 6th argument <hint> must be an integer, a list, or fail, not boolea\
+n or fail,
 gap> HomomorphismDigraphsFinder(NullDigraph(1), NullDigraph(510), fail, [], 1,
 > fail, true, 0, 0, 0, 0);
 Error, the 8th argument <image> must be a list or fail, not integer,
@@ -2515,6 +2619,24 @@ gap> MaximalCommonSubdigraph(Digraph([[1, 1]]), Digraph([[1]]));
 Error, the 1st argument (a digraph) must not satisfy IsMultiDigraph
 gap> MinimalCommonSuperdigraph(Digraph([[1, 1]]), Digraph([[1]]));
 Error, the 1st argument (a digraph) must not satisfy IsMultiDigraph
+gap> MaximalCommonSubdigraph(Digraph([[1]]), Digraph([[1, 1]]));
+Error, the 2nd argument (a digraph) must not satisfy IsMultiDigraph
+gap> MaximalCommonSubdigraph(Digraph([[1, 2], [3], []]),
+> Digraph([[2, 3], [1, 3], [1, 2, 3]]));
+[ <immutable digraph with 1 vertex, 1 edge>, IdentityTransformation, 
+  Transformation( [ 3, 2, 3 ] ) ]
+gap> D1 := ChainDigraph(20);;
+gap> D2 := CycleDigraph(20);;
+gap> M := MaximalCommonSubdigraph(D1, D2);;
+gap> DigraphNrVertices(M[1]);
+19
+gap> IsDigraphEmbedding(M[1], D1, M[2]) and IsDigraphEmbedding(M[1], D2, M[3]);
+true
+gap> M := MaximalCommonSubdigraph(D2, D1);;
+gap> DigraphNrVertices(M[1]);
+19
+gap> IsDigraphEmbedding(M[1], D2, M[2]) and IsDigraphEmbedding(M[1], D1, M[3]);
+true
 
 # LatticeDigraphEmbedding
 gap> D := Digraph([[2], [3], [4], []]);
@@ -2896,6 +3018,16 @@ gap> HomomorphismDigraphsFinder(H,
 > Group(()));
 [ Transformation( [ 8, 1, 5, 7, 3, 4, 6, 8 ] ) ]
 
+# Homomorphisms into digraphs with large automorphism groups
+gap> D := HypercubeGraph(4);;
+gap> Length(HomomorphismsDigraphs(DigraphSymmetricClosure(ChainDigraph(3)), D));
+256
+gap> D := KneserGraph(5, 2);;
+gap> Length(HomomorphismsDigraphs(CycleGraph(5), D));
+120
+gap> Length(MonomorphismsDigraphs(CycleGraph(5), D));
+120
+
 #  DIGRAPHS_UnbindVariables
 gap> Unbind(D);
 gap> Unbind(D1);
@@ -2903,6 +3035,7 @@ gap> Unbind(D2);
 gap> Unbind(DD);
 gap> Unbind(G);
 gap> Unbind(H);
+gap> Unbind(M);
 gap> Unbind(N5);
 gap> Unbind(edges);
 gap> Unbind(epis);
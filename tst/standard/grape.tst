@@ -260,6 +260,45 @@ gap> if DIGRAPHS_IsGrapeLoaded() then
 gap> Digraph(SymmetricGroup(3), [1, 2, 3], OnPoints, {x, y} -> x <> y);
 <immutable digraph with 3 vertices, 6 edges>
 
+# Symmetry-compressed digraphs
+gap> D := Digraph(SymmetricGroup(5), Combinations([1 .. 5], 2), OnSets,
+>                 {x, y} -> IsEmpty(Intersection(x, y)));
+<immutable digraph with 10 vertices, 30 edges>
+gap> IsBound(D!.OutNeighbours);
+false
+gap> Set(OutNeighboursOfVertex(D, 5));
+[ 3, 4, 10 ]
+gap> DigraphDiameter(D);
+2
+gap> DigraphShortestDistance(D, 5, 6);
+2
+gap> DigraphShortestDistance(D, 5, 10);
+1
+gap> DIGRAPHS_RepresentativeDistances(D);
+[ [ 0, 2, 2, 2, 2, 2, 2, 1, 1, 1 ] ]
+gap> IsMultiDigraph(D) or DigraphHasLoops(D);
+false
+gap> IsBound(D!.OutNeighbours);
+false
+gap> out := List(DigraphVertices(D), v -> OutNeighboursOfVertex(D, v));;
+gap> out = OutNeighbours(D);
+true
+gap> IsBound(D!.OutNeighbours);
+true
+gap> D = Digraph(List(out, Set));
+true
+gap> D := Digraph(Group((1, 2, 3), (4, 5, 6)), [1 .. 6], OnPoints,
+>                 {x, y} -> x <= 3 and y > 3);
+<immutable digraph with 6 vertices, 9 edges>
+gap> DigraphDiameter(D);
+fail
+gap> DigraphShortestDistance(D, 2, 5);
+1
+gap> DigraphShortestDistance(D, 4, 1);
+fail
+gap> IsBound(D!.OutNeighbours);
+false
+
 #  DIGRAPHS_UnbindVariables
 gap> Unbind(D);
 gap> Unbind(digraph);
@@ -269,6 +308,7 @@ gap> Unbind(gr1);
 gap> Unbind(gr2);
 gap> Unbind(gr3);
 gap> Unbind(group);
+gap> Unbind(out);
 
 #
 gap> DIGRAPHS_StopTest();
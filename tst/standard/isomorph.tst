@@ -226,6 +226,59 @@ false
 gap> IsIsomorphicDigraph(gr1, gr1, [1, 1, 2, 2], [1, 1, 1, 2]);
 false
 
+#  DigraphIsomorphismInvariant
+gap> gr1 := CycleDigraph(6);;
+gap> gr2 := DigraphDisjointUnion(CycleDigraph(3), CycleDigraph(3));;
+gap> DigraphIsomorphismInvariant(gr1) = DigraphIsomorphismInvariant(gr2);
+true
+gap> IsIsomorphicDigraph(gr1, gr2);
+false
+gap> gr2 := OnDigraphs(gr1, (1, 4, 2)(3, 6));;
+gap> DigraphIsomorphismInvariant(gr1) = DigraphIsomorphismInvariant(gr2);
+true
+gap> IsIsomorphicDigraph(gr1, gr2);
+true
+gap> gr1 := ChainDigraph(4);;
+gap> gr2 := Digraph([[2], [3], [1], []]);;
+gap> DigraphIsomorphismInvariant(gr1) = DigraphIsomorphismInvariant(gr2);
+false
+gap> IsIsomorphicDigraph(gr1, gr2);
+false
+gap> gr2 := DigraphReverse(gr1);;
+gap> DigraphIsomorphismInvariant(gr1, [1, 1, 1, 2])
+> = DigraphIsomorphismInvariant(gr2, [2, 1, 1, 1]);
+true
+gap> DigraphIsomorphismInvariant(gr1, [1, 1, 1, 2])
+> = DigraphIsomorphismInvariant(gr2, [1, 1, 1, 2]);
+false
+gap> DigraphIsomorphismInvariant(gr1, [[1, 2, 3], [4]])
+> = DigraphIsomorphismInvariant(gr1, [1, 1, 1, 2]);
+true
+gap> IsIsomorphicDigraph(gr1, gr2, [1, 1, 1, 2], [2, 1, 1, 1]);
+true
+gap> IsIsomorphicDigraph(gr1, gr2, [1, 1, 1, 2], [1, 1, 1, 2]);
+false
+gap> DigraphIsomorphismInvariant(gr1, [1, 5, 1, 1]);
+Error, the 2nd argument <partition> does not define a colouring of the vertice\
+s [1 .. 4], since it contains the integer 5, which is greater than 4,
+gap> gr1 := Digraph([[2, 2], [1]]);
+<immutable multidigraph with 2 vertices, 3 edges>
+gap> gr2 := Digraph([[2], [1, 1]]);
+<immutable multidigraph with 2 vertices, 3 edges>
+gap> DigraphIsomorphismInvariant(gr1) = DigraphIsomorphismInvariant(gr2);
+true
+gap> IsIsomorphicDigraph(gr1, gr2);
+true
+gap> gr1 := ChainDigraph(40);;
+gap> cols := List([1, 2], i -> ListWithIdenticalEntries(40, 1));;
+gap> cols[1][20] := 2;;
+gap> cols[2][21] := 2;;
+gap> DigraphIsomorphismInvariant(gr1, cols[1])
+> = DigraphIsomorphismInvariant(gr1, cols[2]);
+true
+gap> IsIsomorphicDigraph(gr1, gr1, cols[1], cols[2]);
+false
+
 # IsomorphismDigraphs: for digraphs without multiple edges
 
 # Non-isomorphic graphs
@@ -698,6 +751,15 @@ Group([ (1,2)(3,4), (1,3)(2,4), () ])
 gap> vc := [1, 1, 2, 2];;
 gap> AutomorphismGroup(D, vc, ec);
 Group([ (1,2)(3,4), () ])
+gap> D := Digraph([[2, 6], [3, 1], [4, 2], [5, 3], [6, 4], [1, 5]]);;
+gap> ec := List([1 .. 6], i -> [1, 2]);;
+gap> G := AutomorphismGroup(D, ListWithIdenticalEntries(6, 1), ec);;
+gap> Size(G);
+6
+gap> IsCyclic(G);
+true
+gap> AutomorphismGroup(CycleDigraph(4), [1, 1, 1, 1], [[1], [2], [1], [2]]);
+Group([ (1,3)(2,4) ])
 
 #  AutomorphismGroup: for a digraph with multiple edges
 
@@ -793,7 +855,7 @@ gap> gr := Digraph([
 gap> IsomorphismDigraphs(gr, gr);
 [ (), () ]
 gap> BlissCanonicalLabelling(gr);
-[ (1,9,6,2,4)(3,7), () ]
+[ (1,8,9,6)(2,3,7,5,4), () ]
 gap> NautyCanonicalLabelling(gr);
 fail
 gap> AutomorphismGroup(gr);
@@ -837,9 +899,9 @@ gap> IsomorphismDigraphs(gr1, gr2, [1, 1], [1, 1]);
 gap> gr := Digraph([[2, 2], [1, 1], [2]]);
 <immutable multidigraph with 3 vertices, 5 edges>
 gap> BlissCanonicalLabelling(gr);
-[ (), () ]
+[ (1,2,3), () ]
 gap> canon := OutNeighbours(OnMultiDigraphs(gr, last));
-[ [ 2, 2 ], [ 1, 1 ], [ 2 ] ]
+[ [ 3 ], [ 3, 3 ], [ 2, 2 ] ]
 gap> for i in SymmetricGroup(DigraphNrVertices(gr)) do
 > for j in SymmetricGroup(DigraphNrEdges(gr)) do
 >   new := OnMultiDigraphs(gr, [i, j]);
@@ -910,7 +972,7 @@ gap> G := AutomorphismGroup(gr);;
 gap> HasBlissCanonicalLabelling(gr);
 true
 gap> BlissCanonicalLabelling(gr);
-[ (1,9,6,2,4)(3,7), () ]
+[ (1,8,9,6)(2,3,7,5,4), () ]
 gap> BlissCanonicalLabelling(gr) = BlissCanonicalLabelling(DigraphCopy(gr));
 true
 
@@ -940,6 +1002,18 @@ gap> OutNeighbours(DistanceDigraph(gr, 1));
 gap> OutNeighbours(DistanceDigraph(gr, 2));
 [ [  ], [  ], [  ] ]
 
+# AutomorphismGroup, for many digraphs of different sizes in turn
+gap> ForAll([1 .. 30],
+>           i -> Size(AutomorphismGroup(CompleteDigraph(i mod 7 + 1)))
+>                = Factorial(i mod 7 + 1));
+true
+gap> ForAll([1 .. 30],
+>           i -> Size(DigraphGroup(Digraph(List([1 .. i mod 7 + 1],
+>                                          j -> [j mod (i mod 7 + 1) + 1,
+>                                                j mod (i mod 7 + 1) + 1]))))
+>                = i mod 7 + 1);
+true
+
 # BlissAutomorphismGroup, error handling
 gap> gr := Digraph([[2], [1, 3], [2]]);
 <immutable digraph with 3 vertices, 4 edges>
@@ -999,12 +1073,95 @@ gap> Number(FullTransformationMonoid(5),
 >                                      [1, 1, 1, 1, 1]));   
 5
 
+#  GenerateDigraphs and WriteGeneratedDigraphs
+gap> List([0 .. 6], n -> Length(GenerateDigraphs(n, "graphs")));
+[ 1, 1, 2, 4, 11, 34, 156 ]
+gap> List([0 .. 4], n -> Length(GenerateDigraphs(n)));
+[ 1, 1, 3, 16, 218 ]
+gap> List([0 .. 6], n -> Length(GenerateDigraphs(n, "tournaments")));
+[ 1, 1, 1, 2, 4, 12, 56 ]
+gap> List([0 .. 5], n -> Length(GenerateDigraphs(n, "dags")));
+[ 1, 1, 2, 6, 31, 302 ]
+gap> gr := GenerateDigraphs(4);;
+gap> ForAll(Combinations(gr, 2), x -> not IsIsomorphicDigraph(x[1], x[2]));
+true
+gap> ForAll(gr, D -> not IsMultiDigraph(D) and not DigraphHasLoops(D));
+true
+gap> ForAll(GenerateDigraphs(5, "tournaments"), IsTournament);
+true
+gap> ForAll(GenerateDigraphs(5, "dags"), IsAcyclicDigraph);
+true
+gap> ForAll(GenerateDigraphs(5, "graphs"), IsSymmetricDigraph);
+true
+gap> Length(GenerateDigraphs(8, "graphs" : mindeg := 3, maxdeg := 3));
+6
+gap> Length(GenerateDigraphs(7, "tournaments" : mindeg := 3, maxdeg := 3));
+3
+gap> gr := GenerateDigraphs(5, "graphs" : minedges := 8, maxedges := 12);;
+gap> Length(gr);
+18
+gap> ForAll(gr, D -> DigraphNrEdges(D) in [8 .. 12]);
+true
+gap> Length(GenerateDigraphs(6, "graphs"
+>                            : filter := D -> DigraphUndirectedGirth(D) > 3));
+38
+gap> Sum([0 .. 4], i -> Length(GenerateDigraphs(4 : res := i, mod := 5)));
+218
+gap> Sum([0 .. 2], i -> GenerateDigraphs(7, "graphs"
+>                                        : res := i, mod := 3, hook := IdFunc));
+1044
+gap> n := 0;;
+gap> GenerateDigraphs(4, "dags" : hook := function(D) n := n + 1; end);
+31
+gap> n;
+31
+gap> GenerateDigraphs(33);
+Error, the argument <n> must be an integer in the range [0 .. 32],
+gap> GenerateDigraphs(3, "multidigraphs");
+Error, the argument <kind> must be one of "graphs", "digraphs", "tournaments",\
+ or "dags",
+gap> GenerateDigraphs(3, "graphs", 1);
+Error, there must be 1 or 2 arguments,
+gap> GenerateDigraphs(3 : maxdeg := -1);
+Error, the option <maxdeg> must be a non-negative integer,
+gap> GenerateDigraphs(3 : res := 2, mod := 2);
+Error, the options <res> and <mod> must satisfy 0 <= res < mod,
+gap> GenerateDigraphs(3 : filter := 1);
+Error, the option <filter> must be a function,
+gap> GenerateDigraphs(3 : hook := 1);
+Error, the option <hook> must be a function,
+gap> GenerateDigraphs(6, "graphs" : hook := function(D) Error("stop"); end);
+Error, stop
+gap> GenerateDigraphs(6, "graphs" : filter := D -> Error("stop"));
+Error, stop
+gap> Length(GenerateDigraphs(6, "graphs"));
+156
+gap> filename := Filename(DirectoryTemporary(), "generate.g6");;
+gap> WriteGeneratedDigraphs(filename, 5, "graphs");
+34
+gap> gr := ReadDigraphs(filename);;
+gap> Length(gr);
+34
+gap> ForAll(gr, D -> ForAny(GenerateDigraphs(5, "graphs"),
+>                           E -> IsIsomorphicDigraph(D, E)));
+true
+gap> filename := Filename(DirectoryTemporary(), "generate.d6");;
+gap> WriteGeneratedDigraphs(filename, 3);
+16
+gap> Length(ReadDigraphs(filename));
+16
+gap> WriteGeneratedDigraphs(filename, 3, "graphs", 1);
+Error, there must be 2 or 3 arguments,
+gap> WriteGeneratedDigraphs(1, 3);
+Error, the 1st argument <filename> must be a string or a file,
+
 #  DIGRAPHS_UnbindVariables
 gap> Unbind(D);
 gap> Unbind(G);
 gap> Unbind(canon);
 gap> Unbind(cols);
 gap> Unbind(ec);
+gap> Unbind(filename);
 gap> Unbind(gr);
 gap> Unbind(gr1);
 gap> Unbind(gr2);
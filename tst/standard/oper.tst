@@ -337,6 +337,17 @@ gap> DigraphVertexLabels(gri);
 [ 4, 2, 5 ]
 gap> OutNeighbours(gri);
 [ [ 3, 3 ], [ 1, 3 ], [  ] ]
+gap> D := Digraph(IsMutableDigraph, [[2, 3], [3], [1, 2]]);;
+gap> SetDigraphEdgeLabel(D, 1, 3, "b");
+gap> SetDigraphEdgeLabel(D, 3, 1, "c");
+gap> InducedSubdigraph(D, [3, 1]);
+<mutable digraph with 2 vertices, 2 edges>
+gap> OutNeighbours(D);
+[ [ 2 ], [ 1 ] ]
+gap> DigraphEdgeLabels(D);
+[ [ "c" ], [ "b" ] ]
+gap> DigraphVertexLabels(D);
+[ 3, 1 ]
 
 #  QuotientDigraph
 gap> gr := CompleteDigraph(2);
@@ -397,6 +408,13 @@ gap> qr := QuotientDigraph(gr, [[1], [2, 3, 5, 7], [4, 6, 8]]);
 <immutable digraph with 3 vertices, 8 edges>
 gap> OutNeighbours(qr);
 [ [ 2, 3 ], [ 1, 2, 3 ], [ 1, 2, 3 ] ]
+gap> qr := QuotientDigraph(CycleDigraph(1000),
+>                         List([1 .. 10], i -> [100 * i - 99 .. 100 * i]));
+<immutable digraph with 10 vertices, 20 edges>
+gap> OutNeighbours(qr)[10];
+[ 1, 10 ]
+gap> DigraphVertexLabels(qr)[10][100];
+1000
 
 #  DigraphInEdges and DigraphOutEdges: for a vertex
 gap> gr := Digraph([[2, 2, 2, 2, 2], [1, 1, 1, 1], [1], [3, 2]]);
@@ -632,6 +650,107 @@ gap> n := 10 ^ 5;; D1 := EmptyDigraph(IsMutableDigraph, n);;
 gap> for i in [1 .. n - 1] do DigraphAddEdge(D1, i, i + 1); od;
 gap> D1 = ChainDigraph(n);
 true
+gap> D := CycleDigraph(5);;
+gap> D2 := DigraphAddEdge(D, 1, 3);
+<immutable digraph with 5 vertices, 6 edges>
+gap> OutNeighbours(D2);
+[ [ 2, 3 ], [ 3 ], [ 4 ], [ 5 ], [ 1 ] ]
+gap> OutNeighbours(D);
+[ [ 2 ], [ 3 ], [ 4 ], [ 5 ], [ 1 ] ]
+gap> ForAll([2 .. 5],
+> v -> IsIdenticalObj(OutNeighbours(D)[v], OutNeighbours(D2)[v]));
+true
+gap> D3 := DigraphRemoveEdges(D2, [[1, 2]]);;
+gap> OutNeighbours(D3);
+[ [ 3 ], [ 3 ], [ 4 ], [ 5 ], [ 1 ] ]
+gap> OutNeighbours(D2)[1];
+[ 2, 3 ]
+gap> D3 := DigraphReverseEdges(D3, [[1, 3], [4, 5]]);;
+gap> OutNeighbours(D3);
+[ [  ], [ 3 ], [ 4, 1 ], [  ], [ 1, 4 ] ]
+gap> IsIdenticalObj(OutNeighbours(D2)[2], OutNeighbours(D3)[2]);
+true
+gap> D := DigraphAddVertex(CycleDigraph(3), "a");;
+gap> SetDigraphEdgeLabel(D, 1, 2, "b");
+gap> D2 := DigraphAddEdge(D, 4, 1);;
+gap> DigraphVertexLabels(D2);
+[ 1, 2, 3, "a" ]
+gap> DigraphEdgeLabel(D2, 1, 2);
+"b"
+gap> D2 := DigraphAddVertex(D2, "c");;
+gap> DigraphVertexLabels(D);
+[ 1, 2, 3, "a" ]
+gap> DigraphVertexLabels(D2);
+[ 1, 2, 3, "a", "c" ]
+gap> SetDigraphVertexLabel(D2, 1, "d");
+gap> DigraphVertexLabel(D2, 1);
+"d"
+gap> DigraphVertexLabel(D, 1);
+1
+gap> D := CycleDigraph(100);;
+gap> D2 := DigraphAddEdge(D, 70, 1);
+<immutable digraph with 100 vertices, 101 edges>
+gap> IsDigraphByPersistentOutNeighboursRep(D2);
+true
+gap> OutNeighboursOfVertex(D2, 70);
+[ 71, 1 ]
+gap> OutDegreeOfVertex(D2, 99);
+1
+gap> IsBound(D2!.OutNeighbours);
+false
+gap> IsMultiDigraph(D2);
+false
+gap> IsMultiDigraph(DigraphAddEdge(D2, 70, 71));
+true
+gap> D3 := DigraphAddVertices(D2, 40);
+<immutable digraph with 140 vertices, 101 edges>
+gap> D3 := DigraphAddEdge(D3, [140, 33]);;
+gap> OutNeighbours(D3)
+> = Concatenation(OutNeighbours(D2), List([1 .. 39], x -> []), [[33]]);
+true
+gap> DigraphVertexLabels(D3) = [1 .. 140];
+true
+gap> D3 := DigraphRemoveEdge(D3, 33, 34);;
+gap> DigraphNrEdges(D3);
+101
+gap> OutNeighboursOfVertex(D3, 33);
+[  ]
+gap> D3 := DigraphReverseEdges(D3, [[1, 2], [140, 33]]);;
+gap> OutNeighbours(D3){[1, 2, 33, 140]};
+[ [  ], [ 3, 1 ], [ 140 ], [  ] ]
+gap> OutNeighbours(D2){[1, 2, 33]};
+[ [ 2 ], [ 3 ], [ 34 ] ]
+gap> DigraphRemoveEdge(D3, 141, 1);
+Error, the 2nd argument <src> must be a vertex of the digraph <D> that is the \
+1st argument,
+gap> DigraphRemoveVertex(D3, 140) = InducedSubdigraph(D3, [1 .. 139]);
+true
+gap> D := Digraph([[2], [3], []]);;
+gap> SetDigraphEdgeLabel(D, 1, 2, "x");
+gap> D2 := DigraphReverseEdge(D, 1, 2);;
+gap> DigraphEdgeLabel(D2, 2, 1);
+"x"
+gap> SetDigraphEdgeLabel(D2, 2, 3, "y");
+gap> DigraphEdgeLabels(D2);
+[ [  ], [ "y", "x" ], [  ] ]
+gap> DigraphEdgeLabels(D);
+[ [ "x" ], [ 1 ], [  ] ]
+gap> D3 := DigraphAddEdge(D2, 3, 1);;
+gap> DigraphEdgeLabels(D3);
+[ [  ], [ "y", "x" ], [ 1 ] ]
+gap> HaveEdgeLabelsBeenAssigned(DigraphReverseEdge(D3, 3, 1));
+true
+gap> D2 := DigraphAddEdge(D3, 1, 2);;
+gap> HaveEdgeLabelsBeenAssigned(D2);
+true
+gap> IsMultiDigraph(DigraphReverseEdge(D2, 1, 2));
+true
+gap> HaveEdgeLabelsBeenAssigned(DigraphReverseEdge(D2, 1, 2));
+false
+gap> D3 := DigraphMutableCopy(D3);
+<mutable digraph with 3 vertices, 3 edges>
+gap> DigraphEdgeLabels(D3);
+[ [  ], [ "y", "x" ], [ 1 ] ]
 
 #  DigraphAddVertices
 gap> gr := Digraph([[1]]);;
@@ -1510,6 +1629,9 @@ gap> DigraphLayers(gr, 9);
 [ [ 9 ], [ 10, 11 ] ]
 gap> DigraphLayers(gr, 10);
 [ [ 10 ] ]
+gap> DIGRAPHS_FREE_BFS_DATA();
+gap> DigraphShortestDistance(gr, 2, 8);
+6
 gap> gr := DigraphFromDigraph6String("&GYHPQgWTIIPW");;
 gap> DigraphGroup(gr);
 Group([ (1,2)(3,4)(5,6)(7,8), (1,3,2,4)(5,7,6,8), (1,5)(2,6)(3,8)(4,7) ])
@@ -1594,6 +1716,39 @@ Error, the 2nd argument <list> must consist of vertices of the 1st argument <D\
 >,
 gap> DigraphShortestDistance(gr, [1, 71, 3]);
 Error, the 2nd argument <list> must be a list of length 2,
+gap> DigraphShortestDistance(gr, [1, 2], [3, 74]);
+Error, the 2nd and 3rd arguments <list1> and <list2> must be lists of vertices\
+ of the 1st argument <D>,
+
+#  DigraphShortestDistancesOfPairs and DigraphReachabilityOfPairs
+gap> DigraphShortestDistancesOfPairs(gr,
+> [[1, 3], [3, 3], [5, 2], [1, 4], [1, 1]]);
+[ 2, 0, fail, 3, 0 ]
+gap> DigraphReachabilityOfPairs(gr, [[1, 3], [3, 3], [5, 2], [5, 5], [1, 1]]);
+[ true, true, false, true, true ]
+gap> DigraphShortestDistancesOfPairs(gr, []);
+[  ]
+gap> DigraphShortestDistancesOfPairs(gr, [[1, 6]]);
+Error, the 2nd argument <pairs> must be a list of pairs of vertices of the 1st\
+ argument <D>,
+gap> DigraphReachabilityOfPairs(gr, [[1, 2, 3]]);
+Error, the 2nd argument <pairs> must be a list of pairs of vertices of the 1st\
+ argument <D>,
+gap> gr := DigraphSymmetricClosure(CycleDigraph(2000));;
+gap> DigraphShortestDistancesOfPairs(gr, List([1 .. 10], i -> [1, 100 * i]));
+[ 99, 199, 299, 399, 499, 599, 699, 799, 899, 999 ]
+gap> DigraphShortestDistance(gr, 1, 1001);
+1000
+gap> DigraphReachabilityOfPairs(ChainDigraph(1000),
+> [[1, 1000], [1000, 1], [500, 500]]);
+[ true, false, false ]
+gap> gr := CompleteBipartiteDigraph(100, 1000);;
+gap> List(DigraphLayers(gr, 1), Length);
+[ 1, 1000, 99 ]
+gap> DigraphLayers(gr, 1)[3] = [2 .. 100];
+true
+gap> Length(DigraphDistanceSet(gr, 101, [1, 2]));
+1099
 
 #  DigraphDistancesSet
 gap> gr := ChainDigraph(10);
@@ -2497,6 +2652,33 @@ gap> OutNeighbours(last);
 gap> LexicographicProduct(ChainDigraph(3), CycleDigraph(7));   
 <immutable digraph with 21 vertices, 119 edges>
 
+# Graph products of digraphs with loops
+gap> D1 := Digraph([[1, 2], []]);;
+gap> D2 := Digraph([[2], [1, 2]]);;
+gap> OutNeighbours(StrongProduct(D1, D2));
+[ [ 1, 2, 3, 4 ], [ 1, 2, 3, 4 ], [ 4 ], [ 3, 4 ] ]
+gap> OutNeighbours(ConormalProduct(D1, D2));
+[ [ 1, 2, 3, 4 ], [ 1, 2, 3, 4 ], [ 2, 4 ], [ 1, 2, 3, 4 ] ]
+gap> OutNeighbours(HomomorphicProduct(D1, D2));
+[ [ 1, 2, 3 ], [ 1, 2 ], [ 3, 4 ], [ 3, 4 ] ]
+gap> OutNeighbours(LexicographicProduct(D1, D2));
+[ [ 1, 2, 3, 4 ], [ 1, 2, 3, 4 ], [ 4 ], [ 3, 4 ] ]
+gap> OutNeighbours(ModularProduct(D1, D2));
+[ [ 4 ], [ 2, 3 ], [ 3 ], [  ] ]
+
+# Graph products of larger digraphs
+gap> D1 := CycleGraph(30);;
+gap> D2 := PetersenGraph();;
+gap> List([StrongProduct, ConormalProduct, HomomorphicProduct,
+>          LexicographicProduct, ModularProduct],
+>         f -> DigraphNrEdges(f(D1, D2)));
+[ 3300, 31200, 7200, 6900, 50700 ]
+gap> D1 := CycleDigraph(IsMutableDigraph, 3);;
+gap> StrongProduct(D1, D1);
+<immutable digraph with 9 vertices, 27 edges>
+gap> D1;
+<mutable digraph with 3 vertices, 3 edges>
+
 # DigraphShortestPathSpanningTree
 gap> D := Digraph([[2, 3, 4], [1, 3, 4, 5], [1, 2], [5], [4]]);
 <immutable digraph with 5 vertices, 11 edges>
@@ -2754,6 +2936,36 @@ gap> DominatorTree(D, 1);
 rec( idom := [ fail ], preorder := [ 1 ] )
 gap> DominatorTree(D, 6);
 rec( idom := [ ,,,,, fail ], preorder := [ 6 ] )
+gap> DominatorTree(D, 16);
+Error, the 2nd argument (root) is not a vertex of the 1st argument (a digraph)
+
+# DominatorTrees
+gap> D := Digraph([[2, 3], [4, 6], [4, 5], [3, 5], [1, 6], [2, 3]]);;
+gap> DominatorTrees(D, [1, 5, 6]) = List([1, 5, 6], x -> DominatorTree(D, x));
+true
+gap> DominatorTrees(D, []);
+[  ]
+gap> DominatorTrees(D, [1, 7]);
+Error, the 2nd argument <roots> must be a list of vertices of the 1st argument <D>,
+gap> DominatorTrees(D, [0]);
+Error, the 2nd argument <roots> must be a list of vertices of the 1st argument <D>,
+gap> D := Digraph([[], [3], [4, 5], [2], [4]]);;
+gap> DominatorTrees(D, [2, 1, 2, 5]);
+[ rec( idom := [ , fail, 2, 3, 3 ], preorder := [ 2, 3, 4, 5 ] ), 
+  rec( idom := [ fail ], preorder := [ 1 ] ), 
+  rec( idom := [ , fail, 2, 3, 3 ], preorder := [ 2, 3, 4, 5 ] ), 
+  rec( idom := [ , 4, 2, 5, fail ], preorder := [ 5, 4, 2, 3 ] ) ]
+gap> D := ChainDigraph(IsMutableDigraph, 100000);
+<mutable digraph with 100000 vertices, 99999 edges>
+gap> DigraphAddEdge(D, 100000, 1);
+<mutable digraph with 100000 vertices, 100000 edges>
+gap> T := DominatorTrees(D, [1, 50000]);;
+gap> T[1].idom{[1, 2, 100000]};
+[ fail, 1, 99999 ]
+gap> T[2].idom{[1, 49999, 50000, 50001]};
+[ 100000, 49998, fail, 50000 ]
+gap> Length(T[2].preorder);
+100000
 
 # IsDigraphPath
 gap> D := Digraph(IsMutableDigraph, Combinations([1 .. 5]), IsSubset);
@@ -2921,6 +3133,27 @@ gap> res := DigraphCycleBasis(D);
 gap> List(res[2], List);
 [ [ Z(2)^0, Z(2)^0, Z(2)^0, 0*Z(2), 0*Z(2), 0*Z(2), 0*Z(2) ], 
   [ 0*Z(2), 0*Z(2), 0*Z(2), Z(2)^0, Z(2)^0, Z(2)^0, Z(2)^0 ] ]
+gap> D := DigraphDisjointUnion(PetersenGraph(), CycleGraph(100),
+> NullDigraph(3));;
+gap> res := DigraphCycleBasis(D);;
+gap> Length(res[2]);
+7
+gap> RankMat(res[2]);
+7
+gap> ForAll(res[2], IsGF2VectorRep);
+true
+gap> D := CycleDigraph(IsMutableDigraph, 4);;
+gap> res := DigraphCycleBasis(D);;
+gap> List(res[2], List);
+[ [ Z(2)^0, Z(2)^0, Z(2)^0, Z(2)^0 ] ]
+gap> res := [0 * Z(2), 0 * Z(2)];;
+gap> ConvertToVectorRep(res, 2);;
+gap> DIGRAPH_CYCLE_BASIS(CycleDigraph(3), res);
+Error, the 2nd argument <zero> must have length 3, found 2,
+gap> res := [Z(2), 0 * Z(2), 0 * Z(2)];;
+gap> ConvertToVectorRep(res, 2);;
+gap> DIGRAPH_CYCLE_BASIS(CycleDigraph(3), res);
+Error, the 2nd argument <zero> must be a zero vector,
 
 # DigraphContractEdge
 
@@ -3245,6 +3478,7 @@ gap> Unbind(DD);
 gap> Unbind(G);
 gap> Unbind(G1);
 gap> Unbind(L);
+gap> Unbind(T);
 gap> Unbind(a);
 gap> Unbind(adj);
 gap> Unbind(b);
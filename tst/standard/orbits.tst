@@ -29,6 +29,28 @@ gap> DigraphStabilizer(gr, 2);
 Group([ (1,3) ])
 gap> DigraphStabilizer(gr, 3);
 Group([ (1,2) ])
+gap> gr := CompleteDigraph(20);;
+gap> S := DigraphStabilizer(gr, 1);;
+gap> Size(S) = Factorial(19);
+true
+gap> ForAll(GeneratorsOfGroup(S), x -> 1 ^ x = 1);
+true
+gap> gr := DigraphSymmetricClosure(CycleDigraph(70000));;
+gap> Size(DigraphStabilizer(gr, 3));
+2
+gap> Size(DigraphStabilizer(CompleteDigraph(10), 1 : random := 500));
+362880
+gap> DigraphStabilizer(CompleteDigraph(10), 1 : random := 1001);
+Error, the option <random> must be an integer in the range [0 .. 1000],
+gap> Size(DIGRAPHS_Stabilizer(Group((1, 2, 3, 4, 5), (1, 2)), 5, 1));
+24
+gap> Size(DIGRAPHS_Stabilizer(SymmetricGroup(8), 8, 1 : random := 0)) <= 5040;
+true
+gap> n := 2000;;
+gap> G := Group(PermList(Concatenation([2 .. n], [1])),
+>               PermList(Concatenation([1], [n, n - 1 .. 2])));;
+gap> Size(DIGRAPHS_Stabilizer(G, n, 1));
+2
 
 #  DigraphGroup
 gap> gr := Digraph([[2, 3], [1], [2]]);
@@ -50,6 +72,33 @@ gap> gr := CycleDigraph(10);
 gap> DigraphOrbits(gr);
 [ [ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 ] ]
 
+#  DIGRAPHS_Orbits, DIGRAPHS_TraceSchreierVector, DIGRAPHS_EvaluateWord
+gap> gens := [(1, 2, 3), (4, 5)];;
+gap> record := DIGRAPHS_Orbits(Group(gens), [1 .. 6]);;
+gap> record.orbits;
+[ [ 1, 2, 3 ], [ 4, 5 ], [ 6 ] ]
+gap> record.schreier;
+[ -1, 1, 1, -2, 2, -3 ]
+gap> record.lookup;
+[ 1, 1, 1, 2, 2, 3 ]
+gap> record := DIGRAPHS_TraceSchreierVector(gens, [-1, 1, 1, -2, 2, -3], 3);;
+gap> record.word;
+[ 1, 1 ]
+gap> record.representative;
+1
+gap> DIGRAPHS_EvaluateWord(gens, record.word);
+(1,3,2)
+gap> DIGRAPHS_EvaluateWord(gens, [1, 2]);
+(1,2,3)(4,5)
+gap> DIGRAPHS_EvaluateWord(gens, []);
+()
+gap> DIGRAPHS_Orbits(Group(()), []).orbits;
+[  ]
+gap> DIGRAPHS_Orbits(Group(()), [1 .. 3]).schreier;
+[ -1, -2, -3 ]
+gap> DIGRAPHS_Orbits(Group((1, 7)), [1 .. 6]);
+Error, the 1st argument <gens> must consist of permutations of [1 .. 6],
+
 #  RepresentativeOutNeighbours
 gap> gr := ChainDigraph(3);
 <immutable chain digraph with 3 vertices>
@@ -61,7 +110,12 @@ gap> RepresentativeOutNeighbours(gr);
 [ [ 2 ] ]
 
 #  DIGRAPHS_UnbindVariables
+gap> Unbind(G);
+gap> Unbind(S);
+gap> Unbind(gens);
 gap> Unbind(gr);
+gap> Unbind(n);
+gap> Unbind(record);
 
 #
 gap> DIGRAPHS_StopTest();